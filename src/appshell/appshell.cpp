@@ -24,6 +24,8 @@
 
 #include "config.h"
 
+#include <thread>
+
 #include <QApplication>
 #include <QQmlApplicationEngine>
 #include <QQuickWindow>
@@ -275,9 +277,22 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
     bool forceMode = task.params[CommandLineController::ParamKey::ForceMode].toBool();
 
     switch (task.type) {
-    case CommandLineController::ConvertType::Batch:
-        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode);
-        break;
+    case CommandLineController::ConvertType::Batch: {
+        QVariant jobsCountVal = task.params[CommandLineController::ParamKey::BatchJobsCount];
+        size_t jobsCount = jobsCountVal.isValid() ? jobsCountVal.toUInt() : 1;
+        if (jobsCount == 0) {
+            jobsCount = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        io::path_t reportPath = task.params[CommandLineController::ParamKey::BatchReportPath].toString();
+
+        std::vector<std::string> workerArgs;
+        for (const QString& arg : task.params[CommandLineController::ParamKey::BatchWorkerArgs].toStringList()) {
+            workerArgs.push_back(arg.toStdString());
+        }
+
+        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode, jobsCount, reportPath, workerArgs);
+    } break;
     case CommandLineController::ConvertType::ConvertScoreParts:
         ret = converter()->convertScoreParts(task.inputFile, task.outputFile, stylePath);
         break;
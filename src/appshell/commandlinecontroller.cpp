@@ -54,6 +54,10 @@ void CommandLineController::parse(const QStringList& args)
     // Converter mode
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
+    m_parser.addOption(QCommandLineOption("jobs",
+                                          "Use with '-j <file>', run conversion job in N parallel worker processes, 0 - use all cores",
+                                          "N"));
+    m_parser.addOption(QCommandLineOption("job-report", "Use with '-j <file>', write per-job results and timings to JSON file", "file"));
     m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
     m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
     m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
@@ -209,6 +213,37 @@ void CommandLineController::apply()
         application()->setRunMode(IApplication::RunMode::Converter);
         m_converterTask.type = ConvertType::Batch;
         m_converterTask.inputFile = m_parser.value("j");
+
+        if (m_parser.isSet("jobs")) {
+            std::optional<int> val = intValue("jobs");
+            if (val && val.value() >= 0) {
+                m_converterTask.params[CommandLineController::ParamKey::BatchJobsCount] = val.value();
+            } else {
+                LOGE() << "Option: --jobs not recognized jobs count: " << m_parser.value("jobs");
+            }
+        }
+
+        if (m_parser.isSet("job-report")) {
+            m_converterTask.params[CommandLineController::ParamKey::BatchReportPath] = m_parser.value("job-report");
+        }
+
+        //! NOTE The worker processes of the batch are set up with the same export options
+        QStringList workerArgs;
+        for (const QString& name : { "r", "T", "b", "M" }) {
+            if (m_parser.isSet(name)) {
+                workerArgs << "-" + name << m_parser.value(name);
+            }
+        }
+
+        if (m_parser.isSet("t")) {
+            workerArgs << "-t";
+        }
+
+        if (m_parser.isSet("template-mode")) {
+            workerArgs << "--template-mode";
+        }
+
+        m_converterTask.params[CommandLineController::ParamKey::BatchWorkerArgs] = workerArgs;
     }
 
     if (m_parser.isSet("score-media")) {
@@ -73,6 +73,9 @@ public:
         ScoreSource,
         ScoreTransposeOptions,
         ForceMode,
+        BatchJobsCount,
+        BatchReportPath,
+        BatchWorkerArgs,
 
         // Video
     };
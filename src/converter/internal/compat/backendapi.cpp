@@ -326,26 +326,33 @@ Ret BackendApi::exportScoreSvgs(const INotationPtr notation, const io::path_t& h
     PageList notationPages = pages(notation);
     QVariantMap beatsColors = readBeatsColors(highlightConfigPath);
 
-    bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        QByteArray svgData;
-        QBuffer svgDevice(&svgData);
-        svgDevice.open(QIODevice::ReadWrite);
+    std::vector<QByteArray> svgsData(notationPages.size());
+    std::vector<std::unique_ptr<QBuffer>> svgDevices;
+    std::vector<io::Device*> devices;
 
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) },
-            { INotationWriter::OptionKey::BEATS_COLORS, Val(beatsColors) }
-        };
+    for (QByteArray& svgData : svgsData) {
+        svgDevices.push_back(std::make_unique<QBuffer>(&svgData));
+        svgDevices.back()->open(QIODevice::ReadWrite);
+        devices.push_back(svgDevices.back().get());
+    }
 
-        Ret writeRet = svgWriter->write(notation, svgDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
-            result = false;
-        }
+    INotationWriter::Options options {
+        { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) },
+        { INotationWriter::OptionKey::BEATS_COLORS, Val(beatsColors) }
+    };
 
-        bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(svgData.toBase64(), !lastArrayValue);
+    bool result = true;
+    Ret writeRet = svgWriter->writePages(notation, devices, options);
+    if (!writeRet) {
+        LOGW() << writeRet.toString();
+        result = false;
+    }
+
+    svgDevices.clear();
+
+    for (size_t i = 0; i < svgsData.size(); ++i) {
+        bool lastArrayValue = ((svgsData.size() - 1) == i);
+        jsonWriter.addValue(svgsData[i].toBase64(), !lastArrayValue);
     }
 
     jsonWriter.closeArray(addSeparator);
@@ -21,7 +21,17 @@
  */
 #include "convertercontroller.h"
 
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include <QCoreApplication>
+#include <QDir>
 #include <QFile>
+#include <QProcess>
+#include <QSaveFile>
+#include <QTemporaryDir>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -40,7 +50,8 @@ using namespace mu::notation;
 static const std::string PDF_SUFFIX = "pdf";
 static const std::string PNG_SUFFIX = "png";
 
-mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath, bool forceMode)
+mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath, bool forceMode,
+                                          size_t jobsCount, const io::path_t& reportPath, const std::vector<std::string>& workerArgs)
 {
     TRACEFUNC;
 
@@ -50,16 +61,221 @@ mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const
         return batchJob.ret;
     }
 
-    Ret ret = make_ret(Ret::Code::Ok);
-    for (const Job& job : batchJob.val) {
-        ret = fileConvert(job.in, job.out, stylePath, forceMode);
+    auto started = std::chrono::steady_clock::now();
+
+    BatchResult result;
+    if (jobsCount > 1 && batchJob.val.size() > 1) {
+        result = convertBatchInWorkers(batchJob.val, stylePath, forceMode, workerArgs, std::min(jobsCount, batchJob.val.size()));
+    } else {
+        result = convertBatchInProcess(batchJob.val, stylePath, forceMode, reportPath);
+    }
+
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+
+    if (!reportPath.empty()) {
+        Ret ret = writeBatchReport(result, reportPath);
         if (!ret) {
-            LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
-            break;
+            LOGE() << "failed write batch report, err: " << ret.toString() << ", path: " << reportPath;
         }
     }
 
-    return ret;
+    size_t failedCount = 0;
+    for (const JobResult& jobResult : result) {
+        if (!jobResult.ret) {
+            LOGE() << "failed convert, err: " << jobResult.ret.toString() << ", in: " << jobResult.job.in << ", out: " << jobResult.job.out;
+            ++failedCount;
+        }
+    }
+
+    LOGI() << "batch done, jobs: " << result.size() << ", failed: " << failedCount << ", elapsed: " << elapsedMs << " ms";
+
+    if (failedCount > 0) {
+        return make_ret(Err::BatchJobFailed);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+ConverterController::BatchResult ConverterController::convertBatchInProcess(const BatchJob& batchJob, const io::path_t& stylePath,
+                                                                            bool forceMode, const io::path_t& reportPath)
+{
+    TRACEFUNC;
+
+    BatchResult result;
+    result.reserve(batchJob.size());
+
+    //! NOTE The result of every job is appended to the report right after the job, so if this process crashes,
+    //! the parent process knows which job caused it (see runWorkerProcess).
+    //! Only the closing bracket is rewritten, so the report stays a valid JSON array after every job
+    static const QByteArray REPORT_END("\n]\n");
+
+    QFile reportFile(reportPath.toQString());
+    bool isReportOpened = !reportPath.empty() && reportFile.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    if (isReportOpened) {
+        reportFile.write("[");
+    } else if (!reportPath.empty()) {
+        LOGE() << "failed open batch report, path: " << reportPath;
+    }
+
+    for (const Job& job : batchJob) {
+        auto started = std::chrono::steady_clock::now();
+
+        JobResult jobResult;
+        jobResult.job = job;
+        jobResult.ret = fileConvert(job.in, job.out, stylePath, forceMode);
+        jobResult.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+
+        if (isReportOpened) {
+            if (!result.empty()) {
+                reportFile.seek(reportFile.pos() - REPORT_END.size());
+                reportFile.write(",");
+            }
+
+            reportFile.write("\n");
+            reportFile.write(QJsonDocument(batchReportEntry(jobResult)).toJson(QJsonDocument::Compact));
+            reportFile.write(REPORT_END);
+            reportFile.flush();
+        }
+
+        result.push_back(std::move(jobResult));
+    }
+
+    if (isReportOpened && result.empty()) {
+        reportFile.write(REPORT_END);
+    }
+
+    return result;
+}
+
+ConverterController::BatchResult ConverterController::convertBatchInWorkers(const BatchJob& batchJob, const io::path_t& stylePath,
+                                                                            bool forceMode, const std::vector<std::string>& workerArgs,
+                                                                            size_t workersCount)
+{
+    TRACEFUNC;
+
+    //! NOTE Every worker is a separate process, so a crash while converting one score doesn't abort the whole batch.
+    //! Workers take jobs by small portions: each worker process loads fonts and instrument templates once
+    //! and converts several scores, while the queue still stays balanced between workers.
+    static constexpr size_t WORKER_PORTION_SIZE = 8;
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        LOGE() << "failed create temp dir for workers, convert in process";
+        return convertBatchInProcess(batchJob, stylePath, forceMode, io::path_t());
+    }
+
+    std::vector<Job> jobs(batchJob.begin(), batchJob.end());
+    size_t portionSize = std::clamp(jobs.size() / (workersCount * 4), size_t(1), WORKER_PORTION_SIZE);
+
+    std::mutex mutex;
+    size_t nextJobIdx = 0;
+
+    //! NOTE A portion is a range of the jobs, so the results are put in the order of the jobs
+    BatchResult result(jobs.size());
+
+    auto takePortion = [&](size_t& beginIdx, size_t& endIdx) {
+        std::lock_guard<std::mutex> lock(mutex);
+        beginIdx = nextJobIdx;
+        endIdx = std::min(nextJobIdx + portionSize, jobs.size());
+        nextJobIdx = endIdx;
+        return beginIdx < endIdx;
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workersCount);
+
+    for (size_t w = 0; w < workersCount; ++w) {
+        io::path_t workDir = tempDir.filePath(QString("worker-%1").arg(w));
+        QDir().mkpath(workDir.toQString());
+
+        threads.emplace_back([&, workDir]() {
+            size_t beginIdx = 0;
+            size_t endIdx = 0;
+            while (takePortion(beginIdx, endIdx)) {
+                while (beginIdx < endIdx) {
+                    BatchJob portion(jobs.begin() + beginIdx, jobs.begin() + endIdx);
+                    BatchResult done = runWorkerProcess(portion, workDir, stylePath, forceMode, workerArgs);
+                    for (JobResult& jobResult : done) {
+                        result[beginIdx++] = std::move(jobResult);
+                    }
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    return result;
+}
+
+ConverterController::BatchResult ConverterController::runWorkerProcess(const BatchJob& batchJob, const io::path_t& workDir,
+                                                                       const io::path_t& stylePath, bool forceMode,
+                                                                       const std::vector<std::string>& workerArgs) const
+{
+    io::path_t jobFile = workDir + "/job.json";
+    io::path_t reportFile = workDir + "/report.json";
+
+    BatchResult result;
+
+    auto failJob = [&result](const Job& job, const std::string& error, int64_t elapsedMs) {
+        JobResult jobResult;
+        jobResult.job = job;
+        jobResult.ret = make_ret(Err::BatchWorkerFailed, error);
+        jobResult.elapsedMs = elapsedMs;
+        result.push_back(std::move(jobResult));
+    };
+
+    Ret ret = writeBatchJob(batchJob, jobFile);
+    if (!ret) {
+        for (const Job& job : batchJob) {
+            failJob(job, "failed write worker job file", 0);
+        }
+        return result;
+    }
+
+    QFile::remove(reportFile.toQString());
+
+    QStringList args { "-j", jobFile.toQString(), "--job-report", reportFile.toQString() };
+    if (!stylePath.empty()) {
+        args << "-S" << stylePath.toQString();
+    }
+    if (forceMode) {
+        args << "-f";
+    }
+    for (const std::string& arg : workerArgs) {
+        args << QString::fromStdString(arg);
+    }
+
+    auto started = std::chrono::steady_clock::now();
+
+    QProcess process;
+    process.setProcessChannelMode(QProcess::ForwardedChannels);
+    process.start(QCoreApplication::applicationFilePath(), args);
+    process.waitForFinished(-1);
+
+    int64_t elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+
+    RetVal<BatchResult> report = parseBatchReport(reportFile);
+    if (report.ret) {
+        result = std::move(report.val);
+    }
+
+    if (result.size() < batchJob.size()) {
+        //! NOTE The worker died on the first job that is missing in its report,
+        //! the caller restarts the remaining ones in a new process
+        for (const JobResult& jobResult : result) {
+            elapsedMs -= jobResult.elapsedMs;
+        }
+
+        const Job& crashedJob = *std::next(batchJob.begin(), result.size());
+        LOGE() << "worker process failed, exit code: " << process.exitCode() << ", in: " << crashedJob.in;
+
+        failJob(crashedJob, process.errorString().toStdString(), std::max(elapsedMs, int64_t(0)));
+    }
+
+    return result;
 }
 
 mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath, bool forceMode)
@@ -92,7 +308,7 @@ mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t&
         ret = convertFullNotation(writer, notationProject->masterNotation()->notation(), out);
     }
 
-    return make_ret(Ret::Code::Ok);
+    return ret;
 }
 
 mu::Ret ConverterController::convertScoreParts(const mu::io::path_t& in, const mu::io::path_t& out, const mu::io::path_t& stylePath,
@@ -165,6 +381,94 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
     return rv;
 }
 
+mu::Ret ConverterController::writeBatchJob(const BatchJob& batchJob, const io::path_t& batchJobFile) const
+{
+    QJsonArray arr;
+    for (const Job& job : batchJob) {
+        QJsonObject obj;
+        obj["in"] = job.in.toQString();
+        obj["out"] = job.out.toQString();
+        arr.append(obj);
+    }
+
+    QFile file(batchJobFile.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::OutFileFailedOpen);
+    }
+
+    file.write(QJsonDocument(arr).toJson(QJsonDocument::Compact));
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::RetVal<ConverterController::BatchResult> ConverterController::parseBatchReport(const io::path_t& reportPath) const
+{
+    RetVal<BatchResult> rv;
+    QFile file(reportPath.toQString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        rv.ret = make_ret(Err::BatchJobFileFailedOpen);
+        return rv;
+    }
+
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &err);
+    if (err.error != QJsonParseError::NoError || !doc.isArray()) {
+        rv.ret = make_ret(Err::BatchJobFileFailedParse, err.errorString().toStdString());
+        return rv;
+    }
+
+    for (const QJsonValue v : doc.array()) {
+        QJsonObject obj = v.toObject();
+
+        JobResult jobResult;
+        jobResult.job.in = obj["in"].toString();
+        jobResult.job.out = obj["out"].toString();
+        jobResult.ret = Ret(obj["code"].toInt(), obj["error"].toString().toStdString());
+        jobResult.elapsedMs = obj["elapsedMs"].toVariant().toLongLong();
+
+        rv.val.push_back(std::move(jobResult));
+    }
+
+    rv.ret = make_ret(Ret::Code::Ok);
+    return rv;
+}
+
+mu::Ret ConverterController::writeBatchReport(const BatchResult& result, const io::path_t& reportPath) const
+{
+    QJsonArray arr;
+    for (const JobResult& jobResult : result) {
+        arr.append(batchReportEntry(jobResult));
+    }
+
+    //! NOTE The report is written to a temp file and then renamed,
+    //! so a crash while writing it doesn't leave a truncated report
+    QSaveFile file(reportPath.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::OutFileFailedOpen);
+    }
+
+    file.write(QJsonDocument(arr).toJson());
+
+    if (!file.commit()) {
+        return make_ret(Err::OutFileFailedWrite);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+QJsonObject ConverterController::batchReportEntry(const JobResult& jobResult) const
+{
+    QJsonObject obj;
+    obj["in"] = jobResult.job.in.toQString();
+    obj["out"] = jobResult.job.out.toQString();
+    obj["success"] = jobResult.ret.success();
+    obj["code"] = jobResult.ret.code();
+    obj["error"] = QString::fromStdString(jobResult.ret.text());
+    obj["elapsedMs"] = static_cast<qint64>(jobResult.elapsedMs);
+
+    return obj;
+}
+
 bool ConverterController::isConvertPageByPage(const std::string& suffix) const
 {
     QList<std::string> types {
@@ -23,6 +23,7 @@
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
 #include <list>
+#include <vector>
 
 #include "../iconvertercontroller.h"
 
@@ -34,6 +35,8 @@
 
 #include "retval.h"
 
+class QJsonObject;
+
 namespace mu::converter {
 class ConverterController : public IConverterController
 {
@@ -47,7 +50,9 @@ public:
 
     Ret fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                     bool forceMode = false) override;
-    Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false) override;
+    Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false,
+                     size_t jobsCount = 1, const io::path_t& reportPath = io::path_t(),
+                     const std::vector<std::string>& workerArgs = {}) override;
     Ret convertScoreParts(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                           bool forceMode = false) override;
 
@@ -76,7 +81,27 @@ private:
 
     using BatchJob = std::list<Job>;
 
+    struct JobResult {
+        Job job;
+        Ret ret;
+        int64_t elapsedMs = 0;
+    };
+
+    using BatchResult = std::vector<JobResult>;
+
     RetVal<BatchJob> parseBatchJob(const io::path_t& batchJobFile) const;
+    Ret writeBatchJob(const BatchJob& batchJob, const io::path_t& batchJobFile) const;
+
+    RetVal<BatchResult> parseBatchReport(const io::path_t& reportPath) const;
+    Ret writeBatchReport(const BatchResult& result, const io::path_t& reportPath) const;
+    QJsonObject batchReportEntry(const JobResult& jobResult) const;
+
+    BatchResult convertBatchInProcess(const BatchJob& batchJob, const io::path_t& stylePath, bool forceMode,
+                                      const io::path_t& reportPath);
+    BatchResult convertBatchInWorkers(const BatchJob& batchJob, const io::path_t& stylePath, bool forceMode,
+                                      const std::vector<std::string>& workerArgs, size_t workersCount);
+    BatchResult runWorkerProcess(const BatchJob& batchJob, const io::path_t& workDir, const io::path_t& stylePath, bool forceMode,
+                                 const std::vector<std::string>& workerArgs) const;
 
     bool isConvertPageByPage(const std::string& suffix) const;
     Ret convertPageByPage(project::INotationWriterPtr writer, notation::INotationPtr notation, const io::path_t& out) const;
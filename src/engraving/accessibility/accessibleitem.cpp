@@ -32,6 +32,8 @@ using namespace mu::accessibility;
 using namespace Ms;
 
 bool AccessibleItem::enabled = true;
+size_t AccessibleItem::usedItemsLimit = 64;
+std::list<AccessibleItem*> AccessibleItem::s_usedItems;
 
 AccessibleItem::AccessibleItem(Ms::EngravingItem* e, Role role)
     : m_element(e), m_role(role)
@@ -40,6 +42,11 @@ AccessibleItem::AccessibleItem(Ms::EngravingItem* e, Role role)
 
 AccessibleItem::~AccessibleItem()
 {
+    if (m_used) {
+        s_usedItems.erase(m_usedIt);
+        m_used = false;
+    }
+
     AccessibleRoot* root = accessibleRoot();
     if (root && root->focusedElement() == this) {
         root->setFocusedElement(nullptr);
@@ -97,6 +104,75 @@ bool AccessibleItem::registered() const
     return m_registred;
 }
 
+void AccessibleItem::markAsUsed(AccessibleItem* item)
+{
+    IF_ASSERT_FAILED(item) {
+        return;
+    }
+
+    if (item->m_used) {
+        s_usedItems.splice(s_usedItems.begin(), s_usedItems, item->m_usedIt);
+    } else {
+        item->m_usedIt = s_usedItems.insert(s_usedItems.begin(), item);
+        item->m_used = true;
+    }
+
+    releaseUnusedItems();
+}
+
+void AccessibleItem::releaseUnusedItems()
+{
+    //! NOTE The most recently used item is never released,
+    //! the items with accessible children are kept until the children are released
+    auto it = s_usedItems.end();
+    while (s_usedItems.size() > usedItemsLimit && --it != s_usedItems.begin()) {
+        AccessibleItem* item = *it;
+        if (item->isFocused() || hasAccessibleChildren(item->m_element)) {
+            continue;
+        }
+
+        it = s_usedItems.erase(it);
+        item->m_used = false;
+
+        EngravingItem* element = item->m_element;
+        EngravingItem* parent = element->parentItem();
+
+        element->releaseAccessible();
+        releaseUnusedParents(parent);
+    }
+}
+
+void AccessibleItem::releaseUnusedParents(EngravingItem* parent)
+{
+    //! NOTE The root items and the dummy are set up once with the score
+    while (parent && parent->type() != ElementType::ROOT_ITEM && parent->type() != ElementType::DUMMY) {
+        AccessibleItem* access = parent->accessible();
+        if (!access || access->m_used || access->isFocused() || hasAccessibleChildren(parent)) {
+            return;
+        }
+
+        EngravingItem* next = parent->parentItem();
+        parent->releaseAccessible();
+        parent = next;
+    }
+}
+
+bool AccessibleItem::hasAccessibleChildren(const EngravingItem* e)
+{
+    for (const EngravingObject* obj : e->children()) {
+        if (obj->isEngravingItem() && Ms::toEngravingItem(obj)->accessible()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AccessibleItem::isFocused() const
+{
+    AccessibleRoot* root = accessibleRoot();
+    return root && root->focusedElement() == this;
+}
+
 void AccessibleItem::notifyAboutFocus(bool focused)
 {
     m_accessibleStateChanged.send(IAccessible::State::Focused, focused);
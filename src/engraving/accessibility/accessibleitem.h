@@ -22,6 +22,8 @@
 #ifndef MU_ENGRAVING_ACCESSIBLEITEM_H
 #define MU_ENGRAVING_ACCESSIBLEITEM_H
 
+#include <list>
+
 #include "accessibility/iaccessible.h"
 #include "modularity/ioc.h"
 #include "accessibility/iaccessibilitycontroller.h"
@@ -84,9 +86,24 @@ public:
 
     static bool enabled;
 
+    //! NOTE The accessible objects of the elements are created on demand, when the element gets focused,
+    //! and the ones that were not focused for a while are released (with the parents that are left without
+    //! accessible children), so navigating a large score does not keep an object for every visited element
+    static void markAsUsed(AccessibleItem* item);
+    static size_t usedItemsLimit;
+
 private:
     Ms::TextCursor* textCursor() const;
 
+    static void releaseUnusedItems();
+    static void releaseUnusedParents(Ms::EngravingItem* parent);
+    static bool hasAccessibleChildren(const Ms::EngravingItem* e);
+    bool isFocused() const;
+
+    static std::list<AccessibleItem*> s_usedItems;
+    std::list<AccessibleItem*>::iterator m_usedIt;
+    bool m_used = false;
+
 protected:
 
     Ms::EngravingItem* m_element = nullptr;
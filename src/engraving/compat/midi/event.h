@@ -401,6 +401,7 @@ public:
 //---------------------------------------------------------
 //   EventList
 //   EventMap
+//   EventsBuffer
 //---------------------------------------------------------
 
 class EventList : public std::vector<Event>
@@ -423,6 +424,23 @@ public:
     }
 };
 
+//! NOTE The events in the order they were added, without a map node per event.
+//! It is filled by one renderer thread and then merged into the EventMap
+class EventsBuffer : public std::vector<std::pair<int, NPlayEvent> >
+{
+    int _highestChannel = 15;
+public:
+    void insert(const std::pair<int, NPlayEvent>& event) { push_back(event); }
+    void registerChannel(int c)
+    {
+        if (c > _highestChannel) {
+            _highestChannel = c;
+        }
+    }
+
+    int highestChannel() const { return _highestChannel; }
+};
+
 typedef EventList::iterator iEvent;
 typedef EventList::const_iterator ciEvent;
 
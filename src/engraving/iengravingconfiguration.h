@@ -27,6 +27,7 @@
 #include "modularity/imoduleexport.h"
 #include "async/channel.h"
 #include "async/notification.h"
+#include "io/path.h"
 #include "engraving/types/types.h"
 
 namespace mu::draw {
@@ -48,6 +49,8 @@ public:
 
     virtual std::string iconsFontFamily() const = 0;
 
+    virtual io::path_t fontMetricsCachePath() const = 0;
+
     virtual draw::Color defaultColor() const = 0;
     virtual draw::Color scoreInversionColor() const = 0;
     virtual draw::Color invisibleColor() const = 0;
@@ -36,6 +36,10 @@ static const Settings::Key PART_STYLE_FILE_PATH("engraving", "engraving/style/pa
 
 static const Settings::Key INVERT_SCORE_COLOR("engraving", "engraving/scoreColorInversion");
 
+static const Settings::Key USE_ITEM_ALLOCATOR("engraving", "engraving/experimental/useItemAllocator");
+
+static const Settings::Key UNDO_HISTORY_MEMORY_LIMIT_MB("engraving", "engraving/undoHistory/memoryLimitMB");
+
 struct VoiceColorKey {
     Settings::Key key;
     Color color;
@@ -71,6 +75,16 @@ void EngravingConfiguration::init()
         Color currentColor = settings()->value(key).toQColor();
         voiceColorKeys[voice] = VoiceColorKey { std::move(key), currentColor };
     }
+
+    settings()->setDefaultValue(USE_ITEM_ALLOCATOR, Val(false));
+    settings()->setCanBeManuallyEdited(USE_ITEM_ALLOCATOR, true);
+    Ms::MScore::useItemAllocator = settings()->value(USE_ITEM_ALLOCATOR).toBool();
+
+    //! NOTE 0 - no limit
+    settings()->setDefaultValue(UNDO_HISTORY_MEMORY_LIMIT_MB, Val(1024));
+    settings()->setCanBeManuallyEdited(UNDO_HISTORY_MEMORY_LIMIT_MB, true);
+    Ms::MScore::undoHistoryMemoryLimit = static_cast<size_t>(std::max(settings()->value(UNDO_HISTORY_MEMORY_LIMIT_MB).toInt(), 0))
+                                         * 1024 * 1024;
 }
 
 QString EngravingConfiguration::defaultStyleFilePath() const
@@ -98,6 +112,11 @@ std::string EngravingConfiguration::iconsFontFamily() const
     return uiConfiguration()->iconsFontFamily();
 }
 
+mu::io::path_t EngravingConfiguration::fontMetricsCachePath() const
+{
+    return globalConfiguration()->userAppDataPath() + "/fontmetrics";
+}
+
 Color EngravingConfiguration::defaultColor() const
 {
     return Color::black;
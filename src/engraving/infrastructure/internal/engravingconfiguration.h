@@ -25,6 +25,7 @@
 #include "async/asyncable.h"
 
 #include "modularity/ioc.h"
+#include "global/iglobalconfiguration.h"
 #include "ui/iuiconfiguration.h"
 #include "accessibility/iaccessibilityconfiguration.h"
 
@@ -33,6 +34,7 @@
 namespace mu::engraving {
 class EngravingConfiguration : public IEngravingConfiguration, public async::Asyncable
 {
+    INJECT(engraving, mu::framework::IGlobalConfiguration, globalConfiguration)
     INJECT(engraving, mu::ui::IUiConfiguration, uiConfiguration)
     INJECT(engraving, mu::accessibility::IAccessibilityConfiguration, accessibilityConfiguration)
 
@@ -49,6 +51,8 @@ public:
 
     std::string iconsFontFamily() const override;
 
+    io::path_t fontMetricsCachePath() const override;
+
     draw::Color defaultColor() const override;
     draw::Color scoreInversionColor() const override;
     draw::Color invisibleColor() const override;
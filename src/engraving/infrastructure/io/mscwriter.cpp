@@ -69,6 +69,11 @@ const MscWriter::Params& MscWriter::params() const
 
 bool MscWriter::open()
 {
+    if (m_params.deferred) {
+        m_deferredOpened = true;
+        return true;
+    }
+
     return writer()->open(m_params.device, m_params.filePath);
 }
 
@@ -86,6 +91,10 @@ void MscWriter::close()
 
 bool MscWriter::isOpened() const
 {
+    if (m_params.deferred) {
+        return m_deferredOpened;
+    }
+
     return m_writer ? m_writer->isOpened() : false;
 }
 
@@ -113,6 +122,12 @@ MscWriter::IWriter* MscWriter::writer() const
 
 bool MscWriter::addFileData(const QString& fileName, const ByteArray& data)
 {
+    if (m_params.deferred) {
+        m_deferredFiles.push_back({ fileName, data });
+        m_meta.addFile(fileName);
+        return true;
+    }
+
     if (!writer()->addFileData(fileName, data)) {
         LOGE() << "failed write file: " << fileName;
         return false;
@@ -123,6 +138,32 @@ bool MscWriter::addFileData(const QString& fileName, const ByteArray& data)
     return true;
 }
 
+bool MscWriter::writeDeferredFiles()
+{
+    IF_ASSERT_FAILED(m_params.deferred) {
+        return false;
+    }
+
+    std::vector<DeferredFile> files = std::move(m_deferredFiles);
+    m_deferredFiles.clear();
+    m_params.deferred = false;
+    m_deferredOpened = false;
+
+    if (!open()) {
+        return false;
+    }
+
+    for (const DeferredFile& file : files) {
+        if (!addFileData(file.fileName, file.data)) {
+            return false;
+        }
+    }
+
+    close();
+
+    return true;
+}
+
 void MscWriter::writeStyleFile(const ByteArray& data)
 {
     addFileData("score_style.mss", data);
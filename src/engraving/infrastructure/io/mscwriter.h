@@ -22,6 +22,8 @@
 #ifndef MU_ENGRAVING_MSCWRITER_H
 #define MU_ENGRAVING_MSCWRITER_H
 
+#include <vector>
+
 #include <QString>
 
 #include "io/iodevice.h"
@@ -43,6 +45,9 @@ public:
         QString filePath;
         QString mainFileName;
         MscIoMode mode = MscIoMode::Zip;
+
+        //! NOTE The added files are kept in memory until writeDeferredFiles() is called
+        bool deferred = false;
     };
 
     MscWriter() = default;
@@ -67,6 +72,10 @@ public:
     void writeAudioSettingsJsonFile(const ByteArray& data);
     void writeViewSettingsJsonFile(const ByteArray& data);
 
+    //! NOTE Writes the files kept in the deferred mode and closes the writer,
+    //! can be called on another thread than the files were added on
+    bool writeDeferredFiles();
+
 private:
 
     struct IWriter {
@@ -123,6 +132,11 @@ private:
         void addFile(const QString& file);
     };
 
+    struct DeferredFile {
+        QString fileName;
+        ByteArray data;
+    };
+
     IWriter* writer() const;
 
     bool addFileData(const QString& fileName, const ByteArray& data);
@@ -135,6 +149,8 @@ private:
     Params m_params;
     mutable IWriter* m_writer = nullptr;
     Meta m_meta;
+    std::vector<DeferredFile> m_deferredFiles;
+    bool m_deferredOpened = false;
 };
 }
 
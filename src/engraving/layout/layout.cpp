@@ -97,6 +97,9 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
     }
 
     bool layoutAll = stick <= Fraction(0, 1) && (etick < Fraction(0, 1) || etick >= m_score->masterScore()->last()->endTick());
+    if (layoutAll) {
+        ++m_score->m_layoutGeneration;
+    }
     if (stick < Fraction(0, 1)) {
         stick = Fraction(0, 1);
     }
@@ -133,6 +136,19 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
         m = m->prev();
     }
 
+    // the notes of the range are updated again, as well as the notes of the measure
+    // after the range, that may be tied to the edited ones
+    if (!layoutAll) {
+        for (MeasureBase* mb = m; mb; mb = mb->next()) {
+            if (mb->isMeasure()) {
+                toMeasure(mb)->invalidateNotesLayout();
+            }
+            if (mb->tick() > etick) {
+                break;
+            }
+        }
+    }
+
     // if the first measure of the score is part of a multi measure rest
     // m->system() will return a nullptr. We need to find the multi measure
     // rest which replaces the measure range
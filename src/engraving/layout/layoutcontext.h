@@ -22,6 +22,7 @@
 #ifndef MU_ENGRAVING_LAYOUTCONTEXT_H
 #define MU_ENGRAVING_LAYOUTCONTEXT_H
 
+#include <map>
 #include <vector>
 #include <set>
 
@@ -55,6 +56,8 @@ public:
     Ms::Fraction tick{ 0, 1 };
 
     std::vector<Ms::System*> systemList; // reusable systems
+    std::map<Ms::System*, std::vector<qreal> > stableSystems; // systems taken unchanged from previous layout (after rangeDone),
+                                                              // with the staff positions they had
     std::set<Ms::Spanner*> processedSpanners;
 
     Ms::System* prevSystem = nullptr; // used during page layout
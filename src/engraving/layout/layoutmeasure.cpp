@@ -577,6 +577,32 @@ static void layoutDrumsetChord(Chord* c, const Drumset* drumset, const StaffType
     }
 }
 
+//---------------------------------------------------------
+//   makeNotesLayoutKey
+//    the notes of the measure are updated again
+//    when the full layout is done or the staves context changes
+//---------------------------------------------------------
+
+static Measure::NotesLayoutKey makeNotesLayoutKey(Score* score, const Measure* measure)
+{
+    Measure::NotesLayoutKey key;
+    key.generation = score->layoutGeneration();
+    key.tick = measure->tick();
+    key.context.reserve(score->nstaves() * 6);
+
+    for (Staff* staff : score->staves()) {
+        const Instrument* instrument = staff->part()->instrument(key.tick);
+        key.context.push_back(static_cast<int>(staff->clef(key.tick)));
+        key.context.push_back(static_cast<int>(staff->key(key.tick)));
+        key.context.push_back(staff->pitchOffset(key.tick));
+        key.context.push_back(instrument->transpose().chromatic);
+        key.context.push_back(instrument->transpose().diatonic);
+        key.context.push_back(staff->staffType(key.tick)->lines());
+    }
+
+    return key;
+}
+
 void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext& ctx)
 {
     Ms::Score* score = ctx.score();
@@ -655,6 +681,9 @@ void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext&
 
     measure->connectTremolo();
 
+    Measure::NotesLayoutKey notesLayoutKey = makeNotesLayoutKey(score, measure);
+    bool notesUpToDate = !measure->isMMRest() && notesLayoutKey == measure->notesLayoutKey();
+
     //
     // calculate accidentals and note lines,
     // create stem and set stem direction
@@ -695,7 +724,9 @@ void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext&
 
                     if (cr->isChord()) {
                         Chord* chord = toChord(cr);
-                        chord->cmdUpdateNotes(&as);
+                        if (!notesUpToDate || drumset || st->group() != StaffGroup::STANDARD) {
+                            chord->cmdUpdateNotes(&as);
+                        }
                         for (Chord* c : chord->graceNotes()) {
                             c->setMag(m * score->styleD(Sid::graceNoteMag));
                             c->setTrack(t);
@@ -829,6 +860,10 @@ void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext&
     measure->computeTicks(); // Must be called *after* Segment::createShapes() because it relies on the
     // Segment::visible() property, which is determined by Segment::createShapes().
 
+    if (!measure->isMMRest()) {
+        measure->setNotesLayoutKey(std::move(notesLayoutKey));
+    }
+
     ctx.tick += measure->ticks();
 }
 
@@ -53,6 +53,21 @@
 using namespace mu::engraving;
 using namespace Ms;
 
+//---------------------------------------------------------
+//   staffPositions
+//    y positions of the staves in the system, -1 for hidden staves
+//---------------------------------------------------------
+
+static std::vector<qreal> staffPositions(const System* system)
+{
+    std::vector<qreal> positions;
+    positions.reserve(system->staves().size());
+    for (const SysStaff* staff : system->staves()) {
+        positions.push_back(staff->show() ? staff->y() : -1.0);
+    }
+    return positions;
+}
+
 //---------------------------------------------------------
 //   getNextPage
 //---------------------------------------------------------
@@ -199,6 +214,9 @@ void LayoutPage::collectPage(const LayoutOptions& options, LayoutContext& ctx)
                     ctx.score()->systems().push_back(nextSystem);
                 }
             }
+            if (nextSystem) {
+                ctx.stableSystems[nextSystem] = staffPositions(nextSystem);
+            }
         } else {
             nextSystem = LayoutSystem::collectSystem(options, ctx, ctx.score());
             if (nextSystem) {
@@ -251,6 +269,8 @@ void LayoutPage::collectPage(const LayoutOptions& options, LayoutContext& ctx)
     Fraction stick = Fraction(-1, 1);
     for (System* s : ctx.page->systems()) {
         Score* currentScore = ctx.score();
+        auto stableIt = ctx.stableSystems.find(s);
+        bool isStable = stableIt != ctx.stableSystems.end() && stableIt->second == staffPositions(s);
         for (MeasureBase* mb : s->measures()) {
             if (!mb->isMeasure()) {
                 continue;
@@ -260,6 +280,10 @@ void LayoutPage::collectPage(const LayoutOptions& options, LayoutContext& ctx)
                 stick = m->tick();
             }
 
+            // the horizontal layout of a stable system has not changed, and if its staves
+            // have not been moved either, its cross staff beams, tuplets, arpeggios and tremolos
+            // are still valid. The spanners are laid out anyway: their other end can be outside
+            // of the stable system and could have been changed
             for (size_t track = 0; track < currentScore->ntracks(); ++track) {
                 for (Segment* segment = m->first(); segment; segment = segment->next()) {
                     EngravingItem* e = segment->element(static_cast<int>(track));
@@ -271,10 +295,10 @@ void LayoutPage::collectPage(const LayoutOptions& options, LayoutContext& ctx)
                             continue;
                         }
                         ChordRest* cr = toChordRest(e);
-                        if (LayoutBeams::notTopBeam(cr)) {                           // layout cross staff beams
+                        if (!isStable && LayoutBeams::notTopBeam(cr)) {              // layout cross staff beams
                             cr->beam()->layout();
                         }
-                        if (LayoutTuplets::notTopTuplet(cr)) {
+                        if (!isStable && LayoutTuplets::notTopTuplet(cr)) {
                             // fix layout of tuplets
                             DurationElement* de = cr;
                             while (de->tuplet() && de->tuplet()->elements().front() == de) {
@@ -287,7 +311,7 @@ void LayoutPage::collectPage(const LayoutOptions& options, LayoutContext& ctx)
                         if (cr->isChord()) {
                             Chord* c = toChord(cr);
                             for (Chord* cc : c->graceNotes()) {
-                                if (cc->beam() && cc->beam()->elements().front() == cc) {
+                                if (!isStable && cc->beam() && cc->beam()->elements().front() == cc) {
                                     cc->beam()->layout();
                                 }
                                 cc->layoutSpanners();
@@ -297,9 +321,11 @@ void LayoutPage::collectPage(const LayoutOptions& options, LayoutContext& ctx)
                                     }
                                 }
                             }
-                            c->layoutArpeggio2();
+                            if (!isStable) {
+                                c->layoutArpeggio2();
+                            }
                             c->layoutSpanners();
-                            if (c->tremolo()) {
+                            if (!isStable && c->tremolo()) {
                                 Tremolo* t = c->tremolo();
                                 Chord* c1 = t->chord1();
                                 Chord* c2 = t->chord2();
@@ -20,6 +20,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cmath>
 
 #include "bsp.h"
@@ -28,117 +29,140 @@
 using namespace mu;
 
 namespace Ms {
+static constexpr int ITEMS_PER_CELL = 8;
+static constexpr int MAX_CELLS_COUNT = 64 * 64;
+
 //---------------------------------------------------------
-//   InsertItemBspTreeVisitor
+//   initialize
 //---------------------------------------------------------
 
-class InsertItemBspTreeVisitor : public BspTreeVisitor
+void BspTree::initialize(const RectF& rect, int n)
 {
-public:
-    EngravingItem* item;
+    clear();
 
-    inline void visit(std::list<EngravingItem*>* items) { items->push_front(item); }
-};
+    m_rect = rect;
 
-//---------------------------------------------------------
-//   RemoveItemBspTreeVisitor
-//---------------------------------------------------------
+    const int cellsCount = std::clamp(n / ITEMS_PER_CELL, 1, MAX_CELLS_COUNT);
+    const qreal aspectRatio = (rect.width() > 0.0 && rect.height() > 0.0) ? rect.width() / rect.height() : 1.0;
 
-class RemoveItemBspTreeVisitor : public BspTreeVisitor
-{
-public:
-    EngravingItem* item;
+    m_columns = std::clamp(static_cast<int>(std::lround(std::sqrt(cellsCount * aspectRatio))), 1, cellsCount);
+    m_rows = std::max(cellsCount / m_columns, 1);
+    m_cellWidth = rect.width() / m_columns;
+    m_cellHeight = rect.height() / m_rows;
 
-    inline void visit(std::list<EngravingItem*>* items) { items->remove(item); }
-};
+    m_cells.resize(static_cast<size_t>(m_columns) * m_rows);
+}
 
 //---------------------------------------------------------
-//   FindItemBspTreeVisitor
+//   clear
 //---------------------------------------------------------
 
-class FindItemBspTreeVisitor : public BspTreeVisitor
+void BspTree::clear()
 {
-public:
-    std::list<EngravingItem*> foundItems;
-
-    void visit(std::list<EngravingItem*>* items)
-    {
-        for (auto it = items->begin(); it != items->end(); ++it) {
-            EngravingItem* item = *it;
-            if (!item->itemDiscovered) {
-                item->itemDiscovered = true;
-                foundItems.push_front(item);
-            }
-        }
-    }
-};
+    m_cells.clear();
+    m_entries.clear();
+    m_columns = 0;
+    m_rows = 0;
+}
 
 //---------------------------------------------------------
-//   BspTree
+//   needsRebuild
+//    the grid is sized for the area and the number of
+//    elements it was initialized with
 //---------------------------------------------------------
 
-BspTree::BspTree()
-    : leafCnt(0)
+bool BspTree::needsRebuild(const RectF& rect) const
 {
-    depth = 0;
+    if (m_cells.empty() || rect != m_rect) {
+        return true;
+    }
+
+    const size_t cellsCount = m_cells.size();
+    return cellsCount < MAX_CELLS_COUNT && m_entries.size() > 2 * cellsCount * ITEMS_PER_CELL;
 }
 
 //---------------------------------------------------------
-//   intmaxlog
+//   insert
 //---------------------------------------------------------
 
-static inline int intmaxlog(int n)
+void BspTree::insert(EngravingItem* element)
 {
-    return n > 0 ? qMax(int(::ceil(::log(qreal(n)) / ::log(qreal(2)))), 5) : 0;
+    update(element);
 }
 
 //---------------------------------------------------------
-//   initialize
+//   remove
 //---------------------------------------------------------
 
-void BspTree::initialize(const RectF& rec, int n)
+void BspTree::remove(EngravingItem* element)
 {
-    depth      = intmaxlog(n);
-    this->rect = rec;
-    leafCnt    = 0;
-
-    nodes.resize((1 << (depth + 1)) - 1);
-    leaves.resize(1LL << depth);
-    std::fill(leaves.begin(), leaves.end(), std::list<EngravingItem*>());
-    initialize(rec, depth, 0);
+    auto it = m_entries.find(element);
+    if (it == m_entries.end()) {
+        return;
+    }
+
+    removeFromCells(element, it->second.cells);
+    m_entries.erase(it);
 }
 
 //---------------------------------------------------------
-//   clear
+//   beginUpdate
+//    starts a pass over all the elements of the page,
+//    every element has to be passed to update()
 //---------------------------------------------------------
 
-void BspTree::clear()
+void BspTree::beginUpdate()
 {
-    leafCnt = 0;
-    nodes.clear();
-    leaves.clear();
+    ++m_generation;
 }
 
 //---------------------------------------------------------
-//   insert
+//   update
+//    inserts the element or moves it to the cells of its
+//    current bounding rectangle
 //---------------------------------------------------------
 
-void BspTree::insert(EngravingItem* element)
+void BspTree::update(EngravingItem* element)
 {
-    InsertItemBspTreeVisitor insertVisitor;
-    insertVisitor.item = element;
-    climbTree(&insertVisitor, element->pageBoundingRect());
+    if (m_cells.empty()) {
+        return;
+    }
+
+    CellRange range = cellRange(element->pageBoundingRect());
+
+    auto it = m_entries.find(element);
+    if (it == m_entries.end()) {
+        addToCells(element, range);
+        m_entries.emplace(element, Entry { range, m_generation });
+        return;
+    }
+
+    Entry& entry = it->second;
+    if (entry.cells != range) {
+        removeFromCells(element, entry.cells);
+        addToCells(element, range);
+        entry.cells = range;
+    }
+    entry.generation = m_generation;
 }
 
 //---------------------------------------------------------
-//   remove
+//   endUpdate
+//    removes the elements which were not passed to update()
+//    since beginUpdate(). They may already be deleted, so
+//    they are not dereferenced.
 //---------------------------------------------------------
 
-void BspTree::remove(EngravingItem* element)
+void BspTree::endUpdate()
 {
-    RemoveItemBspTreeVisitor removeVisitor;
-    removeVisitor.item = element;
-    climbTree(&removeVisitor, element->pageBoundingRect());
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.generation != m_generation) {
+            removeFromCells(it->first, it->second.cells);
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 //---------------------------------------------------------
@@ -147,10 +171,25 @@ void BspTree::remove(EngravingItem* element)
 
 std::vector<EngravingItem*> BspTree::items(const RectF& rec)
 {
-    FindItemBspTreeVisitor findVisitor;
-    climbTree(&findVisitor, rec);
+    std::vector<EngravingItem*> found;
+    if (m_cells.empty()) {
+        return found;
+    }
+
+    const CellRange range = cellRange(rec);
+    for (int r = range.row1; r <= range.row2; ++r) {
+        for (int c = range.col1; c <= range.col2; ++c) {
+            for (EngravingItem* e : m_cells[r * m_columns + c]) {
+                if (!e->itemDiscovered) {
+                    e->itemDiscovered = true;
+                    found.push_back(e);
+                }
+            }
+        }
+    }
+
     std::vector<EngravingItem*> l;
-    for (EngravingItem* e : qAsConst(findVisitor.foundItems)) {
+    for (EngravingItem* e : found) {
         e->itemDiscovered = false;
         if (e->pageBoundingRect().intersects(rec)) {
             l.push_back(e);
@@ -165,12 +204,12 @@ std::vector<EngravingItem*> BspTree::items(const RectF& rec)
 
 std::vector<EngravingItem*> BspTree::items(const PointF& pos)
 {
-    FindItemBspTreeVisitor findVisitor;
-    climbTree(&findVisitor, pos);
-
     std::vector<EngravingItem*> l;
-    for (EngravingItem* e : qAsConst(findVisitor.foundItems)) {
-        e->itemDiscovered = false;
+    if (m_cells.empty()) {
+        return l;
+    }
+
+    for (EngravingItem* e : m_cells[row(pos.y()) * m_columns + column(pos.x())]) {
         if (e->contains(pos)) {
             l.push_back(e);
         }
@@ -178,187 +217,74 @@ std::vector<EngravingItem*> BspTree::items(const PointF& pos)
     return l;
 }
 
-#ifndef NDEBUG
 //---------------------------------------------------------
-//   debug
+//   column / row
+//    cells of the points outside of the indexed area are
+//    the nearest border cells
 //---------------------------------------------------------
 
-QString BspTree::debug(int index) const
+int BspTree::column(qreal x) const
 {
-    const Node* node = &nodes.at(index);
-
-    QString tmp;
-    if (node->type == Node::Type::LEAF) {
-        RectF rec = rectForIndex(index);
-        if (!leaves[node->leafIndex].empty()) {
-            tmp += QString::fromLatin1("[%1, %2, %3, %4] contains %5 items\n")
-                   .arg(rec.left()).arg(rec.top())
-                   .arg(rec.width()).arg(rec.height())
-                   .arg(leaves[node->leafIndex].size());
-        }
-    } else {
-        if (node->type == Node::Type::HORIZONTAL) {
-            tmp += debug(firstChildIndex(index));
-            tmp += debug(firstChildIndex(index) + 1);
-        } else {
-            tmp += debug(firstChildIndex(index));
-            tmp += debug(firstChildIndex(index) + 1);
-        }
+    const qreal c = m_cellWidth > 0.0 ? std::floor((x - m_rect.left()) / m_cellWidth) : 0.0;
+    if (!(c > 0.0)) {
+        return 0;
     }
-    return tmp;
+    return c >= m_columns ? m_columns - 1 : static_cast<int>(c);
 }
 
-#endif
-
-//---------------------------------------------------------
-//   initialize
-//---------------------------------------------------------
-
-void BspTree::initialize(const RectF& rec, int dep, int index)
+int BspTree::row(qreal y) const
 {
-    Node* node = &nodes[index];
-    if (index == 0) {
-        node->type = Node::Type::HORIZONTAL;
-        node->offset = rec.center().x();
-    }
-
-    if (dep) {
-        Node::Type type;
-        RectF rect1, rect2;
-        qreal offset1, offset2;
-
-        if (node->type == Node::Type::HORIZONTAL) {
-            type = Node::Type::VERTICAL;
-            rect1.setRect(rec.left(), rec.top(), rec.width(), rec.height() * .5);
-            rect2.setRect(rect1.left(), rect1.bottom(), rect1.width(), rec.height() - rect1.height());
-            offset1 = rect1.center().x();
-            offset2 = rect2.center().x();
-        } else {
-            type = Node::Type::HORIZONTAL;
-            rect1.setRect(rec.left(), rec.top(), rec.width() * .5, rec.height());
-            rect2.setRect(rect1.right(), rect1.top(), rec.width() - rect1.width(), rect1.height());
-            offset1 = rect1.center().y();
-            offset2 = rect2.center().y();
-        }
-
-        int childIndex = firstChildIndex(index);
-
-        Node* child   = &nodes[childIndex];
-        child->offset = offset1;
-        child->type   = type;
-
-        child = &nodes[childIndex + 1];
-        child->offset = offset2;
-        child->type   = type;
-
-        initialize(rect1, dep - 1, childIndex);
-        initialize(rect2, dep - 1, childIndex + 1);
-    } else {
-        node->type      = Node::Type::LEAF;
-        node->leafIndex = leafCnt++;
+    const qreal r = m_cellHeight > 0.0 ? std::floor((y - m_rect.top()) / m_cellHeight) : 0.0;
+    if (!(r > 0.0)) {
+        return 0;
     }
+    return r >= m_rows ? m_rows - 1 : static_cast<int>(r);
 }
 
 //---------------------------------------------------------
-//   climbTree
+//   cellRange
 //---------------------------------------------------------
 
-void BspTree::climbTree(BspTreeVisitor* visitor, const mu::PointF& pos, int index)
+BspTree::CellRange BspTree::cellRange(const RectF& rect) const
 {
-    if (nodes.empty()) {
-        return;
-    }
-
-    Node* node = &nodes[index];
-    int childIndex = firstChildIndex(index);
-
-    switch (node->type) {
-    case Node::Type::LEAF:
-        visitor->visit(&leaves[node->leafIndex]);
-        break;
-    case Node::Type::VERTICAL:
-        if (pos.x() < node->offset) {
-            climbTree(visitor, pos, childIndex);
-        } else {
-            climbTree(visitor, pos, childIndex + 1);
-        }
-        break;
-    case Node::Type::HORIZONTAL:
-        if (pos.y() < node->offset) {
-            climbTree(visitor, pos, childIndex);
-        } else {
-            climbTree(visitor, pos, childIndex + 1);
-        }
-        break;
-    }
+    const RectF r = rect.normalized();
+
+    CellRange range;
+    range.col1 = column(r.left());
+    range.row1 = row(r.top());
+    range.col2 = column(r.right());
+    range.row2 = row(r.bottom());
+    return range;
 }
 
 //---------------------------------------------------------
-//   climbTree
+//   addToCells
 //---------------------------------------------------------
 
-void BspTree::climbTree(BspTreeVisitor* visitor, const mu::RectF& rec, int index)
+void BspTree::addToCells(EngravingItem* item, const CellRange& range)
 {
-    if (nodes.empty()) {
-        return;
-    }
-
-    Node* node = &nodes[index];
-    int childIndex = firstChildIndex(index);
-
-    switch (node->type) {
-    case Node::Type::LEAF:
-        visitor->visit(&leaves[node->leafIndex]);
-        break;
-    case Node::Type::VERTICAL:
-        if (rec.left() < node->offset) {
-            climbTree(visitor, rec, childIndex);
-            if (rec.right() >= node->offset) {
-                climbTree(visitor, rec, childIndex + 1);
-            }
-        } else {
-            climbTree(visitor, rec, childIndex + 1);
-        }
-        break;
-    case Node::Type::HORIZONTAL:
-        if (rec.top() < node->offset) {
-            climbTree(visitor, rec, childIndex);
-            if (rec.bottom() >= node->offset) {
-                climbTree(visitor, rec, childIndex + 1);
-            }
-        } else {
-            climbTree(visitor, rec, childIndex + 1);
+    for (int r = range.row1; r <= range.row2; ++r) {
+        for (int c = range.col1; c <= range.col2; ++c) {
+            m_cells[r * m_columns + c].push_back(item);
         }
     }
 }
 
 //---------------------------------------------------------
-//   rectForIndex
+//   removeFromCells
 //---------------------------------------------------------
 
-mu::RectF BspTree::rectForIndex(int index) const
+void BspTree::removeFromCells(EngravingItem* item, const CellRange& range)
 {
-    if (index <= 0) {
-        return rect;
-    }
-
-    int parentIdx = parentIndex(index);
-    RectF rec   = rectForIndex(parentIdx);
-    const Node* parent = &nodes.at(parentIdx);
-
-    if (parent->type == Node::Type::HORIZONTAL) {
-        if (index & 1) {
-            rec.setRight(parent->offset);
-        } else {
-            rec.setLeft(parent->offset);
-        }
-    } else {
-        if (index & 1) {
-            rec.setBottom(parent->offset);
-        } else {
-            rec.setTop(parent->offset);
+    for (int r = range.row1; r <= range.row2; ++r) {
+        for (int c = range.col1; c <= range.col2; ++c) {
+            std::vector<EngravingItem*>& cell = m_cells[r * m_columns + c];
+            auto it = std::find(cell.begin(), cell.end(), item);
+            if (it != cell.end()) {
+                *it = cell.back();
+                cell.pop_back();
+            }
         }
     }
-    return rec;
 }
 }
@@ -23,85 +23,81 @@
 #ifndef __BSP_H__
 #define __BSP_H__
 
-#include <list>
+#include <vector>
+#include <unordered_map>
 
 #include "infrastructure/draw/geometry.h"
 
 namespace Ms {
-class BspTreeVisitor;
-class InsertItemBspTreeVisitor;
-class RemoveItemBspTreeVisitor;
-class FindItemBspTreeVisitor;
-
 class EngravingItem;
 
 //---------------------------------------------------------
 //   BspTree
-//    binary space partitioning
+//    spatial index of the page elements
+//
+//    The indexed area is divided into a uniform grid of
+//    cells, each cell keeps a flat list of the elements
+//    whose bounding rectangle overlaps it. Every element
+//    remembers the rectangle it was indexed with, so after
+//    a layout only the elements which moved have to be
+//    reinserted (see beginUpdate/update/endUpdate).
 //---------------------------------------------------------
 
 class BspTree
 {
 public:
-    struct Node {
-        enum class Type : char {
-            HORIZONTAL, VERTICAL, LEAF
-        };
-        union {
-            qreal offset;
-            int leafIndex;
-        };
-        Type type;
-    };
-private:
-    uint depth;
-    void initialize(const mu::RectF& rect, int depth, int index);
-    void climbTree(BspTreeVisitor* visitor, const mu::PointF& pos, int index = 0);
-    void climbTree(BspTreeVisitor* visitor, const mu::RectF& rect, int index = 0);
-
-    void findItems(std::list<EngravingItem*>* foundItems, const mu::RectF& rect, int index);
-    void findItems(std::list<EngravingItem*>* foundItems, const mu::PointF& pos, int index);
-    mu::RectF rectForIndex(int index) const;
-
-    std::vector<Node> nodes;
-    std::vector<std::list<EngravingItem*> > leaves;
-    int leafCnt;
-    mu::RectF rect;
+    BspTree() = default;
 
-public:
-    BspTree();
-
-    void initialize(const mu::RectF& rect, int depth);
+    void initialize(const mu::RectF& rect, int n);
     void clear();
+    bool needsRebuild(const mu::RectF& rect) const;
 
     void insert(EngravingItem* item);
     void remove(EngravingItem* item);
 
+    void beginUpdate();
+    void update(EngravingItem* item);
+    void endUpdate();
+
     std::vector<EngravingItem*> items(const mu::RectF& rect);
     std::vector<EngravingItem*> items(const mu::PointF& pos);
 
-    int leafCount() const { return leafCnt; }
-    inline int firstChildIndex(int index) const { return index * 2 + 1; }
+private:
+    struct CellRange {
+        int col1 = 0;
+        int row1 = 0;
+        int col2 = -1;
+        int row2 = -1;
+
+        bool operator==(const CellRange& r) const
+        {
+            return col1 == r.col1 && row1 == r.row1 && col2 == r.col2 && row2 == r.row2;
+        }
+
+        bool operator!=(const CellRange& r) const { return !operator==(r); }
+    };
+
+    struct Entry {
+        CellRange cells;
+        unsigned generation = 0;
+    };
 
-    inline int parentIndex(int index) const
-    {
-        return index > 0 ? ((index & 1) ? ((index - 1) / 2) : ((index - 2) / 2)) : -1;
-    }
+    CellRange cellRange(const mu::RectF& rect) const;
+    int column(qreal x) const;
+    int row(qreal y) const;
 
-#ifndef NDEBUG
-    QString debug(int index) const;
-#endif
-};
+    void addToCells(EngravingItem* item, const CellRange& range);
+    void removeFromCells(EngravingItem* item, const CellRange& range);
 
-//---------------------------------------------------------
-//   BspTreeVisitor
-//---------------------------------------------------------
+    mu::RectF m_rect;
+    int m_columns = 0;
+    int m_rows = 0;
+    qreal m_cellWidth = 0.0;
+    qreal m_cellHeight = 0.0;
 
-class BspTreeVisitor
-{
-public:
-    virtual ~BspTreeVisitor() {}
-    virtual void visit(std::list<EngravingItem*>* items) = 0;
+    std::vector<std::vector<EngravingItem*> > m_cells;
+    std::unordered_map<EngravingItem*, Entry> m_entries;
+    unsigned m_generation = 0;
 };
 }     // namespace Ms
 #endif
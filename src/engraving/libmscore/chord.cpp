@@ -35,6 +35,7 @@
 #include "note.h"
 #include "segment.h"
 #include "text.h"
+#include "masterscore.h"
 #include "measure.h"
 #include "system.h"
 #include "tuplet.h"
@@ -956,7 +957,7 @@ void Chord::addLedgerLines()
             qreal _spatium = spatium();
             qreal stepDistance = lineDistance * 0.5;
             for (auto lld : vecLines) {
-                LedgerLine* h = new LedgerLine(score());
+                LedgerLine* h = new (masterScore()->itemAllocator()) LedgerLine(score());
                 h->setParent(this);
                 h->setTrack(track);
                 h->setVisible(lld.visible && staffVisible);
@@ -1704,7 +1705,7 @@ void Chord::removeStem()
 
 void Chord::createHook()
 {
-    Hook* hook = new Hook(this);
+    Hook* hook = new (masterScore()->itemAllocator()) Hook(this);
     hook->setParent(this);
     hook->setGenerated(true);
     score()->undoAddElement(hook);
@@ -2350,7 +2351,7 @@ void Chord::layoutTablature()
         qreal extraLen    = 0;
         qreal llX         = stemX - (headWidth + extraLen) * 0.5;
         for (int i = 0; i < ledgerLines; i++) {
-            LedgerLine* ldgLin = new LedgerLine(score());
+            LedgerLine* ldgLin = new (masterScore()->itemAllocator()) LedgerLine(score());
             ldgLin->setParent(this);
             ldgLin->setTrack(track());
             ldgLin->setVisible(visible());
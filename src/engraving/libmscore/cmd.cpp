@@ -369,6 +369,53 @@ ScoreChangesRange Score::changesRange() const
              cmdState.startStaff(), cmdState.endStaff(), changedTypes() };
 }
 
+//---------------------------------------------------------
+//   UpdateHistory::addRefresh
+//---------------------------------------------------------
+
+void UpdateHistory::addRefresh(const RectF& r)
+{
+    _refreshes.push_back({ ++_lastUpdate, r });
+    if (_refreshes.size() > MAX_REFRESHES) {
+        _refreshes.pop_front();
+    }
+}
+
+//---------------------------------------------------------
+//   UpdateHistory::addUpdateAll
+//---------------------------------------------------------
+
+void UpdateHistory::addUpdateAll()
+{
+    _lastUpdateAll = ++_lastUpdate;
+    _refreshes.clear();
+}
+
+//---------------------------------------------------------
+//   UpdateHistory::refreshSince
+//---------------------------------------------------------
+
+bool UpdateHistory::refreshSince(uint64_t update, std::vector<RectF>& rects) const
+{
+    if (update < _lastUpdateAll) {
+        return false;
+    }
+
+    // the refreshes are numbered one by one after the last update all,
+    // a gap means that the ones needed are already dropped
+    if (!_refreshes.empty() && _refreshes.front().first > update + 1) {
+        return false;
+    }
+
+    for (const auto& refresh : _refreshes) {
+        if (refresh.first > update) {
+            rects.push_back(refresh.second);
+        }
+    }
+
+    return true;
+}
+
 #ifndef NDEBUG
 //---------------------------------------------------------
 //   CmdState::dump
@@ -184,6 +184,26 @@ EngravingItem::~EngravingItem()
     Score::onElementDestruction(this);
 }
 
+void* EngravingItem::operator new(size_t size)
+{
+    return ::operator new(size);
+}
+
+void* EngravingItem::operator new(size_t size, ItemAllocator* allocator)
+{
+    return allocator ? allocator->allocate(size) : ::operator new(size);
+}
+
+void EngravingItem::operator delete(void* ptr)
+{
+    ItemAllocator::deallocate(ptr);
+}
+
+void EngravingItem::operator delete(void* ptr, ItemAllocator*)
+{
+    ItemAllocator::deallocate(ptr);
+}
+
 void EngravingItem::setupAccessible()
 {
     if (m_accessible) {
@@ -202,6 +222,12 @@ void EngravingItem::setupAccessible()
     }
 }
 
+void EngravingItem::releaseAccessible()
+{
+    delete m_accessible;
+    m_accessible = nullptr;
+}
+
 bool EngravingItem::accessibleEnabled() const
 {
     return m_accessibleEnabled;
@@ -2739,6 +2765,8 @@ void EngravingItem::setSelected(bool f)
         initAccessibleIfNeed();
 
         if (m_accessible) {
+            mu::engraving::AccessibleItem::markAsUsed(m_accessible);
+
             AccessibleRoot* currAccRoot = m_accessible->accessibleRoot();
             AccessibleRoot* accRoot = score()->rootItem()->accessible()->accessibleRoot();
             AccessibleRoot* dummyAccRoot = score()->dummy()->rootItem()->accessible()->accessibleRoot();
@@ -2762,10 +2790,12 @@ void EngravingItem::initAccessibleIfNeed()
         return;
     }
 
-    if (m_accessible || !m_accessibleEnabled) {
+    if (!m_accessibleEnabled) {
         return;
     }
 
+    //! NOTE The parents are checked even if the item has the accessible object,
+    //! they could have been released while the item was not used, see AccessibleItem::markAsUsed
     EngravingItemList parents;
     auto parent = parentItem();
     while (parent) {
@@ -2795,6 +2825,11 @@ KerningType EngravingItem::computeKerningType(const EngravingItem* nextItem) con
     return doComputeKerningType(nextItem);
 }
 
+bool EngravingItem::limitsKerningWithNext() const
+{
+    return _userSetKerning != KerningType::NOT_SET || neverKernable();
+}
+
 QString EngravingItem::formatBarsAndBeats() const
 {
     QString result;
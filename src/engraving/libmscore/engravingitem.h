@@ -36,6 +36,7 @@
 
 #include "modularity/ioc.h"
 #include "iengravingconfiguration.h"
+#include "itemallocator.h"
 
 #include "types/symid.h"
 #include "types/fraction.h"
@@ -245,10 +246,21 @@ public:
 
     virtual ~EngravingItem();
 
+    static void* operator new(size_t size);
+    static void* operator new(size_t size, mu::engraving::ItemAllocator* allocator);
+    static void operator delete(void* ptr);
+    static void operator delete(void* ptr, mu::engraving::ItemAllocator* allocator);
+
     KerningType computeKerningType(const EngravingItem* nextItem) const;
+    //! NOTE computeKerningType() gives KERNING for the items which don't limit the kerning with the next/previous item,
+    //! unless both of them are limited to the same voice and have the same track
+    virtual bool limitsKerningWithNext() const;
+    bool limitsKerningWithPrevious() const { return neverKernable(); }
+    bool isKerningLimitedToSameVoice() const { return sameVoiceKerningLimited(); }
     virtual double computePadding(const EngravingItem* nextItem) const;
 
     virtual void setupAccessible();
+    void releaseAccessible();
     bool accessibleEnabled() const;
     void setAccessibleEnabled(bool enabled);
 
@@ -23,6 +23,7 @@
 #include "factory.h"
 
 #include "score.h"
+#include "masterscore.h"
 
 #include "page.h"
 #include "rest.h"
@@ -229,6 +230,18 @@ static const ElementName elementNames[] = {
 };
 /* *INDENT-ON* */
 
+//! NOTE Only the types with a lot of instances in a score are taken from the score's allocator (if any),
+//! the rest ones would waste the chunks of the allocator
+static ItemAllocator* itemAllocator(const EngravingObject* object)
+{
+    if (!object || !object->score()) {
+        return nullptr;
+    }
+
+    MasterScore* masterScore = object->masterScore();
+    return masterScore ? masterScore->itemAllocator() : nullptr;
+}
+
 EngravingItem* Factory::createItem(ElementType type, EngravingItem* parent, bool isAccessibleEnabled)
 {
     EngravingItem* item = doCreateItem(type, parent);
@@ -240,6 +253,8 @@ EngravingItem* Factory::createItem(ElementType type, EngravingItem* parent, bool
 EngravingItem* Factory::doCreateItem(ElementType type, EngravingItem* parent)
 {
     auto dummy = parent->score()->dummy();
+    ItemAllocator* allocator = itemAllocator(parent);
+
     switch (type) {
     case ElementType::VOLTA:             return new Volta(parent);
     case ElementType::OTTAVA:            return new Ottava(parent);
@@ -256,17 +271,17 @@ EngravingItem* Factory::doCreateItem(ElementType type, EngravingItem* parent)
     case ElementType::CLEF:              return new Clef(parent->isSegment() ? toSegment(parent) : dummy->segment());
     case ElementType::KEYSIG:            return new KeySig(parent->isSegment() ? toSegment(parent) : dummy->segment());
     case ElementType::TIMESIG:           return new TimeSig(parent->isSegment() ? toSegment(parent) : dummy->segment());
-    case ElementType::BAR_LINE:          return new BarLine(parent->isSegment() ? toSegment(parent) : dummy->segment());
+    case ElementType::BAR_LINE:          return new (allocator) BarLine(parent->isSegment() ? toSegment(parent) : dummy->segment());
     case ElementType::SYSTEM_DIVIDER:    return new SystemDivider(parent->isSystem() ? toSystem(parent) : dummy->system());
     case ElementType::ARPEGGIO:          return new Arpeggio(parent->isChord() ? toChord(parent) : dummy->chord());
     case ElementType::BREATH:            return new Breath(parent->isSegment() ? toSegment(parent) : dummy->segment());
     case ElementType::GLISSANDO:         return new Glissando(parent);
     case ElementType::BRACKET:           return new Bracket(parent);
-    case ElementType::ARTICULATION:      return new Articulation(parent->isChordRest() ? toChordRest(parent) : dummy->chord());
+    case ElementType::ARTICULATION:      return new (allocator) Articulation(parent->isChordRest() ? toChordRest(parent) : dummy->chord());
     case ElementType::FERMATA:           return new Fermata(parent);
     case ElementType::CHORDLINE:         return new ChordLine(parent->isChord() ? toChord(parent) : dummy->chord());
     case ElementType::SLIDE:             return new Slide(parent->isChord() ? toChord(parent) : dummy->chord());
-    case ElementType::ACCIDENTAL:        return new Accidental(parent);
+    case ElementType::ACCIDENTAL:        return new (allocator) Accidental(parent);
     case ElementType::DYNAMIC:           return new Dynamic(parent->isSegment() ? toSegment(parent) : dummy->segment());
     case ElementType::TEXT:              return new Text(parent);
     case ElementType::MEASURE_NUMBER:    return new MeasureNumber(parent->isMeasure() ? toMeasure(parent) : dummy->measure());
@@ -281,11 +296,11 @@ EngravingItem* Factory::doCreateItem(ElementType type, EngravingItem* parent)
     case ElementType::NOTEHEAD:          return new NoteHead(parent->isNote() ? toNote(parent) : dummy->note());
     case ElementType::NOTEDOT: {
         if (parent->isNote()) {
-            return new NoteDot(toNote(parent));
+            return new (allocator) NoteDot(toNote(parent));
         } else if (parent->isRest()) {
-            return new NoteDot(toRest(parent));
+            return new (allocator) NoteDot(toRest(parent));
         } else {
-            return new NoteDot(dummy->note());
+            return new (allocator) NoteDot(dummy->note());
         }
     }
     case ElementType::TREMOLO:           return new Tremolo(parent->isChord() ? toChord(parent) : dummy->chord());
@@ -294,11 +309,11 @@ EngravingItem* Factory::doCreateItem(ElementType type, EngravingItem* parent)
     case ElementType::JUMP:              return new Jump(parent->isMeasure() ? toMeasure(parent) : dummy->measure());
     case ElementType::MEASURE_REPEAT:    return new MeasureRepeat(parent->isSegment() ? toSegment(parent) : dummy->segment());
     case ElementType::ACTION_ICON:       return new ActionIcon(parent);
-    case ElementType::NOTE:              return new Note(parent->isChord() ? toChord(parent) : dummy->chord());
+    case ElementType::NOTE:              return new (allocator) Note(parent->isChord() ? toChord(parent) : dummy->chord());
     case ElementType::SYMBOL:            return new Symbol(parent);
     case ElementType::FSYMBOL:           return new FSymbol(parent);
-    case ElementType::CHORD:             return new Chord(parent->isSegment() ? toSegment(parent) : dummy->segment());
-    case ElementType::REST:              return new Rest(parent->isSegment() ? toSegment(parent) : dummy->segment());
+    case ElementType::CHORD:             return new (allocator) Chord(parent->isSegment() ? toSegment(parent) : dummy->segment());
+    case ElementType::REST:              return new (allocator) Rest(parent->isSegment() ? toSegment(parent) : dummy->segment());
     case ElementType::MMREST:            return new MMRest(parent->isSegment() ? toSegment(parent) : dummy->segment());
     case ElementType::SPACER:            return new Spacer(parent->isMeasure() ? toMeasure(parent) : dummy->measure());
     case ElementType::STAFF_STATE:       return new StaffState(parent);
@@ -307,11 +322,11 @@ EngravingItem* Factory::doCreateItem(ElementType type, EngravingItem* parent)
     case ElementType::FRET_DIAGRAM:      return new FretDiagram(parent->isSegment() ? toSegment(parent) : dummy->segment());
     case ElementType::BEND:              return new Bend(parent->isNote() ? toNote(parent) : dummy->note());
     case ElementType::TREMOLOBAR:        return new TremoloBar(parent);
-    case ElementType::LYRICS:            return new Lyrics(parent->isChordRest() ? toChordRest(parent) : dummy->chord());
+    case ElementType::LYRICS:            return new (allocator) Lyrics(parent->isChordRest() ? toChordRest(parent) : dummy->chord());
     case ElementType::FIGURED_BASS:      return new FiguredBass(parent->isSegment() ? toSegment(parent) : dummy->segment());
-    case ElementType::STEM:              return new Stem(parent->isChord() ? toChord(parent) : dummy->chord());
+    case ElementType::STEM:              return new (allocator) Stem(parent->isChord() ? toChord(parent) : dummy->chord());
     case ElementType::SLUR:              return new Slur(parent);
-    case ElementType::TIE:               return new Tie(parent);
+    case ElementType::TIE:               return new (allocator) Tie(parent);
     case ElementType::TUPLET:            return new Tuplet(parent->isMeasure() ? toMeasure(parent) : dummy->measure());
     case ElementType::FINGERING:         return new Fingering(parent->isNote() ? toNote(parent) : dummy->note());
     case ElementType::HBOX:              return new HBox(parent->isSystem() ? toSystem(parent) : dummy->system());
@@ -427,6 +442,13 @@ const char* Factory::userName(Ms::ElementType type)
         return copy; \
     } \
 
+#define COPY_POOLED_ITEM_IMPL(T) \
+    T* Factory::copy##T(const T& src) \
+    { \
+        T* copy = new (itemAllocator(&src)) T(src); \
+        return copy; \
+    } \
+
 CREATE_ITEM_IMPL(Accidental, ElementType::ACCIDENTAL, EngravingItem, isAccessibleEnabled)
 MAKE_ITEM_IMPL(Accidental, EngravingItem)
 
@@ -440,12 +462,12 @@ CREATE_ITEM_IMPL(Articulation, ElementType::ARTICULATION, ChordRest, isAccessibl
 MAKE_ITEM_IMPL(Articulation, ChordRest)
 
 CREATE_ITEM_IMPL(BarLine, ElementType::BAR_LINE, Segment, isAccessibleEnabled)
-COPY_ITEM_IMPL(BarLine)
+COPY_POOLED_ITEM_IMPL(BarLine)
 MAKE_ITEM_IMPL(BarLine, Segment)
 
 Beam* Factory::createBeam(System * parent, bool isAccessibleEnabled)
 {
-    Beam* b = new Beam(parent);
+    Beam* b = new (itemAllocator(parent)) Beam(parent);
     b->setAccessibleEnabled(isAccessibleEnabled);
 
     return b;
@@ -481,7 +503,7 @@ CREATE_ITEM_IMPL(Chord, ElementType::CHORD, Segment, isAccessibleEnabled)
 
 Ms::Chord* Factory::copyChord(const Ms::Chord& src, bool link)
 {
-    Chord* copy = new Chord(src, link);
+    Chord* copy = new (itemAllocator(&src)) Chord(src, link);
     copy->setAccessibleEnabled(src.accessibleEnabled());
 
     return copy;
@@ -515,7 +537,7 @@ COPY_ITEM_IMPL(LayoutBreak)
 MAKE_ITEM_IMPL(LayoutBreak, MeasureBase)
 
 CREATE_ITEM_IMPL(Lyrics, ElementType::LYRICS, ChordRest, isAccessibleEnabled)
-COPY_ITEM_IMPL(Lyrics)
+COPY_POOLED_ITEM_IMPL(Lyrics)
 
 CREATE_ITEM_IMPL(Measure, ElementType::MEASURE, System, isAccessibleEnabled)
 COPY_ITEM_IMPL(Measure)
@@ -526,7 +548,7 @@ COPY_ITEM_IMPL(MeasureRepeat)
 CREATE_ITEM_IMPL(Note, ElementType::NOTE, Chord, isAccessibleEnabled)
 Note* Factory::copyNote(const Note& src, bool link)
 {
-    Note* copy = new Note(src, link);
+    Note* copy = new (itemAllocator(&src)) Note(src, link);
     copy->setAccessibleEnabled(src.accessibleEnabled());
 
     return copy;
@@ -535,7 +557,7 @@ MAKE_ITEM_IMPL(Note, Chord)
 
 CREATE_ITEM_IMPL(NoteDot, ElementType::NOTEDOT, Note, isAccessibleEnabled)
 CREATE_ITEM_IMPL(NoteDot, ElementType::NOTEDOT, Rest, isAccessibleEnabled)
-COPY_ITEM_IMPL(NoteDot)
+COPY_POOLED_ITEM_IMPL(NoteDot)
 
 Ms::Page* Factory::createPage(RootItem * parent, bool isAccessibleEnabled)
 {
@@ -547,7 +569,7 @@ Ms::Page* Factory::createPage(RootItem * parent, bool isAccessibleEnabled)
 
 Ms::Rest* Factory::createRest(Ms::Segment* parent, bool isAccessibleEnabled)
 {
-    Rest* r = new Rest(parent);
+    Rest* r = new (itemAllocator(parent)) Rest(parent);
     r->setAccessibleEnabled(isAccessibleEnabled);
 
     return r;
@@ -555,7 +577,7 @@ Ms::Rest* Factory::createRest(Ms::Segment* parent, bool isAccessibleEnabled)
 
 Ms::Rest* Factory::createRest(Ms::Segment* parent, const Ms::TDuration& t, bool isAccessibleEnabled)
 {
-    Rest* r = new Rest(parent, t);
+    Rest* r = new (itemAllocator(parent)) Rest(parent, t);
     r->setAccessibleEnabled(isAccessibleEnabled);
 
     return r;
@@ -563,7 +585,7 @@ Ms::Rest* Factory::createRest(Ms::Segment* parent, const Ms::TDuration& t, bool
 
 Ms::Rest* Factory::copyRest(const Ms::Rest& src, bool link)
 {
-    Rest* copy = new Rest(src, link);
+    Rest* copy = new (itemAllocator(&src)) Rest(src, link);
     copy->setAccessibleEnabled(src.accessibleEnabled());
 
     return copy;
@@ -571,7 +593,7 @@ Ms::Rest* Factory::copyRest(const Ms::Rest& src, bool link)
 
 Ms::Segment* Factory::createSegment(Ms::Measure* parent, bool isAccessibleEnabled)
 {
-    Segment* s = new Segment(parent);
+    Segment* s = new (itemAllocator(parent)) Segment(parent);
     s->setAccessibleEnabled(isAccessibleEnabled);
 
     return s;
@@ -579,7 +601,7 @@ Ms::Segment* Factory::createSegment(Ms::Measure* parent, bool isAccessibleEnable
 
 Ms::Segment* Factory::createSegment(Ms::Measure* parent, Ms::SegmentType type, const Ms::Fraction& t, bool isAccessibleEnabled)
 {
-    Segment* s = new Segment(parent, type, t);
+    Segment* s = new (itemAllocator(parent)) Segment(parent, type, t);
     s->setAccessibleEnabled(isAccessibleEnabled);
 
     return s;
@@ -604,13 +626,13 @@ Staff* Factory::createStaff(Part * parent)
 
 StaffLines* Factory::createStaffLines(Measure* parent, bool isAccessibleEnabled)
 {
-    StaffLines* sl = new StaffLines(parent);
+    StaffLines* sl = new (itemAllocator(parent)) StaffLines(parent);
     sl->setAccessibleEnabled(isAccessibleEnabled);
 
     return sl;
 }
 
-COPY_ITEM_IMPL(StaffLines)
+COPY_POOLED_ITEM_IMPL(StaffLines)
 
 CREATE_ITEM_IMPL(StaffState, ElementType::STAFF_STATE, EngravingItem, isAccessibleEnabled)
 
@@ -628,7 +650,7 @@ StaffText* Factory::createStaffText(Segment * parent, Ms::TextStyleType textStyl
 CREATE_ITEM_IMPL(RehearsalMark, ElementType::REHEARSAL_MARK, Segment, isAccessibleEnabled)
 
 CREATE_ITEM_IMPL(Stem, ElementType::STEM, Chord, isAccessibleEnabled)
-COPY_ITEM_IMPL(Stem)
+COPY_POOLED_ITEM_IMPL(Stem)
 
 Ms::StemSlash* Factory::createStemSlash(Ms::Chord * parent, bool isAccessibleEnabled)
 {
@@ -693,7 +715,7 @@ Ms::Text* Factory::createText(Ms::EngravingItem * parent, TextStyleType tid, boo
 COPY_ITEM_IMPL(Text)
 
 CREATE_ITEM_IMPL(Tie, ElementType::TIE, EngravingItem, isAccessibleEnabled)
-COPY_ITEM_IMPL(Tie)
+COPY_POOLED_ITEM_IMPL(Tie)
 
 CREATE_ITEM_IMPL(TimeSig, ElementType::TIMESIG, Segment, isAccessibleEnabled)
 COPY_ITEM_IMPL(TimeSig)
@@ -129,6 +129,7 @@ public:
     ~Harmony();
 
     KerningType doComputeKerningType(const EngravingItem* nextItem) const override;
+    bool limitsKerningWithNext() const override { return true; }
 
     Harmony* clone() const override { return new Harmony(*this); }
 
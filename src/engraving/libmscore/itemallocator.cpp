@@ -0,0 +1,306 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "itemallocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "log.h"
+
+using namespace mu::engraving;
+
+static constexpr size_t SIZE_CLASS_STEP = 64;
+static constexpr size_t MAX_POOLED_SIZE = 4096;
+static constexpr size_t SIZE_CLASS_COUNT = MAX_POOLED_SIZE / SIZE_CLASS_STEP;
+
+//! NOTE The chunks are aligned to their size, so the chunk of a block is found by masking the address of the block
+static constexpr size_t CHUNK_SIZE = 64 * 1024;
+static constexpr uintptr_t CHUNK_MASK = ~(static_cast<uintptr_t>(CHUNK_SIZE) - 1);
+
+//! NOTE The header takes the place of the first block step, so the blocks stay aligned
+static constexpr size_t CHUNK_HEADER_SIZE = SIZE_CLASS_STEP;
+
+//! NOTE The addresses of all the chunks, an open addressing set which is read without locking.
+//! The removed slots are reused by the next chunks, the set is kept at most half full
+static constexpr size_t REGISTRY_SIZE = 32 * 1024;
+static constexpr uintptr_t EMPTY_SLOT = 0;
+static constexpr uintptr_t REMOVED_SLOT = 1;
+
+static std::atomic<uintptr_t> s_chunkRegistry[REGISTRY_SIZE];
+static std::atomic<size_t> s_chunksCount { 0 };
+
+static size_t registrySlot(uintptr_t chunk)
+{
+    return static_cast<size_t>((chunk / CHUNK_SIZE) * 2654435761u) & (REGISTRY_SIZE - 1);
+}
+
+static bool registerChunk(uintptr_t chunk)
+{
+    if (s_chunksCount.load(std::memory_order_relaxed) >= REGISTRY_SIZE / 2) {
+        return false;
+    }
+
+    size_t idx = registrySlot(chunk);
+    for (size_t i = 0; i < REGISTRY_SIZE; ++i, idx = (idx + 1) & (REGISTRY_SIZE - 1)) {
+        uintptr_t value = s_chunkRegistry[idx].load(std::memory_order_relaxed);
+        if (value != EMPTY_SLOT && value != REMOVED_SLOT) {
+            continue;
+        }
+
+        if (s_chunkRegistry[idx].compare_exchange_strong(value, chunk, std::memory_order_release, std::memory_order_relaxed)) {
+            s_chunksCount.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void unregisterChunk(uintptr_t chunk)
+{
+    size_t idx = registrySlot(chunk);
+    for (size_t i = 0; i < REGISTRY_SIZE; ++i, idx = (idx + 1) & (REGISTRY_SIZE - 1)) {
+        uintptr_t value = s_chunkRegistry[idx].load(std::memory_order_relaxed);
+        if (value == chunk) {
+            s_chunkRegistry[idx].store(REMOVED_SLOT, std::memory_order_release);
+            s_chunksCount.fetch_sub(1, std::memory_order_relaxed);
+            return;
+        }
+
+        if (value == EMPTY_SLOT) {
+            return;
+        }
+    }
+}
+
+struct FreeBlock {
+    FreeBlock* next = nullptr;
+};
+
+struct ChunkHeader {
+    void* pool = nullptr;
+    size_t sizeClass = 0;
+};
+
+static ChunkHeader* findChunk(const void* ptr)
+{
+    //! NOTE Nothing to look for if the allocator isn't used
+    if (s_chunksCount.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+
+    uintptr_t chunk = reinterpret_cast<uintptr_t>(ptr) & CHUNK_MASK;
+
+    size_t idx = registrySlot(chunk);
+    for (size_t i = 0; i < REGISTRY_SIZE; ++i, idx = (idx + 1) & (REGISTRY_SIZE - 1)) {
+        uintptr_t value = s_chunkRegistry[idx].load(std::memory_order_acquire);
+        if (value == chunk) {
+            return reinterpret_cast<ChunkHeader*>(chunk);
+        }
+
+        if (value == EMPTY_SLOT) {
+            return nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
+struct ItemAllocator::Pool {
+    const std::thread::id ownerThread = std::this_thread::get_id();
+
+    //! NOTE Used on the owner thread only
+    std::vector<uintptr_t> chunks;
+    FreeBlock* freeBlocks[SIZE_CLASS_COUNT] = { nullptr };
+    size_t allocations = 0;
+    size_t peakUsedBlocks = 0;
+
+    //! NOTE The blocks freed on the other threads, the owner thread takes them back all at once
+    std::atomic<FreeBlock*> remoteFreeBlocks[SIZE_CLASS_COUNT] = {};
+
+    std::atomic<size_t> usedBlocks { 0 };
+    std::atomic<size_t> heapAllocations { 0 };
+
+    //! NOTE The allocator itself and every used block
+    std::atomic<size_t> refs { 1 };
+
+    ~Pool()
+    {
+        for (uintptr_t chunk : chunks) {
+            unregisterChunk(chunk);
+            ::operator delete(reinterpret_cast<void*>(chunk), std::align_val_t(CHUNK_SIZE));
+        }
+    }
+
+    static size_t blockSize(size_t sizeClass)
+    {
+        return (sizeClass + 1) * SIZE_CLASS_STEP;
+    }
+
+    void* takeBlock(size_t sizeClass)
+    {
+        FreeBlock* block = freeBlocks[sizeClass];
+        if (!block) {
+            block = remoteFreeBlocks[sizeClass].exchange(nullptr, std::memory_order_acquire);
+        }
+
+        if (block) {
+            freeBlocks[sizeClass] = block->next;
+            return block;
+        }
+
+        void* memory = ::operator new(CHUNK_SIZE, std::align_val_t(CHUNK_SIZE), std::nothrow);
+        if (!memory) {
+            return nullptr;
+        }
+
+        uintptr_t chunk = reinterpret_cast<uintptr_t>(memory);
+        if (!registerChunk(chunk)) {
+            ::operator delete(memory, std::align_val_t(CHUNK_SIZE));
+            return nullptr;
+        }
+
+        ChunkHeader* header = new (memory) ChunkHeader();
+        header->pool = this;
+        header->sizeClass = sizeClass;
+
+        chunks.push_back(chunk);
+
+        //! NOTE The first block is returned, the rest ones are put to the free list
+        size_t size = blockSize(sizeClass);
+        size_t count = (CHUNK_SIZE - CHUNK_HEADER_SIZE) / size;
+        uint8_t* blocks = static_cast<uint8_t*>(memory) + CHUNK_HEADER_SIZE;
+
+        for (size_t i = count - 1; i > 0; --i) {
+            FreeBlock* freeBlock = new (blocks + i * size) FreeBlock();
+            freeBlock->next = freeBlocks[sizeClass];
+            freeBlocks[sizeClass] = freeBlock;
+        }
+
+        return blocks;
+    }
+
+    void putBlock(void* ptr, size_t sizeClass)
+    {
+        FreeBlock* block = new (ptr) FreeBlock();
+
+        if (std::this_thread::get_id() == ownerThread) {
+            block->next = freeBlocks[sizeClass];
+            freeBlocks[sizeClass] = block;
+            return;
+        }
+
+        FreeBlock* head = remoteFreeBlocks[sizeClass].load(std::memory_order_relaxed);
+        do {
+            block->next = head;
+        } while (!remoteFreeBlocks[sizeClass].compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void release()
+    {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+};
+
+ItemAllocator::ItemAllocator()
+    : m_pool(new Pool())
+{
+}
+
+ItemAllocator::~ItemAllocator()
+{
+    m_pool->release();
+}
+
+void* ItemAllocator::allocate(size_t size)
+{
+    //! NOTE The other threads take the memory from the heap, so the pool is never locked
+    bool canPool = size > 0 && size <= MAX_POOLED_SIZE && std::this_thread::get_id() == m_pool->ownerThread;
+
+    void* block = canPool ? m_pool->takeBlock((size - 1) / SIZE_CLASS_STEP) : nullptr;
+    if (!block) {
+        m_pool->heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    m_pool->refs.fetch_add(1, std::memory_order_relaxed);
+
+    size_t usedBlocks = m_pool->usedBlocks.fetch_add(1, std::memory_order_relaxed) + 1;
+    m_pool->allocations++;
+    m_pool->peakUsedBlocks = std::max(m_pool->peakUsedBlocks, usedBlocks);
+
+    return block;
+}
+
+void ItemAllocator::deallocate(void* ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    ChunkHeader* chunk = findChunk(ptr);
+    if (!chunk) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    Pool* pool = static_cast<Pool*>(chunk->pool);
+    pool->putBlock(ptr, chunk->sizeClass);
+    pool->usedBlocks.fetch_sub(1, std::memory_order_relaxed);
+    pool->release();
+}
+
+bool ItemAllocator::isPooled(const void* ptr)
+{
+    return ptr && findChunk(ptr) != nullptr;
+}
+
+ItemAllocator::Stats ItemAllocator::stats() const
+{
+    Stats s;
+    s.chunks = m_pool->chunks.size();
+    s.reservedBytes = s.chunks * CHUNK_SIZE;
+    s.usedBlocks = m_pool->usedBlocks.load(std::memory_order_relaxed);
+    s.peakUsedBlocks = m_pool->peakUsedBlocks;
+    s.allocations = m_pool->allocations;
+    s.heapAllocations = m_pool->heapAllocations.load(std::memory_order_relaxed);
+
+    return s;
+}
+
+void ItemAllocator::dump() const
+{
+    Stats s = stats();
+
+    LOGD() << "chunks: " << s.chunks
+           << ", reserved: " << s.reservedBytes / 1024 << " KB"
+           << ", used blocks: " << s.usedBlocks
+           << ", peak used blocks: " << s.peakUsedBlocks
+           << ", allocations: " << s.allocations
+           << ", heap allocations: " << s.heapAllocations;
+}
@@ -0,0 +1,75 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_ITEMALLOCATOR_H
+#define MU_ENGRAVING_ITEMALLOCATOR_H
+
+#include <cstddef>
+
+namespace mu::engraving {
+//! NOTE The allocator of the score items with a lot of instances (notes, chords, segments, etc.)
+//! The memory is taken from large chunks split into the blocks of a few size classes,
+//! the freed blocks are reused for the next items of the same size class.
+//! All the chunks are released at once, when the allocator is destroyed and the last item allocated by it is deleted,
+//! so the items may safely outlive the allocator (for example, the items still referenced by the undo stack)
+//!
+//! The blocks don't carry any header: the chunks are aligned to their size and registered,
+//! so deallocate finds the chunk of a block by its address. The other memory is passed to the global operator delete as is.
+//! The allocator isn't locked: the blocks are taken on the thread which created the allocator only
+//! (the other threads get the memory from the heap), the blocks freed on the other threads are returned lock-free
+class ItemAllocator
+{
+public:
+    ItemAllocator();
+    ~ItemAllocator();
+
+    ItemAllocator(const ItemAllocator&) = delete;
+    ItemAllocator& operator=(const ItemAllocator&) = delete;
+
+    struct Stats {
+        size_t chunks = 0;
+        size_t reservedBytes = 0;
+        size_t usedBlocks = 0;
+        size_t peakUsedBlocks = 0;
+        size_t allocations = 0;
+        size_t heapAllocations = 0;
+    };
+
+    void* allocate(size_t size);
+
+    //! NOTE Releases the memory allocated by any allocator or by the global operator new
+    static void deallocate(void* ptr);
+
+    //! NOTE Whether the memory is a block of some allocator
+    static bool isPooled(const void* ptr);
+
+    //! NOTE Should be called on the thread which created the allocator
+    Stats stats() const;
+    void dump() const;
+
+private:
+    struct Pool;
+
+    Pool* m_pool = nullptr;
+};
+}
+
+#endif // MU_ENGRAVING_ITEMALLOCATOR_H
@@ -128,6 +128,8 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/instrument.h
     ${CMAKE_CURRENT_LIST_DIR}/interval.cpp
     ${CMAKE_CURRENT_LIST_DIR}/interval.h
+    ${CMAKE_CURRENT_LIST_DIR}/itemallocator.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/itemallocator.h
     ${CMAKE_CURRENT_LIST_DIR}/joinMeasure.cpp
     ${CMAKE_CURRENT_LIST_DIR}/jump.cpp
     ${CMAKE_CURRENT_LIST_DIR}/jump.h
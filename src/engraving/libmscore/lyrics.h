@@ -76,6 +76,7 @@ public:
     ~Lyrics();
 
     KerningType doComputeKerningType(const EngravingItem* nextItem) const override;
+    bool limitsKerningWithNext() const override { return true; }
 
     Lyrics* clone() const override { return new Lyrics(*this); }
     bool acceptDrop(EditData&) const override;
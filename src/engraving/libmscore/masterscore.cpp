@@ -60,6 +60,12 @@ MasterScore::MasterScore(std::weak_ptr<engraving::EngravingProject> project)
     : Score()
 {
     m_project = project;
+
+    //! NOTE The allocator is optional, the items are allocated on the heap without it
+    if (MScore::useItemAllocator) {
+        m_itemAllocator = std::make_unique<mu::engraving::ItemAllocator>();
+    }
+
     _undoStack   = new UndoStack();
     _tempomap    = new TempoMap;
     _sigmap      = new TimeSigMap();
@@ -114,6 +120,10 @@ MasterScore::~MasterScore()
     delete _tempomap;
     delete _undoStack;
     qDeleteAll(_excerpts);
+
+    if (m_itemAllocator) {
+        m_itemAllocator->dump();
+    }
 }
 
 //---------------------------------------------------------
@@ -548,6 +558,9 @@ void MasterScore::setSoloMute()
 void MasterScore::setUpdateAll()
 {
     _cmdState.setUpdateMode(UpdateMode::UpdateAll);
+    for (Score* s : scoreList()) {
+        s->addUpdateAll();
+    }
 }
 
 //---------------------------------------------------------
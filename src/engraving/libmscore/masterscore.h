@@ -26,6 +26,7 @@
 
 #include "score.h"
 #include "instrument.h"
+#include "itemallocator.h"
 
 namespace mu::engraving {
 class EngravingProject;
@@ -107,6 +108,8 @@ class MasterScore : public Score
 
     std::weak_ptr<mu::engraving::EngravingProject> m_project;
 
+    std::unique_ptr<mu::engraving::ItemAllocator> m_itemAllocator;
+
     // FIXME: Move to EngravingProject
     // We can't yet, because m_project is not set on every MasterScore
     IFileInfoProviderPtr m_fileInfoProvider;
@@ -147,6 +150,7 @@ public:
     bool readOnly() const override { return _readOnly; }
     void setReadOnly(bool ro) { _readOnly = ro; }
     UndoStack* undoStack() const override { return _undoStack; }
+    mu::engraving::ItemAllocator* itemAllocator() const { return m_itemAllocator.get(); }
     TimeSigMap* sigmap() const override { return _sigmap; }
     TempoMap* tempomap() const override { return _tempomap; }
 
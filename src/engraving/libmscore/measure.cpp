@@ -1003,7 +1003,7 @@ void Measure::add(EngravingItem* e)
         break;
 
     case ElementType::MEASURE:
-        m_mmRest = toMeasure(e);
+        setMMRest(toMeasure(e));
         break;
 
     case ElementType::STAFFTYPE_CHANGE:
@@ -1122,7 +1122,7 @@ void Measure::remove(EngravingItem* e)
         break;
 
     case ElementType::MEASURE:
-        m_mmRest = 0;
+        setMMRest(nullptr);
         break;
 
     case ElementType::STAFFTYPE_CHANGE:
@@ -2915,6 +2915,18 @@ PropertyValue Measure::propertyDefault(Pid propertyId) const
     return MeasureBase::propertyDefault(propertyId);
 }
 
+//---------------------------------------------------------
+//   setMMRest
+//---------------------------------------------------------
+
+void Measure::setMMRest(Measure* m)
+{
+    m_mmRest = m;
+    if (score()) {
+        score()->measures()->incRevision();
+    }
+}
+
 //-------------------------------------------------------------------
 //   mmRestFirst
 //    this is a multi measure rest
@@ -307,7 +307,7 @@ public:
     bool isMMRest() const { return m_mmRestCount > 0; }
     Measure* mmRest() const { return m_mmRest; }
     const Measure* mmRest1() const;
-    void setMMRest(Measure* m) { m_mmRest = m; }
+    void setMMRest(Measure* m);
     int mmRestCount() const { return m_mmRestCount; }            // number of measures m_mmRest spans
     void setMMRestCount(int n) { m_mmRestCount = n; }
     Measure* mmRestFirst() const;
@@ -356,6 +356,21 @@ public:
 
     qreal computeFirstSegmentXPosition(Segment* segment);
 
+    //! NOTE The lines and accidentals of the notes depend only on the content of the measure and on the staves
+    //! context at its start (clefs, keys, transposition), so they are not updated again while the measure stays
+    //! out of the edited range and the context is the same (see LayoutMeasure::getNextMeasure)
+    struct NotesLayoutKey {
+        int generation = -1;
+        Fraction tick = Fraction(-1, 1);
+        std::vector<int> context;
+
+        bool operator==(const NotesLayoutKey& k) const { return generation == k.generation && tick == k.tick && context == k.context; }
+    };
+
+    const NotesLayoutKey& notesLayoutKey() const { return m_notesLayoutKey; }
+    void setNotesLayoutKey(NotesLayoutKey key) { m_notesLayoutKey = std::move(key); }
+    void invalidateNotesLayout() { m_notesLayoutKey = NotesLayoutKey(); }
+
     void layoutSegmentsWithDuration(const std::vector<int>& visibleParts);
 
     void calculateQuantumCell(const std::vector<int>& visibleParts);
@@ -406,6 +421,8 @@ private:
 
     double m_layoutStretch = 1.0;
     bool _isWidthLocked = false;
+
+    NotesLayoutKey m_notesLayoutKey;
 };
 }     // namespace Ms
 #endif
@@ -348,6 +348,49 @@ Fraction MeasureBase::tick() const
     return mb ? mb->_tick : Fraction(-1, 1);
 }
 
+//---------------------------------------------------------
+//   setTick
+//---------------------------------------------------------
+
+void MeasureBase::setTick(const Fraction& f)
+{
+    _tick = f;
+    measuresChanged();
+}
+
+//---------------------------------------------------------
+//   setNext
+//---------------------------------------------------------
+
+void MeasureBase::setNext(MeasureBase* e)
+{
+    _next = e;
+    measuresChanged();
+}
+
+//---------------------------------------------------------
+//   setPrev
+//---------------------------------------------------------
+
+void MeasureBase::setPrev(MeasureBase* e)
+{
+    _prev = e;
+    measuresChanged();
+}
+
+//---------------------------------------------------------
+//   measuresChanged
+//    the tick index of the score is rebuilt on the next
+//    lookup
+//---------------------------------------------------------
+
+void MeasureBase::measuresChanged()
+{
+    if (score()) {
+        score()->measures()->incRevision();
+    }
+}
+
 //---------------------------------------------------------
 //   triggerLayout
 //---------------------------------------------------------
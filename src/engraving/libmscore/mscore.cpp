@@ -84,6 +84,8 @@ bool MScore::useFallbackFont     = true;
 
 bool MScore::saveTemplateMode = false;
 bool MScore::noGui = false;
+bool MScore::useItemAllocator = false;
+size_t MScore::undoHistoryMemoryLimit = 0;
 
 QString MScore::_globalShare;
 int MScore::_vRaster;
@@ -309,6 +309,8 @@ public:
 
     static bool saveTemplateMode;
     static bool noGui;
+    static bool useItemAllocator;
+    static size_t undoHistoryMemoryLimit;
 
     static bool noExcerpts;
     static bool noImages;
@@ -109,44 +109,72 @@ void Page::draw(mu::draw::Painter* painter) const
     // draw header/footer
     //
 
-    page_idx_t n = no() + 1 + score()->pageNumberOffset();
     painter->setPen(curColor());
 
-    QString s1, s2, s3;
+    for (int area = 0; area < MAX_HEADERS + MAX_FOOTERS; ++area) {
+        drawHeaderFooter(painter, area, headerFooterMacro(area));
+    }
+}
 
-    if (score()->styleB(Sid::showHeader) && (no() || score()->styleB(Sid::headerFirstPage))) {
-        bool odd = (n & 1) || !score()->styleB(Sid::headerOddEven);
-        if (odd) {
-            s1 = score()->styleSt(Sid::oddHeaderL);
-            s2 = score()->styleSt(Sid::oddHeaderC);
-            s3 = score()->styleSt(Sid::oddHeaderR);
-        } else {
-            s1 = score()->styleSt(Sid::evenHeaderL);
-            s2 = score()->styleSt(Sid::evenHeaderC);
-            s3 = score()->styleSt(Sid::evenHeaderR);
+//---------------------------------------------------------
+//   headerFooterMacro
+//    the style text of the header/footer area,
+//    empty if the area is not shown on this page
+//---------------------------------------------------------
+
+QString Page::headerFooterMacro(int area) const
+{
+    page_idx_t n = no() + 1 + score()->pageNumberOffset();
+
+    if (area < MAX_HEADERS) {
+        if (!score()->styleB(Sid::showHeader) || (!no() && !score()->styleB(Sid::headerFirstPage))) {
+            return QString();
         }
 
-        drawHeaderFooter(painter, 0, s1);
-        drawHeaderFooter(painter, 1, s2);
-        drawHeaderFooter(painter, 2, s3);
+        static const Sid oddHeaders[] = { Sid::oddHeaderL, Sid::oddHeaderC, Sid::oddHeaderR };
+        static const Sid evenHeaders[] = { Sid::evenHeaderL, Sid::evenHeaderC, Sid::evenHeaderR };
+        bool odd = (n & 1) || !score()->styleB(Sid::headerOddEven);
+        return score()->styleSt(odd ? oddHeaders[area] : evenHeaders[area]);
     }
 
-    if (score()->styleB(Sid::showFooter) && (no() || score()->styleB(Sid::footerFirstPage))) {
-        bool odd = (n & 1) || !score()->styleB(Sid::footerOddEven);
-        if (odd) {
-            s1 = score()->styleSt(Sid::oddFooterL);
-            s2 = score()->styleSt(Sid::oddFooterC);
-            s3 = score()->styleSt(Sid::oddFooterR);
-        } else {
-            s1 = score()->styleSt(Sid::evenFooterL);
-            s2 = score()->styleSt(Sid::evenFooterC);
-            s3 = score()->styleSt(Sid::evenFooterR);
+    if (!score()->styleB(Sid::showFooter) || (!no() && !score()->styleB(Sid::footerFirstPage))) {
+        return QString();
+    }
+
+    static const Sid oddFooters[] = { Sid::oddFooterL, Sid::oddFooterC, Sid::oddFooterR };
+    static const Sid evenFooters[] = { Sid::evenFooterL, Sid::evenFooterC, Sid::evenFooterR };
+    bool odd = (n & 1) || !score()->styleB(Sid::footerOddEven);
+    return score()->styleSt(odd ? oddFooters[area - MAX_HEADERS] : evenFooters[area - MAX_HEADERS]);
+}
+
+//---------------------------------------------------------
+//   cloneHeaderFooterTexts
+//    lays out the header/footer texts of the page and
+//    returns their copies, which can be drawn without the
+//    texts shared by the pages of the score
+//    (ex. when the pages are painted in parallel).
+//    The caller takes the ownership of the copies
+//---------------------------------------------------------
+
+std::vector<Text*> Page::cloneHeaderFooterTexts() const
+{
+    std::vector<Text*> result;
+    if (!score()->isLayoutMode(LayoutMode::PAGE)) {
+        return result;
+    }
+
+    for (int area = 0; area < MAX_HEADERS + MAX_FOOTERS; ++area) {
+        Text* text = layoutHeaderFooter(area, headerFooterMacro(area));
+        if (!text) {
+            continue;
         }
 
-        drawHeaderFooter(painter, 3, s1);
-        drawHeaderFooter(painter, 4, s2);
-        drawHeaderFooter(painter, 5, s3);
+        Text* copy = text->clone();
+        result.push_back(copy);
+        text->resetExplicitParent();
     }
+
+    return result;
 }
 
 //---------------------------------------------------------
@@ -329,6 +357,11 @@ static void bspInsert(void* bspTree, EngravingItem* e)
     ((BspTree*)bspTree)->insert(e);
 }
 
+static void bspUpdate(void* bspTree, EngravingItem* e)
+{
+    ((BspTree*)bspTree)->update(e);
+}
+
 static void countElements(void* data, EngravingItem* /*e*/)
 {
     ++(*(int*)data);
@@ -340,9 +373,6 @@ static void countElements(void* data, EngravingItem* /*e*/)
 
 void Page::doRebuildBspTree()
 {
-    int n = 0;
-    scanElements(&n, countElements, false);
-
     RectF r;
     if (score()->linearMode()) {
         qreal w = 0.0;
@@ -359,8 +389,19 @@ void Page::doRebuildBspTree()
         r = abbox();
     }
 
-    bspTree.initialize(r, n);
-    scanElements(&bspTree, &bspInsert, false);
+    if (bspTree.needsRebuild(r)) {
+        int n = 0;
+        scanElements(&n, countElements, false);
+
+        bspTree.initialize(r, n);
+        scanElements(&bspTree, &bspInsert, false);
+    } else {
+        // only the elements which moved since the last layout are reindexed
+        bspTree.beginUpdate();
+        scanElements(&bspTree, &bspUpdate, false);
+        bspTree.endUpdate();
+    }
+
     bspTreeValid = true;
 }
 
@@ -61,6 +61,7 @@ class Page final : public EngravingItem
     Page(mu::engraving::RootItem* parent);
 
     QString replaceTextMacros(const QString&) const;
+    QString headerFooterMacro(int area) const;
     void drawHeaderFooter(mu::draw::Painter*, int area, const QString&) const;
     Text* layoutHeaderFooter(int area, const QString& ss) const;
 
@@ -91,6 +92,7 @@ public:
     qreal footerExtension() const;
 
     void draw(mu::draw::Painter*) const override;
+    std::vector<Text*> cloneHeaderFooterTexts() const;
     void scanElements(void* data, void (* func)(void*, EngravingItem*), bool all=true) override;
 
     std::vector<EngravingItem*> items(const mu::RectF& r);
@@ -27,8 +27,11 @@
 
 #include "rendermidi.h"
 
-#include <set>
+#include <atomic>
 #include <cmath>
+#include <queue>
+#include <set>
+#include <thread>
 
 #include "style/style.h"
 #include "compat/midi/event.h"
@@ -275,7 +278,7 @@ bool isGlissandoFor(const Note* note)
 //---------------------------------------------------------
 //   playNote
 //---------------------------------------------------------
-static void playNote(EventMap* events, const Note* note, int channel, int pitch,
+static void playNote(EventsBuffer* events, const Note* note, int channel, int pitch,
                      int velo, int onTime, int offTime, int staffIdx)
 {
     if (!note->play()) {
@@ -334,7 +337,7 @@ static void playNote(EventMap* events, const Note* note, int channel, int pitch,
 //   collectNote
 //---------------------------------------------------------
 
-static void collectNote(EventMap* events, int channel, const Note* note, qreal velocityMultiplier, int tickOffset, Staff* staff,
+static void collectNote(EventsBuffer* events, int channel, const Note* note, qreal velocityMultiplier, int tickOffset, Staff* staff,
                         SndConfig config)
 {
     if (!note->play() || note->hidden()) {      // do not play overlapping notes
@@ -557,7 +560,7 @@ static void collectNote(EventMap* events, int channel, const Note* note, qreal v
 //   aeolusSetStop
 //---------------------------------------------------------
 
-static void aeolusSetStop(int tick, int channel, int i, int k, bool val, EventMap* events)
+static void aeolusSetStop(int tick, int channel, int i, int k, bool val, EventsBuffer* events)
 {
     NPlayEvent event;
     event.setType(ME_CONTROLLER);
@@ -581,7 +584,7 @@ static void aeolusSetStop(int tick, int channel, int i, int k, bool val, EventMa
 //   collectProgramChanges
 //---------------------------------------------------------
 
-static void collectProgramChanges(EventMap* events, Measure const* m, Staff* staff, int tickOffset)
+static void collectProgramChanges(EventsBuffer* events, Measure const* m, Staff* staff, int tickOffset)
 {
     int firstStaffIdx = static_cast<int>(staff->idx());
     int nextStaffIdx  = firstStaffIdx + 1;
@@ -666,7 +669,7 @@ static int getControllerFromCC(int cc)
 //    renderHarmony
 ///    renders chord symbols
 //---------------------------------------------------------
-static void renderHarmony(EventMap* events, Measure const* m, Harmony* h, int tickOffset)
+static void renderHarmony(EventsBuffer* events, Measure const* m, Harmony* h, int tickOffset)
 {
     if (!h->isRealizable()) {
         return;
@@ -713,7 +716,7 @@ static void renderHarmony(EventMap* events, Measure const* m, Harmony* h, int ti
 //    the original, velocity-only method of collecting events.
 //---------------------------------------------------------
 
-void MidiRenderer::collectMeasureEventsSimple(EventMap* events, Measure const* m, const StaffContext& sctx, int tickOffset)
+void MidiRenderer::collectMeasureEventsSimple(EventsBuffer* events, Measure const* m, const StaffContext& sctx, int tickOffset)
 {
     staff_idx_t firstStaffIdx = sctx.staff->idx();
     staff_idx_t nextStaffIdx  = firstStaffIdx + 1;
@@ -803,7 +806,7 @@ void MidiRenderer::collectMeasureEventsSimple(EventMap* events, Measure const* m
 //          SEG_START - note-on velocity is the same as the start velocity of the seg
 //---------------------------------------------------------
 
-void MidiRenderer::collectMeasureEventsDefault(EventMap* events, Measure const* m, const StaffContext& sctx, int tickOffset)
+void MidiRenderer::collectMeasureEventsDefault(EventsBuffer* events, Measure const* m, const StaffContext& sctx, int tickOffset)
 {
     int controller = getControllerFromCC(sctx.cc);
 
@@ -914,7 +917,7 @@ MidiRenderer::MidiRenderer(Score* s)
 //    redirects to the correct function based on the passed method
 //---------------------------------------------------------
 
-void MidiRenderer::collectMeasureEvents(EventMap* events, Measure const* m, const StaffContext& sctx, int tickOffset)
+void MidiRenderer::collectMeasureEvents(EventsBuffer* events, Measure const* m, const StaffContext& sctx, int tickOffset)
 {
     switch (sctx.method) {
     case DynamicsRenderMethod::SIMPLE:
@@ -1118,11 +1121,68 @@ void Score::updateVelo()
     }
 }
 
+//---------------------------------------------------------
+//   sortEvents
+///   Sorts the events by tick, the events with the same tick
+///   stay in the order they were added, as in EventMap
+//---------------------------------------------------------
+
+static bool eventTickLess(const std::pair<int, NPlayEvent>& e1, const std::pair<int, NPlayEvent>& e2)
+{
+    return e1.first < e2.first;
+}
+
+static void sortEvents(EventsBuffer& events)
+{
+    std::stable_sort(events.begin(), events.end(), eventTickLess);
+}
+
+//---------------------------------------------------------
+//   mergeEvents
+///   k-way merge of the sorted buffers into the map.
+///   The events with the same tick are added in the order of the buffers,
+///   so the result is the same as adding the buffers one by one
+//---------------------------------------------------------
+
+static void mergeEvents(const std::vector<EventsBuffer>& buffers, EventMap* events)
+{
+    using Cursor = std::pair<size_t /*buffer*/, size_t /*position*/>;
+
+    auto cursorGreater = [&buffers](const Cursor& c1, const Cursor& c2) {
+        int tick1 = buffers[c1.first][c1.second].first;
+        int tick2 = buffers[c2.first][c2.second].first;
+        return tick1 != tick2 ? tick1 > tick2 : c1.first > c2.first;
+    };
+
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(cursorGreater)> queue(cursorGreater);
+
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        events->registerChannel(buffers[i].highestChannel());
+
+        if (!buffers[i].empty()) {
+            queue.push({ i, 0 });
+        }
+    }
+
+    while (!queue.empty()) {
+        Cursor cursor = queue.top();
+        queue.pop();
+
+        const EventsBuffer& buffer = buffers[cursor.first];
+        // the hint puts the event after the events with the same tick
+        events->insert(events->end(), buffer[cursor.second]);
+
+        if (++cursor.second < buffer.size()) {
+            queue.push(cursor);
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   renderStaffChunk
 //---------------------------------------------------------
 
-void MidiRenderer::renderStaffChunk(const Chunk& chunk, EventMap* events, const StaffContext& sctx)
+void MidiRenderer::renderStaffChunk(const Chunk& chunk, EventsBuffer* events, const StaffContext& sctx)
 {
     Measure const* const start = chunk.startMeasure();
     Measure const* const end = chunk.endMeasure();
@@ -2044,8 +2104,10 @@ void renderGlissando(NoteEventList* events, Note* notestart)
 
 Trill* findFirstTrill(Chord* chord)
 {
-    auto spanners = chord->score()->spannerMap().findOverlapping(1 + chord->tick().ticks(),
-                                                                 chord->tick().ticks() + chord->actualTicks().ticks() - 1);
+    // the staves are rendered in parallel, so the results are not kept in the spanner map
+    std::vector<interval_tree::Interval<Spanner*> > spanners;
+    chord->score()->spannerMap().findOverlapping(1 + chord->tick().ticks(),
+                                                 chord->tick().ticks() + chord->actualTicks().ticks() - 1, spanners);
     for (auto i : spanners) {
         if (i.value->type() != ElementType::TRILL) {
             continue;
@@ -2460,6 +2522,7 @@ void Score::renderMidi(EventMap* events, bool metronome, bool expandRepeats, con
     ctx.synthState = synthState;
     ctx.metronome = metronome;
     ctx.renderHarmony = true;
+    ctx.parallel = true;
     MidiRenderer(this).renderScore(events, ctx);
     masterScore()->setExpandRepeats(expandRepeatsBackup);
 }
@@ -2467,6 +2530,12 @@ void Score::renderMidi(EventMap* events, bool metronome, bool expandRepeats, con
 void MidiRenderer::renderScore(EventMap* events, const Context& ctx)
 {
     updateState();
+
+    if (ctx.parallel) {
+        renderScoreParallel(events, ctx);
+        return;
+    }
+
     for (const Chunk& chunk : chunks) {
         renderChunk(chunk, events, ctx);
     }
@@ -2480,49 +2549,105 @@ void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Conte
     score->updateChannel();
     score->updateVelo();
 
-    SynthesizerState s = score->synthesizerState();
-    int method = s.method();
-    int cc = s.ccToUse();
+    StaffContext sctx = staffContext(ctx);
 
-    // check if the score synth settings are actually set
-    // if not, use the global synth state
-    if (method == -1) {
-        method = ctx.synthState.method();
-        cc = ctx.synthState.ccToUse();
+    // create note & other events
+    std::vector<EventsBuffer> staffEvents(score->nstaves());
+    for (size_t staffIdx = 0; staffIdx < staffEvents.size(); ++staffIdx) {
+        sctx.staff = score->staff(staffIdx);
+        renderStaffChunk(chunk, &staffEvents[staffIdx], sctx);
+    }
 
-        if (method == -1) {
-            // fall back to defaults - this may be needed to pass tests,
-            // since sometimes the synth state is not init
-            method = 1;
-            cc = 2;
+    finishChunk(chunk, events, staffEvents, ctx);
+}
+
+//---------------------------------------------------------
+//   renderScoreParallel
+///   The same as rendering the chunks one by one,
+///   but the score state is updated once for the whole score
+///   and the staves are rendered on the worker threads.
+///   Every staff is rendered by one thread (all its chunks),
+///   so the velocity maps and the realized harmonies of a staff
+///   are never updated concurrently. The state shared by the staves
+///   (ex. the spanner map) is only read by the workers.
+//---------------------------------------------------------
+
+void MidiRenderer::renderScoreParallel(EventMap* events, const Context& ctx)
+{
+    TRACEFUNC;
+
+    score->createPlayEvents(nullptr, nullptr);
+
+    score->updateChannel();
+    score->updateVelo();
+
+    for (Staff* staff : score->staves()) {
+        staff->velocities().cleanup();
+        staff->velocityMultiplications().cleanup();
+    }
+
+    // the workers look up the trills, but don't rebuild the lookup tree
+    score->spannerMap().update();
+
+    const StaffContext baseContext = staffContext(ctx);
+    const size_t stavesCount = score->nstaves();
+
+    std::vector<std::vector<EventsBuffer> > chunksEvents(chunks.size(), std::vector<EventsBuffer>(stavesCount));
+    std::atomic<size_t> nextStaff { 0 };
+
+    auto renderStaves = [&]() {
+        for (size_t staffIdx = nextStaff++; staffIdx < stavesCount; staffIdx = nextStaff++) {
+            StaffContext sctx = baseContext;
+            sctx.staff = score->staff(staffIdx);
+
+            size_t lastSize = 0;
+            for (size_t chunkIdx = 0; chunkIdx < chunks.size(); ++chunkIdx) {
+                EventsBuffer& buffer = chunksEvents[chunkIdx][staffIdx];
+                buffer.reserve(lastSize);
+
+                renderStaffChunk(chunks[chunkIdx], &buffer, sctx);
+                sortEvents(buffer);
+
+                lastSize = buffer.size();
+            }
         }
+    };
+
+    size_t threadsCount = ctx.threadsCount > 0 ? ctx.threadsCount : std::max(std::thread::hardware_concurrency(), 1u);
+    threadsCount = std::min(threadsCount, stavesCount);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadsCount; ++i) {
+        threads.emplace_back(renderStaves);
     }
 
-    DynamicsRenderMethod renderMethod = DynamicsRenderMethod::SIMPLE;
-    switch (method) {
-    case 0:
-        renderMethod = DynamicsRenderMethod::SIMPLE;
-        break;
-    case 1:
-        renderMethod = DynamicsRenderMethod::SEG_START;
-        break;
-    case 2:
-        renderMethod = DynamicsRenderMethod::FIXED_MAX;
-        break;
-    default:
-        LOGW("Unrecognized dynamics method: %d", method);
-        break;
+    renderStaves();
+
+    for (std::thread& thread : threads) {
+        thread.join();
     }
 
-    // create note & other events
-    for (Staff* st : score->staves()) {
-        StaffContext sctx;
-        sctx.staff = st;
-        sctx.method = renderMethod;
-        sctx.cc = cc;
-        sctx.renderHarmony = ctx.renderHarmony;
-        renderStaffChunk(chunk, events, sctx);
+    for (size_t chunkIdx = 0; chunkIdx < chunks.size(); ++chunkIdx) {
+        finishChunk(chunks[chunkIdx], events, chunksEvents[chunkIdx], ctx);
+        chunksEvents[chunkIdx].clear();
+    }
+}
+
+//---------------------------------------------------------
+//   finishChunk
+///   Merges the events of the staves in the order
+///   they would be added by rendering the staves one by one
+///   and adds the events which depend on the events of all staves
+//---------------------------------------------------------
+
+void MidiRenderer::finishChunk(const Chunk& chunk, EventMap* events, std::vector<EventsBuffer>& staffEvents, const Context& ctx)
+{
+    for (EventsBuffer& buffer : staffEvents) {
+        if (!std::is_sorted(buffer.cbegin(), buffer.cend(), eventTickLess)) {
+            sortEvents(buffer);
+        }
     }
+
+    mergeEvents(staffEvents, events);
     events->fixupMIDI();
 
     // create sustain pedal events
@@ -2556,6 +2681,50 @@ void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Conte
     }
 }
 
+MidiRenderer::StaffContext MidiRenderer::staffContext(const Context& ctx) const
+{
+    SynthesizerState s = score->synthesizerState();
+    int method = s.method();
+    int cc = s.ccToUse();
+
+    // check if the score synth settings are actually set
+    // if not, use the global synth state
+    if (method == -1) {
+        method = ctx.synthState.method();
+        cc = ctx.synthState.ccToUse();
+
+        if (method == -1) {
+            // fall back to defaults - this may be needed to pass tests,
+            // since sometimes the synth state is not init
+            method = 1;
+            cc = 2;
+        }
+    }
+
+    DynamicsRenderMethod renderMethod = DynamicsRenderMethod::SIMPLE;
+    switch (method) {
+    case 0:
+        renderMethod = DynamicsRenderMethod::SIMPLE;
+        break;
+    case 1:
+        renderMethod = DynamicsRenderMethod::SEG_START;
+        break;
+    case 2:
+        renderMethod = DynamicsRenderMethod::FIXED_MAX;
+        break;
+    default:
+        LOGW("Unrecognized dynamics method: %d", method);
+        break;
+    }
+
+    StaffContext sctx;
+    sctx.method = renderMethod;
+    sctx.cc = cc;
+    sctx.renderHarmony = ctx.renderHarmony;
+
+    return sctx;
+}
+
 //---------------------------------------------------------
 //   MidiRenderer::updateState
 //---------------------------------------------------------
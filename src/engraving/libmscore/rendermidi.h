@@ -28,6 +28,7 @@
 
 namespace Ms {
 class EventMap;
+class EventsBuffer;
 class MasterScore;
 class Staff;
 class SynthesizerState;
@@ -113,14 +114,14 @@ private:
     static bool canBreakChunk(const Measure* last);
     void updateState();
 
-    void renderStaffChunk(const Chunk&, EventMap* events, const StaffContext& sctx);
+    void renderStaffChunk(const Chunk&, EventsBuffer* events, const StaffContext& sctx);
     void renderSpanners(const Chunk&, EventMap* events);
     void renderMetronome(const Chunk&, EventMap* events);
     void renderMetronome(EventMap* events, Measure const* m, const Fraction& tickOffset);
 
-    void collectMeasureEvents(EventMap* events, Measure const* m, const MidiRenderer::StaffContext& sctx, int tickOffset);
-    void collectMeasureEventsSimple(EventMap* events, Measure const* m, const StaffContext& sctx, int tickOffset);
-    void collectMeasureEventsDefault(EventMap* events, Measure const* m, const StaffContext& sctx, int tickOffset);
+    void collectMeasureEvents(EventsBuffer* events, Measure const* m, const MidiRenderer::StaffContext& sctx, int tickOffset);
+    void collectMeasureEventsSimple(EventsBuffer* events, Measure const* m, const StaffContext& sctx, int tickOffset);
+    void collectMeasureEventsDefault(EventsBuffer* events, Measure const* m, const StaffContext& sctx, int tickOffset);
 
 public:
     explicit MidiRenderer(Score* s);
@@ -130,6 +131,10 @@ public:
         Ms::SynthesizerState synthState;
         bool metronome{ true };
         bool renderHarmony{ false };
+        //! render the staves on the worker threads, the result is the same
+        bool parallel{ false };
+        //! the number of threads of the parallel rendering, 0 - one per core
+        size_t threadsCount{ 0 };
 
         Context() {}
     };
@@ -143,6 +148,11 @@ public:
     static const int ARTICULATION_CONV_FACTOR { 100000 };
 
     std::vector<Chunk> chunksFromRange(const int fromTick, const int toTick);
+
+private:
+    StaffContext staffContext(const Context& ctx) const;
+    void renderScoreParallel(EventMap* events, const Context& ctx);
+    void finishChunk(const Chunk&, EventMap* events, std::vector<EventsBuffer>& staffEvents, const Context& ctx);
 };
 
 class Spanner;
@@ -132,6 +132,7 @@ MeasureBaseList::MeasureBaseList()
 
 void MeasureBaseList::push_back(MeasureBase* e)
 {
+    ++_revision;
     ++_size;
     if (_last) {
         _last->setNext(e);
@@ -152,6 +153,7 @@ void MeasureBaseList::push_back(MeasureBase* e)
 
 void MeasureBaseList::push_front(MeasureBase* e)
 {
+    ++_revision;
     ++_size;
     if (_first) {
         _first->setPrev(e);
@@ -182,6 +184,7 @@ void MeasureBaseList::add(MeasureBase* e)
         push_front(e);
         return;
     }
+    ++_revision;
     ++_size;
     e->setPrev(el->prev());
     el->prev()->setNext(e);
@@ -195,6 +198,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
 {
+    ++_revision;
     --_size;
     if (el->prev()) {
         el->prev()->setNext(el->next());
@@ -214,6 +218,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 {
+    ++_revision;
     ++_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         ++_size;
@@ -239,6 +244,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 {
+    ++_revision;
     --_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         --_size;
@@ -263,6 +269,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
 {
+    ++_revision;
     nb->setPrev(ob->prev());
     nb->setNext(ob->next());
     if (ob->prev()) {
@@ -5199,6 +5206,7 @@ QString Score::name() const
 void Score::addRefresh(const mu::RectF& r)
 {
     _updateState.refresh.unite(r);
+    _updateHistory.addRefresh(r);
     cmdState().setUpdateMode(UpdateMode::Update);
 }
 
@@ -5402,6 +5410,7 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 
     m_layoutOptions.updateFromStyle(style());
     m_layout.doLayoutRange(m_layoutOptions, st, et);
+    _updateHistory.addUpdateAll();
     if (_resetAutoplace) {
         _resetAutoplace = false;
         resetAutoplace();
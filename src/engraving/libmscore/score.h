@@ -28,6 +28,7 @@
  Definition of Score class.
 */
 
+#include <deque>
 #include <set>
 
 #include <QQueue>
@@ -169,6 +170,7 @@ class MeasureBaseList
     int _size;
     MeasureBase* _first = nullptr;
     MeasureBase* _last = nullptr;
+    size_t _revision = 0;
 
     void push_back(MeasureBase* e);
     void push_front(MeasureBase* e);
@@ -177,7 +179,7 @@ public:
     MeasureBaseList();
     MeasureBase* first() const { return _first; }
     MeasureBase* last()  const { return _last; }
-    void clear() { _first = _last = 0; _size = 0; }
+    void clear() { _first = _last = 0; _size = 0; ++_revision; }
     void add(MeasureBase*);
     void remove(MeasureBase*);
     void insert(MeasureBase*, MeasureBase*);
@@ -186,6 +188,25 @@ public:
     int size() const { return _size; }
     bool empty() const { return _size == 0; }
     void fixupSystems();
+
+    //! NOTE Changes on any modification of the measure sequence or of the measure ticks
+    size_t revision() const { return _revision; }
+    void incRevision() { ++_revision; }
+};
+
+//---------------------------------------------------------
+//   MeasureTickIndex
+//    measures of the score in the order of the measure list
+//    with their ticks, rebuilt lazily by Score on lookup
+//---------------------------------------------------------
+
+struct MeasureTickIndex {
+    bool valid = false;
+    bool mmRests = false;
+    bool sorted = true;           ///< ticks are non-decreasing, so a binary search can be used
+    size_t revision = 0;
+    std::vector<Measure*> measures;
+    std::vector<Fraction> ticks;
 };
 
 //---------------------------------------------------------
@@ -323,6 +344,32 @@ public:
     std::list<EngravingObject*> _deleteList;
 };
 
+//---------------------------------------------------------
+//   UpdateHistory
+//    the areas to repaint after a given update, for the
+//    views which keep the painted score between repaints
+//---------------------------------------------------------
+
+class UpdateHistory
+{
+public:
+    void addRefresh(const mu::RectF& r);
+    void addUpdateAll();
+
+    uint64_t lastUpdate() const { return _lastUpdate; }
+
+    //! Collects the areas (canvas coordinates) refreshed after the given update.
+    //! Returns false if everything has to be repainted
+    bool refreshSince(uint64_t update, std::vector<mu::RectF>& rects) const;
+
+private:
+    static constexpr size_t MAX_REFRESHES = 256;
+
+    std::deque<std::pair<uint64_t, mu::RectF> > _refreshes;
+    uint64_t _lastUpdate { 0 };
+    uint64_t _lastUpdateAll { 0 };
+};
+
 //---------------------------------------------------------
 //   ScoreContentState
 //---------------------------------------------------------
@@ -417,8 +464,11 @@ private:
     int _pageNumberOffset { 0 };          ///< Offset for page numbers.
 
     UpdateState _updateState;
+    UpdateHistory _updateHistory;
 
     MeasureBaseList _measures;            // here are the notes
+    mutable MeasureTickIndex _tickIndex;
+    mutable MeasureTickIndex _tickIndexMM;
     std::vector<Part*> _parts;
     std::vector<Staff*> _staves;
     std::vector<Staff*> systemObjectStaves;
@@ -464,6 +514,7 @@ private:
     mu::engraving::RootItem* m_rootItem = nullptr;
     mu::engraving::Layout m_layout;
     mu::engraving::LayoutOptions m_layoutOptions;
+    int m_layoutGeneration = 0;     // incremented on every full layout
 
     mu::async::Channel<EngravingItem*> m_elementDestroyed;
 
@@ -791,6 +842,8 @@ public:
     virtual void addLayoutFlags(LayoutFlags);
     virtual void setInstrumentsChanged(bool);
     void addRefresh(const mu::RectF&);
+    void addUpdateAll() { _updateHistory.addUpdateAll(); }
+    const UpdateHistory& updateHistory() const { return _updateHistory; }
 
     void cmdToggleAutoplace(bool all);
 
@@ -848,6 +901,7 @@ public:
     void setSelection(const Selection& s);
 
     Fraction pos();
+    const MeasureTickIndex& measureTickIndex(bool mmRests) const;
     Measure* tick2measure(const Fraction& tick) const;
     Measure* tick2measureMM(const Fraction& tick) const;
     MeasureBase* tick2measureBase(const Fraction& tick) const;
@@ -1111,6 +1165,7 @@ public:
 
     //! NOTE Layout
     const mu::engraving::LayoutOptions& layoutOptions() const { return m_layoutOptions; }
+    int layoutGeneration() const { return m_layoutGeneration; }
     void setLayoutMode(mu::engraving::LayoutMode lm) { m_layoutOptions.mode = lm; }
     void setShowVBox(bool v) { m_layoutOptions.showVBox = v; }
 
@@ -25,10 +25,14 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
+#include <QSaveFile>
+
+#include <cstring>
 
 #include "io/file.h"
 #include "draw/painter.h"
 #include "types/symnames.h"
+#include "version.h"
 
 #include "mscore.h"
 
@@ -39,9 +43,133 @@ using namespace mu;
 using namespace mu::io;
 using namespace mu::draw;
 using namespace mu::engraving;
+using namespace mu::framework;
 
 static constexpr int FALLBACK_FONT_INDEX = 1; // Bravura
 
+//! NOTE The metrics cache is a fixed-layout binary file: a header followed by plain records,
+//! so it's read in one go and copied to the symbols without any parsing.
+//! The cache is only valid for the build that has written it, see metricsCacheKey().
+//! Several processes (ex. the converter workers) may write the cache at the same time,
+//! so the file is replaced atomically and the records are checked against the size and the checksum in the header
+static constexpr char METRICS_CACHE_MAGIC[4] = { 'M', 'S', 'F', 'C' };
+static constexpr uint32_t METRICS_CACHE_VERSION = 2;
+static constexpr size_t METRICS_CACHE_KEY_SIZE = 64;
+static constexpr size_t SMUFL_ANCHORS_COUNT = static_cast<size_t>(SmuflAnchorId::opticalCenter) + 1;
+static constexpr size_t SYM_COUNT = static_cast<size_t>(SymId::lastSym) + 1;
+
+static const char* SYM_CODES_CACHE_NAME = "glyphnames";
+
+struct MetricsCacheHeader {
+    char magic[4];
+    uint32_t version = 0;
+    char key[METRICS_CACHE_KEY_SIZE];
+    uint32_t symCount = 0;
+    uint32_t engravingDefaultsCount = 0;
+    double textEnclosureThickness = 0.0;
+    uint64_t recordsSize = 0;
+    uint64_t recordsChecksum = 0;
+};
+
+struct MetricsCacheSym {
+    uint32_t code = 0;
+    uint32_t anchorsMask = 0;
+    double bbox[4];
+    double advance = 0.0;
+    double anchors[SMUFL_ANCHORS_COUNT][2];
+};
+
+struct MetricsCacheEngravingDefault {
+    int32_t sid = 0;
+    int32_t reserved = 0;
+    double value = 0.0;
+};
+
+static std::string metricsCacheKey()
+{
+    return Version::fullVersion() + "-" + Version::revision();
+}
+
+static MetricsCacheHeader makeMetricsCacheHeader(uint32_t engravingDefaultsCount, double textEnclosureThickness)
+{
+    MetricsCacheHeader header;
+    std::memcpy(header.magic, METRICS_CACHE_MAGIC, sizeof(header.magic));
+    header.version = METRICS_CACHE_VERSION;
+
+    std::memset(header.key, 0, sizeof(header.key));
+    std::string key = metricsCacheKey();
+    std::memcpy(header.key, key.c_str(), std::min(key.size(), sizeof(header.key) - 1));
+
+    header.symCount = static_cast<uint32_t>(SYM_COUNT);
+    header.engravingDefaultsCount = engravingDefaultsCount;
+    header.textEnclosureThickness = textEnclosureThickness;
+
+    return header;
+}
+
+//! NOTE FNV-1a
+static uint64_t metricsCacheChecksum(const uint8_t* data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+static bool readMetricsCacheHeader(const ByteArray& data, MetricsCacheHeader& header)
+{
+    if (data.size() < sizeof(MetricsCacheHeader)) {
+        return false;
+    }
+
+    std::memcpy(&header, data.constData(), sizeof(MetricsCacheHeader));
+
+    if (std::memcmp(header.magic, METRICS_CACHE_MAGIC, sizeof(header.magic)) != 0
+        || header.version != METRICS_CACHE_VERSION
+        || header.symCount != SYM_COUNT) {
+        return false;
+    }
+
+    MetricsCacheHeader actual = makeMetricsCacheHeader(0, 0.0);
+    if (std::memcmp(header.key, actual.key, sizeof(header.key)) != 0) {
+        return false;
+    }
+
+    const uint8_t* records = data.constData() + sizeof(MetricsCacheHeader);
+    size_t recordsSize = data.size() - sizeof(MetricsCacheHeader);
+
+    return header.recordsSize == recordsSize && header.recordsChecksum == metricsCacheChecksum(records, recordsSize);
+}
+
+//! NOTE The header is completed with the size and the checksum of the records
+static bool writeMetricsCacheFile(const mu::io::path_t& path, MetricsCacheHeader header, ByteArray& data)
+{
+    const uint8_t* records = data.constData() + sizeof(MetricsCacheHeader);
+    size_t recordsSize = data.size() - sizeof(MetricsCacheHeader);
+
+    header.recordsSize = recordsSize;
+    header.recordsChecksum = metricsCacheChecksum(records, recordsSize);
+    std::memcpy(data.data(), &header, sizeof(MetricsCacheHeader));
+
+    //! NOTE The data is written to a temporary file, which replaces the cache file on commit,
+    //! so the readers never see a partially written file
+    QSaveFile file(path.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    qint64 size = static_cast<qint64>(data.size());
+    if (file.write(reinterpret_cast<const char*>(data.constData()), size) != size) {
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+
 std::vector<ScoreFont> ScoreFont::s_scoreFonts {
     ScoreFont("Leland",     "Leland",      ":/fonts/leland/",    "Leland.otf"),
     ScoreFont("Bravura",    "Bravura",     ":/fonts/bravura/",   "Bravura.otf"),
@@ -111,22 +239,28 @@ double ScoreFont::textEnclosureThickness()
 
 void ScoreFont::initScoreFonts()
 {
-    QJsonObject glyphNamesJson(ScoreFont::initGlyphNamesJson());
-    IF_ASSERT_FAILED(!glyphNamesJson.empty()) {
-        LOGE() << "Could not read glyph names JSON";
-        return;
-    }
+    TRACEFUNC;
+
+    if (!readSymCodesCache()) {
+        QJsonObject glyphNamesJson(ScoreFont::initGlyphNamesJson());
+        IF_ASSERT_FAILED(!glyphNamesJson.empty()) {
+            LOGE() << "Could not read glyph names JSON";
+            return;
+        }
 
-    for (size_t i = 0; i < s_symIdCodes.size(); ++i) {
-        QString name(SymNames::nameForSymId(static_cast<SymId>(i)));
+        for (size_t i = 0; i < s_symIdCodes.size(); ++i) {
+            QString name(SymNames::nameForSymId(static_cast<SymId>(i)));
 
-        bool ok;
-        uint code = glyphNamesJson.value(name).toObject().value("codepoint").toString().midRef(2).toUInt(&ok, 16);
-        if (ok) {
-            s_symIdCodes[i] = code;
-        } else if (MScore::debugMode) {
-            LOGD() << "could not read codepoint for glyph " << name;
+            bool ok;
+            uint code = glyphNamesJson.value(name).toObject().value("codepoint").toString().midRef(2).toUInt(&ok, 16);
+            if (ok) {
+                s_symIdCodes[i] = code;
+            } else if (MScore::debugMode) {
+                LOGD() << "could not read codepoint for glyph " << name;
+            }
         }
+
+        writeSymCodesCache();
     }
 
     fontProvider()->insertSubstitution("Leland Text",    "Bravura Text");
@@ -223,6 +357,8 @@ const char* ScoreFont::fallbackTextFont()
 
 void ScoreFont::load()
 {
+    TRACEFUNC;
+
     QString facePath = m_fontPath + m_filename;
     if (-1 == fontProvider()->addApplicationFont(m_family, facePath)) {
         LOGE() << "fatal error: cannot load internal font: " << facePath;
@@ -235,6 +371,13 @@ void ScoreFont::load()
     m_font.setNoFontMerging(true);
     m_font.setHinting(mu::draw::Font::Hinting::PreferVerticalHinting);
 
+    if (readMetricsCache()) {
+        loadComposedGlyphs();
+        m_engravingDefaults.push_back({ Sid::MusicalTextFont, QString("%1 Text").arg(m_family) });
+        m_loaded = true;
+        return;
+    }
+
     for (size_t id = 0; id < s_symIdCodes.size(); ++id) {
         uint code = s_symIdCodes[id];
         if (code == 0) {
@@ -259,10 +402,15 @@ void ScoreFont::load()
     }
 
     loadGlyphsWithAnchors(metadataJson.value("glyphsWithAnchors").toObject());
-    loadComposedGlyphs();
     loadStylisticAlternates(metadataJson.value("glyphsWithAlternates").toObject());
     loadEngravingDefaults(metadataJson.value("engravingDefaults").toObject());
 
+    //! NOTE The composed glyphs are not cached, they are cheap to compose from the cached symbols
+    writeMetricsCache();
+
+    loadComposedGlyphs();
+    m_engravingDefaults.push_back({ Sid::MusicalTextFont, QString("%1 Text").arg(m_family) });
+
     m_loaded = true;
 }
 
@@ -570,8 +718,6 @@ void ScoreFont::loadEngravingDefaults(const QJsonObject& engravingDefaultsObject
             }
         }
     }
-
-    m_engravingDefaults.push_back({ Sid::MusicalTextFont, QString("%1 Text").arg(m_family) });
 }
 
 void ScoreFont::computeMetrics(ScoreFont::Sym& sym, uint code)
@@ -581,6 +727,193 @@ void ScoreFont::computeMetrics(ScoreFont::Sym& sym, uint code)
     sym.advance = fontProvider()->symAdvance(m_font, code, DPI_F);
 }
 
+// =============================================
+// Metrics cache
+// =============================================
+
+mu::io::path_t ScoreFont::metricsCachePath(const QString& name)
+{
+    if (!engravingConfiguration()) {
+        return mu::io::path_t();
+    }
+
+    mu::io::path_t dir = engravingConfiguration()->fontMetricsCachePath();
+    if (dir.empty()) {
+        return mu::io::path_t();
+    }
+
+    return dir + "/" + name.toLower() + ".bin";
+}
+
+bool ScoreFont::readSymCodesCache()
+{
+    mu::io::path_t path = metricsCachePath(SYM_CODES_CACHE_NAME);
+    if (path.empty()) {
+        return false;
+    }
+
+    ByteArray data;
+    if (!fileSystem()->readFile(path, data)) {
+        return false;
+    }
+
+    MetricsCacheHeader header;
+    if (!readMetricsCacheHeader(data, header)) {
+        LOGD() << "outdated or broken cache: " << path;
+        return false;
+    }
+
+    if (data.size() != sizeof(MetricsCacheHeader) + SYM_COUNT * sizeof(uint32_t)) {
+        LOGW() << "broken cache: " << path;
+        return false;
+    }
+
+    const uint8_t* codes = data.constData() + sizeof(MetricsCacheHeader);
+    for (size_t i = 0; i < SYM_COUNT; ++i) {
+        uint32_t code = 0;
+        std::memcpy(&code, codes + i * sizeof(uint32_t), sizeof(uint32_t));
+        s_symIdCodes[i] = code;
+    }
+
+    return true;
+}
+
+void ScoreFont::writeSymCodesCache()
+{
+    mu::io::path_t path = metricsCachePath(SYM_CODES_CACHE_NAME);
+    if (path.empty()) {
+        return;
+    }
+
+    MetricsCacheHeader header = makeMetricsCacheHeader(0, 0.0);
+
+    ByteArray data(sizeof(MetricsCacheHeader) + SYM_COUNT * sizeof(uint32_t));
+
+    uint8_t* codes = data.data() + sizeof(MetricsCacheHeader);
+    for (size_t i = 0; i < SYM_COUNT; ++i) {
+        uint32_t code = s_symIdCodes[i];
+        std::memcpy(codes + i * sizeof(uint32_t), &code, sizeof(uint32_t));
+    }
+
+    fileSystem()->makePath(engravingConfiguration()->fontMetricsCachePath());
+    if (!writeMetricsCacheFile(path, header, data)) {
+        LOGW() << "failed to write cache: " << path;
+    }
+}
+
+bool ScoreFont::readMetricsCache()
+{
+    mu::io::path_t path = metricsCachePath(m_name);
+    if (path.empty()) {
+        return false;
+    }
+
+    ByteArray data;
+    if (!fileSystem()->readFile(path, data)) {
+        return false;
+    }
+
+    MetricsCacheHeader header;
+    if (!readMetricsCacheHeader(data, header)) {
+        LOGD() << "outdated or broken cache: " << path;
+        return false;
+    }
+
+    size_t expectedSize = sizeof(MetricsCacheHeader)
+                          + SYM_COUNT * sizeof(MetricsCacheSym)
+                          + header.engravingDefaultsCount * sizeof(MetricsCacheEngravingDefault);
+
+    if (data.size() != expectedSize) {
+        LOGW() << "broken cache: " << path;
+        return false;
+    }
+
+    const uint8_t* ptr = data.constData() + sizeof(MetricsCacheHeader);
+
+    for (size_t id = 0; id < SYM_COUNT; ++id) {
+        MetricsCacheSym record;
+        std::memcpy(&record, ptr, sizeof(MetricsCacheSym));
+        ptr += sizeof(MetricsCacheSym);
+
+        Sym& sym = m_symbols[id];
+        sym.code = record.code;
+        sym.bbox = RectF(record.bbox[0], record.bbox[1], record.bbox[2], record.bbox[3]);
+        sym.advance = record.advance;
+        sym.smuflAnchors.clear();
+
+        for (size_t anchor = 0; anchor < SMUFL_ANCHORS_COUNT; ++anchor) {
+            if (record.anchorsMask & (1u << anchor)) {
+                sym.smuflAnchors[static_cast<SmuflAnchorId>(anchor)] = PointF(record.anchors[anchor][0], record.anchors[anchor][1]);
+            }
+        }
+    }
+
+    m_engravingDefaults.clear();
+
+    for (uint32_t i = 0; i < header.engravingDefaultsCount; ++i) {
+        MetricsCacheEngravingDefault record;
+        std::memcpy(&record, ptr, sizeof(MetricsCacheEngravingDefault));
+        ptr += sizeof(MetricsCacheEngravingDefault);
+
+        m_engravingDefaults.push_back({ static_cast<Sid>(record.sid), record.value });
+    }
+
+    m_textEnclosureThickness = header.textEnclosureThickness;
+
+    return true;
+}
+
+void ScoreFont::writeMetricsCache() const
+{
+    mu::io::path_t path = metricsCachePath(m_name);
+    if (path.empty()) {
+        return;
+    }
+
+    MetricsCacheHeader header = makeMetricsCacheHeader(static_cast<uint32_t>(m_engravingDefaults.size()), m_textEnclosureThickness);
+
+    ByteArray data(sizeof(MetricsCacheHeader)
+                   + SYM_COUNT * sizeof(MetricsCacheSym)
+                   + m_engravingDefaults.size() * sizeof(MetricsCacheEngravingDefault));
+
+    uint8_t* ptr = data.data() + sizeof(MetricsCacheHeader);
+
+    for (const Sym& sym : m_symbols) {
+        MetricsCacheSym record;
+        record.code = sym.code;
+        record.bbox[0] = sym.bbox.x();
+        record.bbox[1] = sym.bbox.y();
+        record.bbox[2] = sym.bbox.width();
+        record.bbox[3] = sym.bbox.height();
+        record.advance = sym.advance;
+        std::memset(record.anchors, 0, sizeof(record.anchors));
+
+        for (const auto& pair : sym.smuflAnchors) {
+            size_t anchor = static_cast<size_t>(pair.first);
+            record.anchorsMask |= (1u << anchor);
+            record.anchors[anchor][0] = pair.second.x();
+            record.anchors[anchor][1] = pair.second.y();
+        }
+
+        std::memcpy(ptr, &record, sizeof(MetricsCacheSym));
+        ptr += sizeof(MetricsCacheSym);
+    }
+
+    for (const auto& pair : m_engravingDefaults) {
+        MetricsCacheEngravingDefault record;
+        record.sid = static_cast<int32_t>(pair.first);
+        record.value = pair.second.toDouble();
+
+        std::memcpy(ptr, &record, sizeof(MetricsCacheEngravingDefault));
+        ptr += sizeof(MetricsCacheEngravingDefault);
+    }
+
+    fileSystem()->makePath(engravingConfiguration()->fontMetricsCachePath());
+    if (!writeMetricsCacheFile(path, header, data)) {
+        LOGW() << "failed to write cache: " << path;
+    }
+}
+
 // =============================================
 // Symbol properties
 // =============================================
@@ -729,9 +1062,11 @@ void ScoreFont::draw(SymId id, Painter* painter, const SizeF& mag, const PointF&
 
     painter->save();
     qreal size = 20.0 * MScore::pixelRatio;
-    m_font.setPointSizeF(size);
+    //! NOTE The pages may be painted in parallel, so the shared font isn't changed here
+    mu::draw::Font font(m_font);
+    font.setPointSizeF(size);
     painter->scale(mag.width(), mag.height());
-    painter->setFont(m_font);
+    painter->setFont(font);
     painter->drawSymbol(PointF(pos.x() / mag.width(), pos.y() / mag.height()), symCode(id));
     painter->restore();
 }
@@ -27,7 +27,9 @@
 #include "infrastructure/draw/geometry.h"
 
 #include "modularity/ioc.h"
+#include "io/ifilesystem.h"
 #include "infrastructure/draw/ifontprovider.h"
+#include "iengravingconfiguration.h"
 
 namespace mu::draw {
 class Painter;
@@ -37,6 +39,8 @@ namespace Ms {
 class ScoreFont
 {
     INJECT_STATIC(score, mu::draw::IFontProvider, fontProvider)
+    INJECT_STATIC(score, mu::io::IFileSystem, fileSystem)
+    INJECT_STATIC(score, mu::engraving::IEngravingConfiguration, engravingConfiguration)
 
 public:
     ScoreFont(const char* name, const char* family, const char* path, const char* filename);
@@ -102,6 +106,10 @@ private:
 
     static QJsonObject initGlyphNamesJson();
 
+    static mu::io::path_t metricsCachePath(const QString& name);
+    static bool readSymCodesCache();
+    static void writeSymCodesCache();
+
     void load();
     void loadGlyphsWithAnchors(const QJsonObject& glyphsWithAnchors);
     void loadComposedGlyphs();
@@ -109,6 +117,9 @@ private:
     void loadEngravingDefaults(const QJsonObject& engravingDefaultsObject);
     void computeMetrics(Sym& sym, uint code);
 
+    bool readMetricsCache();
+    void writeMetricsCache() const;
+
     Sym& sym(SymId id);
     const Sym& sym(SymId id) const;
 
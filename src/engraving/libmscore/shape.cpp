@@ -21,6 +21,11 @@
  */
 
 #include "shape.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include "segment.h"
 #include "chord.h"
 #include "score.h"
@@ -92,6 +97,169 @@ Shape Shape::translated(const PointF& pt) const
     return s;
 }
 
+//---------------------------------------------------------
+//   SweepBuffers
+//    The buffers of the sweep are kept per thread and reused
+//    by the next sweeps, so that they don't allocate. The
+//    callbacks may sweep other shapes (see Note::computePadding),
+//    so every nesting level gets its own buffers.
+//---------------------------------------------------------
+
+static constexpr size_t SWEEP_MIN_PAIRS_COUNT = 64;
+
+struct Extent {
+    qreal from = 0.0;
+    qreal to = 0.0;
+    const ShapeElement* element = nullptr;
+};
+
+struct SweepBuffers {
+    std::vector<Extent> a;
+    std::vector<Extent> b;
+    std::vector<const Extent*> activeA;
+    std::vector<const Extent*> activeB;
+    std::vector<const ShapeElement*> sameVoiceA;
+    std::vector<const ShapeElement*> sameVoiceB;
+
+    void clear()
+    {
+        a.clear();
+        b.clear();
+        activeA.clear();
+        activeB.clear();
+        sameVoiceA.clear();
+        sameVoiceB.clear();
+    }
+};
+
+class SweepBuffersScope
+{
+public:
+    SweepBuffersScope()
+    {
+        std::vector<std::unique_ptr<SweepBuffers> >& levels = buffersLevels();
+        if (depth() == levels.size()) {
+            levels.push_back(std::make_unique<SweepBuffers>());
+        }
+
+        m_buffers = levels[depth()++].get();
+    }
+
+    ~SweepBuffersScope()
+    {
+        m_buffers->clear();
+        --depth();
+    }
+
+    SweepBuffers& operator*() { return *m_buffers; }
+    SweepBuffers* operator->() { return m_buffers; }
+
+private:
+    static std::vector<std::unique_ptr<SweepBuffers> >& buffersLevels()
+    {
+        thread_local std::vector<std::unique_ptr<SweepBuffers> > levels;
+        return levels;
+    }
+
+    static size_t& depth()
+    {
+        thread_local size_t depth = 0;
+        return depth;
+    }
+
+    SweepBuffers* m_buffers = nullptr;
+};
+
+//---------------------------------------------------------
+//   sweepOverlaps
+//    Calls f for every pair of the extents of buffers.a and
+//    buffers.b which overlap, until f returns true. The
+//    extents are swept in the order of their starts, so
+//    that only the overlapping pairs are visited. f must
+//    check its own condition, as the sweep may also pass
+//    pairs which only touch.
+//---------------------------------------------------------
+
+template<typename F>
+static void sweepOverlaps(SweepBuffers& buffers, F f)
+{
+    auto byFrom = [](const Extent& e1, const Extent& e2) { return e1.from < e2.from; };
+    std::sort(buffers.a.begin(), buffers.a.end(), byFrom);
+    std::sort(buffers.b.begin(), buffers.b.end(), byFrom);
+
+    const std::vector<Extent>& as = buffers.a;
+    const std::vector<Extent>& bs = buffers.b;
+    std::vector<const Extent*>& activeA = buffers.activeA;
+    std::vector<const Extent*>& activeB = buffers.activeB;
+
+    auto dropFinished = [](std::vector<const Extent*>& active, qreal from) {
+        active.erase(std::remove_if(active.begin(), active.end(), [from](const Extent* e) { return e->to <= from; }),
+                     active.end());
+    };
+
+    size_t i = 0;
+    size_t j = 0;
+    while (i < as.size() || j < bs.size()) {
+        if (j == bs.size() || (i < as.size() && as[i].from <= bs[j].from)) {
+            const Extent& e = as[i++];
+            dropFinished(activeB, e.from);
+            for (const Extent* other : activeB) {
+                if (f(*e.element, *other->element)) {
+                    return;
+                }
+            }
+            activeA.push_back(&e);
+        } else {
+            const Extent& e = bs[j++];
+            dropFinished(activeA, e.from);
+            for (const Extent* other : activeA) {
+                if (f(*other->element, *e.element)) {
+                    return;
+                }
+            }
+            activeB.push_back(&e);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   forEachHorizontalOverlap
+//    Calls f for every pair of rectangles of a and b whose
+//    horizontal extents overlap, until f returns true.
+//    Small shapes are compared pairwise, larger ones are
+//    swept from left to right.
+//---------------------------------------------------------
+
+template<typename F>
+static void forEachHorizontalOverlap(const Shape& a, const Shape& b, F f)
+{
+    if (a.size() * b.size() <= SWEEP_MIN_PAIRS_COUNT) {
+        for (const ShapeElement& rb : b) {
+            for (const ShapeElement& ra : a) {
+                if (f(ra, rb)) {
+                    return;
+                }
+            }
+        }
+        return;
+    }
+
+    SweepBuffersScope buffers;
+
+    auto addExtents = [](const Shape& shape, std::vector<Extent>& extents) {
+        for (const ShapeElement& r : shape) {
+            qreal x1 = r.x();
+            qreal x2 = r.x() + r.width();
+            extents.push_back({ std::min(x1, x2), std::max(x1, x2), &r });
+        }
+    };
+
+    addExtents(a, buffers->a);
+    addExtents(b, buffers->b);
+
+    sweepOverlaps(*buffers, f);
+}
+
 //-------------------------------------------------------------------
 //   minHorizontalDistance
 //    a is located right of this shape.
@@ -103,33 +271,112 @@ qreal Shape::minHorizontalDistance(const Shape& a, Score* score) const
 {
     qreal dist = -1000000.0;        // min real
     double verticalClearance = 0.2 * score->spatium();
-    for (const ShapeElement& r2 : a) {
+
+    auto limitDistance = [&dist, verticalClearance](const ShapeElement& r1, const ShapeElement& r2) {
+        const EngravingItem* item1 = r1.toItem;
         const EngravingItem* item2 = r2.toItem;
-        qreal by1 = r2.top();
-        qreal by2 = r2.bottom();
-        for (const ShapeElement& r1 : *this) {
-            const EngravingItem* item1 = r1.toItem;
-            qreal ay1 = r1.top();
-            qreal ay2 = r1.bottom();
-            bool intersection = Ms::intersects(ay1, ay2, by1, by2, verticalClearance);
-            double padding = 0;
-            KerningType kerningType = KerningType::NON_KERNING;
-            if (item1 && item2) {
-                padding = item1->computePadding(item2);
-                kerningType = item1->computeKerningType(item2);
+        bool intersection = Ms::intersects(r1.top(), r1.bottom(), r2.top(), r2.bottom(), verticalClearance);
+        KerningType kerningType = KerningType::NON_KERNING;
+        if (item1 && item2) {
+            kerningType = item1->computeKerningType(item2);
+        }
+        if (intersection
+            || (r1.width() == 0 || r2.width() == 0) // Temporary hack: shapes of zero-width are assumed to collide with everyghin
+            || (!item1 && item2 && item2->isLyrics()) // Temporary hack: avoids collision with melisma line
+            || kerningType == KerningType::NON_KERNING) {
+            // NOTE: padding may be expensive to compute (see Note::computePadding),
+            // so it is computed only for the pairs which actually limit the distance
+            double padding = (item1 && item2) ? item1->computePadding(item2) : 0.0;
+            dist = qMax(dist, r1.right() - r2.left() + padding);
+        }
+        if (kerningType == KerningType::KERNING_UNTIL_ORIGIN) { //prepared for future user option, for now always false
+            qreal origin = r1.left();
+            dist = qMax(dist, origin - r2.left());
+        }
+        return false;
+    };
+
+    if (size() * a.size() <= SWEEP_MIN_PAIRS_COUNT) {
+        for (const ShapeElement& r2 : a) {
+            for (const ShapeElement& r1 : *this) {
+                limitDistance(r1, r2);
             }
-            if (intersection
-                || (r1.width() == 0 || r2.width() == 0) // Temporary hack: shapes of zero-width are assumed to collide with everyghin
-                || (!item1 && item2 && item2->isLyrics()) // Temporary hack: avoids collision with melisma line
-                || kerningType == KerningType::NON_KERNING) {
-                dist = qMax(dist, r1.right() - r2.left() + padding);
+        }
+        return dist;
+    }
+
+    //! NOTE Two kerning rectangles limit the distance only if they intersect vertically,
+    //! so these are swept from top to bottom. The rectangles which may limit the distance anyway
+    //! are compared with all the rectangles of the other shape, the ones limited to the same voice
+    //! are compared with the rectangles of the same track
+    SweepBuffersScope buffers;
+
+    for (const ShapeElement& r1 : *this) {
+        const EngravingItem* item1 = r1.toItem;
+        if (!item1 || r1.width() == 0 || r1.height() < 0 || item1->limitsKerningWithNext()) {
+            for (const ShapeElement& r2 : a) {
+                limitDistance(r1, r2);
+            }
+            continue;
+        }
+
+        if (item1->isKerningLimitedToSameVoice()) {
+            buffers->sameVoiceA.push_back(&r1);
+        }
+
+        if (r1.height() > 0) {
+            buffers->a.push_back({ r1.top(), r1.bottom() + verticalClearance, &r1 });
+        }
+    }
+
+    for (const ShapeElement& r2 : a) {
+        const EngravingItem* item2 = r2.toItem;
+        if (!item2 || r2.width() == 0 || r2.height() < 0 || item2->limitsKerningWithPrevious()) {
+            for (const ShapeElement& r1 : *this) {
+                limitDistance(r1, r2);
             }
-            if (kerningType == KerningType::KERNING_UNTIL_ORIGIN) { //prepared for future user option, for now always false
-                qreal origin = r1.left();
-                dist = qMax(dist, origin - r2.left());
+            continue;
+        }
+
+        if (item2->isKerningLimitedToSameVoice()) {
+            buffers->sameVoiceB.push_back(&r2);
+        }
+
+        if (r2.height() > 0) {
+            buffers->b.push_back({ r2.top(), r2.bottom() + verticalClearance, &r2 });
+        }
+    }
+
+    auto byTrack = [](const ShapeElement* r1, const ShapeElement* r2) { return r1->toItem->track() < r2->toItem->track(); };
+    std::sort(buffers->sameVoiceA.begin(), buffers->sameVoiceA.end(), byTrack);
+    std::sort(buffers->sameVoiceB.begin(), buffers->sameVoiceB.end(), byTrack);
+
+    const std::vector<const ShapeElement*>& sameVoiceA = buffers->sameVoiceA;
+    const std::vector<const ShapeElement*>& sameVoiceB = buffers->sameVoiceB;
+
+    size_t j = 0;
+    for (size_t i = 0; i < sameVoiceA.size();) {
+        track_idx_t track = sameVoiceA[i]->toItem->track();
+        size_t trackEnd = i;
+        while (trackEnd < sameVoiceA.size() && sameVoiceA[trackEnd]->toItem->track() == track) {
+            ++trackEnd;
+        }
+
+        while (j < sameVoiceB.size() && sameVoiceB[j]->toItem->track() < track) {
+            ++j;
+        }
+
+        for (size_t k = j; k < sameVoiceB.size() && sameVoiceB[k]->toItem->track() == track; ++k) {
+            for (size_t l = i; l < trackEnd; ++l) {
+                limitDistance(*sameVoiceA[l], *sameVoiceB[k]);
             }
         }
+
+        i = trackEnd;
     }
+
+    sweepOverlaps(*buffers, limitDistance);
+
     return dist;
 }
 
@@ -146,23 +393,15 @@ qreal Shape::minVerticalDistance(const Shape& a) const
     }
 
     qreal dist = -1000000.0; // min real
-    for (const RectF& r2 : a) {
-        if (r2.height() <= 0.0) {
-            continue;
+    forEachHorizontalOverlap(*this, a, [&dist](const RectF& r1, const RectF& r2) {
+        if (r1.height() <= 0.0 || r2.height() <= 0.0) {
+            return false;
         }
-        qreal bx1 = r2.left();
-        qreal bx2 = r2.right();
-        for (const RectF& r1 : *this) {
-            if (r1.height() <= 0.0) {
-                continue;
-            }
-            qreal ax1 = r1.left();
-            qreal ax2 = r1.right();
-            if (Ms::intersects(ax1, ax2, bx1, bx2, 0.0)) {
-                dist = qMax(dist, r1.bottom() - r2.top());
-            }
+        if (Ms::intersects(r1.left(), r1.right(), r2.left(), r2.right(), 0.0)) {
+            dist = qMax(dist, r1.bottom() - r2.top());
         }
-    }
+        return false;
+    });
     return dist;
 }
 
@@ -325,12 +564,12 @@ bool Shape::intersects(const RectF& rr) const
 
 bool Shape::intersects(const Shape& other) const
 {
-    for (const RectF& r : other) {
-        if (intersects(r)) {
-            return true;
-        }
-    }
-    return false;
+    bool result = false;
+    forEachHorizontalOverlap(*this, other, [&result](const RectF& r1, const RectF& r2) {
+        result = r1.intersects(r2);
+        return result;
+    });
+    return result;
 }
 
 void Shape::paint(Painter& painter) const
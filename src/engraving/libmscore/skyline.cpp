@@ -53,45 +53,53 @@ void Skyline::add(const RectF& r)
 }
 
 //---------------------------------------------------------
-//   insert
+//   append
 //---------------------------------------------------------
 
-SkylineLine::SegIter SkylineLine::insert(SegIter i, qreal x, qreal y, qreal w)
+void SkylineLine::append(qreal x, qreal y, qreal w)
 {
-    const qreal xr = x + w;
-    // Only x coordinate change is handled here as width change gets handled
-    // in SkylineLine::add().
-    if (i != seg.end() && xr > i->x) {
-        i->x = xr;
-    }
-    return seg.emplace(i, x, y, w);
+    xs.push_back(x);
+    ys.push_back(y);
+    ws.push_back(w);
 }
 
 //---------------------------------------------------------
-//   append
+//   replace
+//    replaces the segments [from, to) with the given ones,
+//    which are never fewer than the replaced segments
 //---------------------------------------------------------
 
-void SkylineLine::append(qreal x, qreal y, qreal w)
+void SkylineLine::replace(size_t from, size_t to, const std::vector<SkylineSegment>& segments)
 {
-    seg.emplace_back(x, y, w);
+    const size_t replacedCount = to - from;
+    if (segments.size() == replacedCount) {
+        // the segments have been modified in place
+        return;
+    }
+
+    const size_t insertedCount = segments.size() - replacedCount;
+    xs.insert(xs.begin() + to, insertedCount, 0.0);
+    ys.insert(ys.begin() + to, insertedCount, 0.0);
+    ws.insert(ws.begin() + to, insertedCount, 0.0);
+
+    for (size_t i = 0; i < segments.size(); ++i) {
+        xs[from + i] = segments[i].x;
+        ys[from + i] = segments[i].y;
+        ws[from + i] = segments[i].w;
+    }
 }
 
 //---------------------------------------------------------
-//   getApproxPosition
+//   find
 //---------------------------------------------------------
 
-SkylineLine::SegIter SkylineLine::find(qreal x)
+size_t SkylineLine::find(qreal x) const
 {
-    auto it = std::upper_bound(seg.begin(), seg.end(), x, [](qreal x, const SkylineSegment& s) { return x < s.x; });
-    if (it == seg.begin()) {
-        return it;
+    auto it = std::upper_bound(xs.begin(), xs.end(), x);
+    if (it == xs.begin()) {
+        return 0;
     }
-    return --it;
-}
-
-SkylineLine::SegConstIter SkylineLine::find(qreal x) const
-{
-    return const_cast<SkylineLine*>(this)->find(x);
+    return std::distance(xs.begin(), it) - 1;
 }
 
 //---------------------------------------------------------
@@ -134,64 +142,103 @@ void SkylineLine::add(qreal x, qreal y, qreal w)
 
     DP("===add  %f %f %f\n", x, y, w);
 
-    SegIter i = find(x);
-    qreal cx = seg.empty() ? 0.0 : i->x;
-    for (; i != seg.end(); ++i) {
-        qreal cy = i->y;
+    // The segments affected by the new one are merged with it into a separate
+    // buffer, which then replaces them at once. Segments are modified in place,
+    // so the buffer only has to be spliced in if new segments were inserted
+    thread_local std::vector<SkylineSegment> merged;
+    merged.clear();
+
+    const size_t n = size();
+    const size_t first = find(x);
+    size_t i = first;
+    qreal cx = n == 0 ? 0.0 : xs[i];
+    bool done = false;
+
+    auto next = [&]() {
+        merged.emplace_back(xs[i], ys[i], ws[i]);
+        ++i;
+    };
+
+    // Only x coordinate change is handled here as width change gets handled below
+    auto insert = [&](qreal sx, qreal sy, qreal sw) {
+        const qreal xr = sx + sw;
+        if (i < n && xr > xs[i]) {
+            xs[i] = xr;
+        }
+        merged.emplace_back(sx, sy, sw);
+    };
+
+    while (i < n) {
+        qreal cy = ys[i];
         if ((x + w) <= cx) {                                            // A
-            return;       // break;
+            done = true;
+            break;
         }
-        if (x > (cx + i->w)) {                                          // B
-            cx += i->w;
+        if (x > (cx + ws[i])) {                                         // B
+            cx += ws[i];
+            next();
             continue;
         }
         if ((north && (cy <= y)) || (!north && (cy >= y))) {
-            cx += i->w;
+            cx += ws[i];
+            next();
             continue;
         }
-        if ((x >= cx) && ((x + w) < (cx + i->w))) {                     // (E) insert segment
-            DP("    insert at %f %f   x:%f w:%f\n", cx, i->w, x, w);
+        if ((x >= cx) && ((x + w) < (cx + ws[i]))) {                   // (E) insert segment
+            DP("    insert at %f %f   x:%f w:%f\n", cx, ws[i], x, w);
             qreal w1 = x - cx;
             qreal w2 = w;
-            qreal w3 = i->w - (w1 + w2);
+            qreal w3 = ws[i] - (w1 + w2);
             if (w1 > 0.0000001) {
-                i->w = w1;
-                ++i;
-                i = insert(i, x, y, w2);
+                ws[i] = w1;
+                next();
+                insert(x, y, w2);
                 DP("       A w1 %f w2 %f\n", w1, w2);
             } else {
-                i->w = w2;
-                i->y = y;
+                ws[i] = w2;
+                ys[i] = y;
+                next();
                 DP("       B w2 %f\n", w2);
             }
             if (w3 > 0.0000001) {
-                ++i;
                 DP("       C w3 %f\n", w3);
-                insert(i, x + w2, cy, w3);
+                insert(x + w2, cy, w3);
             }
-            return;
-        } else if ((x <= cx) && ((x + w) >= (cx + i->w))) {                 // F
+            done = true;
+            break;
+        } else if ((x <= cx) && ((x + w) >= (cx + ws[i]))) {               // F
             DP("    change(F) cx %f y %f\n", cx, y);
-            i->y = y;
+            ys[i] = y;
         } else if (x < cx) {                                            // C
             qreal w1 = x + w - cx;
-            i->w    -= w1;
-            DP("    add(C) cx %f y %f w %f w1 %f\n", cx, y, w1, i->w);
-            insert(i, cx, y, w1);
-            return;
+            ws[i] -= w1;
+            DP("    add(C) cx %f y %f w %f w1 %f\n", cx, y, w1, ws[i]);
+            insert(cx, y, w1);
+            done = true;
+            break;
         } else {                                                        // D
             qreal w1 = x - cx;
-            qreal w2 = i->w - w1;
+            qreal w2 = ws[i] - w1;
             if (w2 > 0.0000001) {
-                i->w = w1;
-                cx  += w1;
+                ws[i] = w1;
+                cx   += w1;
                 DP("    add(D) %f %f\n", y, w2);
-                ++i;
-                i = insert(i, cx, y, w2);
+                next();
+                insert(cx, y, w2);
+                cx += w2;
+                continue;
             }
         }
-        cx += i->w;
+        cx += ws[i];
+        next();
+    }
+
+    replace(first, i, merged);
+
+    if (done) {
+        return;
     }
+
     if (x >= cx) {
         if (x > cx) {
             qreal cy = north ? MAXIMUM_Y : MINIMUM_Y;
@@ -215,6 +262,13 @@ void Skyline::clear()
     _south.clear();
 }
 
+void SkylineLine::clear()
+{
+    xs.clear();
+    ys.clear();
+    ws.clear();
+}
+
 //-------------------------------------------------------------------
 //   minDistance
 //    a is located below this skyline.
@@ -230,35 +284,43 @@ qreal SkylineLine::minDistance(const SkylineLine& sl) const
 {
     qreal dist = MINIMUM_Y;
 
+    // The distance can't exceed the difference between the extreme heights
+    // of both lines, so the walk stops as soon as it is reached
+    const qreal maxDist = maxY() - sl.minY();
+
+    const size_t n = size();
+    const size_t m = sl.size();
+
     qreal x1 = 0.0;
     qreal x2 = 0.0;
-    auto k   = sl.begin();
-    for (auto i = begin(); i != end(); ++i) {
-        while (k != sl.end() && (x2 + k->w) < x1) {
-            x2 += k->w;
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const qreal w1 = ws[i];
+        while (k < m && (x2 + sl.ws[k]) < x1) {
+            x2 += sl.ws[k];
             ++k;
         }
-        if (k == sl.end()) {
+        if (k == m) {
             break;
         }
         for (;;) {
-            if ((x1 + i->w > x2) && (x1 < x2 + k->w)) {
-                dist = qMax(dist, i->y - k->y);
+            if ((x1 + w1 > x2) && (x1 < x2 + sl.ws[k])) {
+                dist = qMax(dist, ys[i] - sl.ys[k]);
             }
-            if (x2 + k->w < x1 + i->w) {
-                x2 += k->w;
+            if (x2 + sl.ws[k] < x1 + w1) {
+                x2 += sl.ws[k];
                 ++k;
-                if (k == sl.end()) {
+                if (k == m) {
                     break;
                 }
             } else {
                 break;
             }
         }
-        if (k == sl.end()) {
+        if (k == m || dist >= maxDist) {
             break;
         }
-        x1 += i->w;
+        x1 += w1;
     }
     return dist;
 }
@@ -303,7 +365,7 @@ void SkylineLine::paint(Painter& painter) const
 
 bool SkylineLine::valid() const
 {
-    return !seg.empty();
+    return !xs.empty();
 }
 
 bool SkylineLine::valid(const SkylineSegment& s) const
@@ -340,17 +402,29 @@ void SkylineLine::dump() const
 
 qreal SkylineLine::max() const
 {
-    qreal val;
-    if (north) {
-        val = MAXIMUM_Y;
-        for (const SkylineSegment& s : *this) {
-            val = qMin(val, s.y);
-        }
-    } else {
-        val = MINIMUM_Y;
-        for (const SkylineSegment& s : *this) {
-            val = qMax(val, s.y);
-        }
+    return north ? minY() : maxY();
+}
+
+//---------------------------------------------------------
+//   minY / maxY
+//    plain loops over the heights, which the compiler
+//    vectorizes
+//---------------------------------------------------------
+
+qreal SkylineLine::minY() const
+{
+    qreal val = MAXIMUM_Y;
+    for (qreal y : ys) {
+        val = qMin(val, y);
+    }
+    return val;
+}
+
+qreal SkylineLine::maxY() const
+{
+    qreal val = MINIMUM_Y;
+    for (qreal y : ys) {
+        val = qMax(val, y);
     }
     return val;
 }
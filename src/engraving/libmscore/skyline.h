@@ -24,6 +24,7 @@
 #define __SKYLINE_H__
 
 #include <vector>
+#include <iterator>
 
 #include "infrastructure/draw/geometry.h"
 
@@ -50,27 +51,42 @@ struct SkylineSegment {
 
 //---------------------------------------------------------
 //   SkylineLine
+//    Segments are stored as a structure of arrays, so that
+//    distance queries only touch the widths and heights and
+//    the lookup by x only touches the x positions
 //---------------------------------------------------------
 
 class SkylineLine
 {
-    const bool north;
-    std::vector<SkylineSegment> seg;
-    typedef std::vector<SkylineSegment>::iterator SegIter;
-    typedef std::vector<SkylineSegment>::const_iterator SegConstIter;
-
-    SegIter insert(SegIter i, qreal x, qreal y, qreal w);
-    void append(qreal x, qreal y, qreal w);
-    SegIter find(qreal x);
-    SegConstIter find(qreal x) const;
-
 public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = SkylineSegment;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = SkylineSegment;
+
+        const_iterator(const SkylineLine* line, size_t idx)
+            : m_line(line), m_idx(idx) {}
+
+        SkylineSegment operator*() const { return m_line->segment(m_idx); }
+        const_iterator& operator++() { ++m_idx; return *this; }
+        bool operator==(const const_iterator& other) const { return m_idx == other.m_idx; }
+        bool operator!=(const const_iterator& other) const { return m_idx != other.m_idx; }
+
+    private:
+        const SkylineLine* m_line = nullptr;
+        size_t m_idx = 0;
+    };
+
     SkylineLine(bool n)
         : north(n) {}
     void add(const Shape& s);
     void add(const mu::RectF& r);
     void add(qreal x, qreal y, qreal w);
-    void clear() { seg.clear(); }
+    void clear();
     void paint(mu::draw::Painter& painter) const;
     void dump() const;
     qreal minDistance(const SkylineLine&) const;
@@ -79,10 +95,23 @@ public:
     bool valid(const SkylineSegment& s) const;
     bool isNorth() const { return north; }
 
-    SegIter begin() { return seg.begin(); }
-    SegConstIter begin() const { return seg.begin(); }
-    SegIter end() { return seg.end(); }
-    SegConstIter end() const { return seg.end(); }
+    size_t size() const { return xs.size(); }
+    SkylineSegment segment(size_t idx) const { return SkylineSegment(xs[idx], ys[idx], ws[idx]); }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+private:
+    size_t find(qreal x) const;
+    void append(qreal x, qreal y, qreal w);
+    void replace(size_t from, size_t to, const std::vector<SkylineSegment>& segments);
+    qreal minY() const;
+    qreal maxY() const;
+
+    const bool north;
+    std::vector<qreal> xs;
+    std::vector<qreal> ys;
+    std::vector<qreal> ws;
 };
 
 //---------------------------------------------------------
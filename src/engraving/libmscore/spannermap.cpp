@@ -21,6 +21,9 @@
  */
 
 #include "spannermap.h"
+
+#include <algorithm>
+
 #include "spanner.h"
 
 #include "log.h"
@@ -28,6 +31,296 @@
 using namespace mu;
 
 namespace Ms {
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SpannerIntervalTree::clear()
+{
+    nodes.clear();
+    freeNodes.clear();
+    spannerNodes.clear();
+    root = -1;
+}
+
+//---------------------------------------------------------
+//   less
+//    nodes are ordered by the start tick, the nodes with
+//    the same start by the node index
+//---------------------------------------------------------
+
+bool SpannerIntervalTree::less(int start, int n, int other) const
+{
+    const Node& o = nodes[other];
+    return start < o.start || (start == o.start && n < other);
+}
+
+//---------------------------------------------------------
+//   updateNode
+//---------------------------------------------------------
+
+void SpannerIntervalTree::updateNode(int n)
+{
+    Node& node = nodes[n];
+    node.height = 1 + std::max(height(node.left), height(node.right));
+    node.maxStop = node.stop;
+    if (node.left >= 0) {
+        node.maxStop = std::max(node.maxStop, nodes[node.left].maxStop);
+    }
+    if (node.right >= 0) {
+        node.maxStop = std::max(node.maxStop, nodes[node.right].maxStop);
+    }
+}
+
+//---------------------------------------------------------
+//   rotateLeft
+//---------------------------------------------------------
+
+int SpannerIntervalTree::rotateLeft(int n)
+{
+    int r = nodes[n].right;
+    nodes[n].right = nodes[r].left;
+    nodes[r].left = n;
+    updateNode(n);
+    updateNode(r);
+    return r;
+}
+
+//---------------------------------------------------------
+//   rotateRight
+//---------------------------------------------------------
+
+int SpannerIntervalTree::rotateRight(int n)
+{
+    int l = nodes[n].left;
+    nodes[n].left = nodes[l].right;
+    nodes[l].right = n;
+    updateNode(n);
+    updateNode(l);
+    return l;
+}
+
+//---------------------------------------------------------
+//   rebalance
+//---------------------------------------------------------
+
+int SpannerIntervalTree::rebalance(int n)
+{
+    updateNode(n);
+    int balance = balanceFactor(n);
+    if (balance > 1) {
+        if (balanceFactor(nodes[n].left) < 0) {
+            nodes[n].left = rotateLeft(nodes[n].left);
+        }
+        return rotateRight(n);
+    }
+    if (balance < -1) {
+        if (balanceFactor(nodes[n].right) > 0) {
+            nodes[n].right = rotateRight(nodes[n].right);
+        }
+        return rotateLeft(n);
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   insertNode
+//---------------------------------------------------------
+
+int SpannerIntervalTree::insertNode(int r, int n)
+{
+    if (r < 0) {
+        return n;
+    }
+    if (less(nodes[n].start, n, r)) {
+        nodes[r].left = insertNode(nodes[r].left, n);
+    } else {
+        nodes[r].right = insertNode(nodes[r].right, n);
+    }
+    return rebalance(r);
+}
+
+//---------------------------------------------------------
+//   eraseMin
+//    detaches the first node of the subtree
+//---------------------------------------------------------
+
+int SpannerIntervalTree::eraseMin(int r, int& min)
+{
+    if (nodes[r].left < 0) {
+        min = r;
+        return nodes[r].right;
+    }
+    nodes[r].left = eraseMin(nodes[r].left, min);
+    return rebalance(r);
+}
+
+//---------------------------------------------------------
+//   eraseNode
+//---------------------------------------------------------
+
+int SpannerIntervalTree::eraseNode(int r, int start, int n)
+{
+    if (r < 0) {
+        return r;
+    }
+    if (r != n) {
+        if (less(start, n, r)) {
+            nodes[r].left = eraseNode(nodes[r].left, start, n);
+        } else {
+            nodes[r].right = eraseNode(nodes[r].right, start, n);
+        }
+        return rebalance(r);
+    }
+
+    int left = nodes[n].left;
+    int right = nodes[n].right;
+    if (left < 0) {
+        return right;
+    }
+    if (right < 0) {
+        return left;
+    }
+    int min = -1;
+    right = eraseMin(right, min);
+    nodes[min].left = left;
+    nodes[min].right = right;
+    return rebalance(min);
+}
+
+//---------------------------------------------------------
+//   insert
+//---------------------------------------------------------
+
+void SpannerIntervalTree::insert(Spanner* s, int start, int stop)
+{
+    int n;
+    if (freeNodes.empty()) {
+        n = static_cast<int>(nodes.size());
+        nodes.emplace_back();
+    } else {
+        n = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[n] = Node();
+    }
+
+    Node& node = nodes[n];
+    node.start = start;
+    node.stop = stop;
+    node.maxStop = stop;
+    node.spanner = s;
+
+    root = insertNode(root, n);
+    spannerNodes.emplace(s, n);
+}
+
+//---------------------------------------------------------
+//   remove
+//---------------------------------------------------------
+
+bool SpannerIntervalTree::remove(Spanner* s)
+{
+    auto it = spannerNodes.find(s);
+    if (it == spannerNodes.end()) {
+        return false;
+    }
+
+    int n = it->second;
+    spannerNodes.erase(it);
+
+    root = eraseNode(root, nodes[n].start, n);
+    nodes[n].spanner = nullptr;
+    freeNodes.push_back(n);
+    return true;
+}
+
+//---------------------------------------------------------
+//   update
+//    moves the nodes of the spanner to its current ticks
+//---------------------------------------------------------
+
+void SpannerIntervalTree::update(Spanner* s)
+{
+    auto range = spannerNodes.equal_range(s);
+    if (range.first == range.second) {
+        return;
+    }
+
+    int start = s->tick().ticks();
+    int stop = s->tick2().ticks();
+
+    for (auto it = range.first; it != range.second; ++it) {
+        int n = it->second;
+        if (nodes[n].start == start && nodes[n].stop == stop) {
+            continue;
+        }
+        root = eraseNode(root, nodes[n].start, n);
+        nodes[n].start = start;
+        nodes[n].stop = stop;
+        nodes[n].left = -1;
+        nodes[n].right = -1;
+        updateNode(n);
+        root = insertNode(root, n);
+    }
+}
+
+//---------------------------------------------------------
+//   findOverlapping
+//---------------------------------------------------------
+
+void SpannerIntervalTree::findOverlapping(int start, int stop, std::vector<Interval>& result) const
+{
+    findOverlapping(root, start, stop, result);
+}
+
+void SpannerIntervalTree::findOverlapping(int n, int start, int stop, std::vector<Interval>& result) const
+{
+    // the subtree ends before the range
+    if (n < 0 || nodes[n].maxStop < start) {
+        return;
+    }
+
+    const Node& node = nodes[n];
+    findOverlapping(node.left, start, stop, result);
+
+    // this node and the right subtree start after the range
+    if (node.start > stop) {
+        return;
+    }
+    if (node.stop >= start) {
+        result.push_back(Interval(node.start, node.stop, node.spanner));
+    }
+    findOverlapping(node.right, start, stop, result);
+}
+
+//---------------------------------------------------------
+//   findContained
+//---------------------------------------------------------
+
+void SpannerIntervalTree::findContained(int start, int stop, std::vector<Interval>& result) const
+{
+    findContained(root, start, stop, result);
+}
+
+void SpannerIntervalTree::findContained(int n, int start, int stop, std::vector<Interval>& result) const
+{
+    if (n < 0) {
+        return;
+    }
+
+    const Node& node = nodes[n];
+    if (node.start >= start) {
+        findContained(node.left, start, stop, result);
+    }
+    if (node.start > stop) {
+        return;
+    }
+    if (node.start >= start && node.stop <= stop) {
+        result.push_back(Interval(node.start, node.stop, node.spanner));
+    }
+    findContained(node.right, start, stop, result);
+}
+
 //---------------------------------------------------------
 //   SpannerMap
 //---------------------------------------------------------
@@ -35,7 +328,7 @@ namespace Ms {
 SpannerMap::SpannerMap()
     : std::multimap<int, Spanner*>()
 {
-    dirty = true;
+    dirty = false;
 }
 
 //---------------------------------------------------------
@@ -45,11 +338,10 @@ SpannerMap::SpannerMap()
 
 void SpannerMap::update() const
 {
-    std::vector<interval_tree::Interval<Spanner*> > intervals;
+    tree.clear();
     for (auto i : *this) {
-        intervals.push_back(interval_tree::Interval<Spanner*>(i.second->tick().ticks(), i.second->tick2().ticks(), i.second));
+        tree.insert(i.second, i.second->tick().ticks(), i.second->tick2().ticks());
     }
-    tree = interval_tree::IntervalTree<Spanner*>(intervals);
     dirty = false;
 }
 
@@ -81,6 +373,26 @@ const std::vector<interval_tree::Interval<Spanner*> >& SpannerMap::findOverlappi
     return results;
 }
 
+void SpannerMap::findOverlapping(int start, int stop, std::vector<interval_tree::Interval<Spanner*> >& result) const
+{
+    result.clear();
+
+    if (!dirty) {
+        tree.findOverlapping(start, stop, result);
+        return;
+    }
+
+    // the tree is outdated, but it can't be rebuilt here;
+    // the keys of the map may be outdated too, so all the spanners are checked
+    for (auto i : *this) {
+        int spannerStart = i.second->tick().ticks();
+        int spannerStop = i.second->tick2().ticks();
+        if (spannerStart <= stop && spannerStop >= start) {
+            result.push_back(interval_tree::Interval<Spanner*>(spannerStart, spannerStop, i.second));
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   addSpanner
 //---------------------------------------------------------
@@ -88,7 +400,9 @@ const std::vector<interval_tree::Interval<Spanner*> >& SpannerMap::findOverlappi
 void SpannerMap::addSpanner(Spanner* s)
 {
     insert(std::pair<int, Spanner*>(s->tick().ticks(), s));
-    dirty = true;
+    if (!dirty) {
+        tree.insert(s, s->tick().ticks(), s->tick2().ticks());
+    }
 }
 
 //---------------------------------------------------------
@@ -97,15 +411,52 @@ void SpannerMap::addSpanner(Spanner* s)
 
 bool SpannerMap::removeSpanner(Spanner* s)
 {
-    for (auto i = begin(); i != end(); ++i) {
-        if (i->second == s) {
-            erase(i);
-            dirty = true;
-            return true;
+    //! NOTE The key is the start tick at the time the spanner was added,
+    //! so look there first
+    auto i = end();
+    auto range = equal_range(s->tick().ticks());
+    for (auto j = range.first; j != range.second; ++j) {
+        if (j->second == s) {
+            i = j;
+            break;
         }
     }
-    LOGD("%s (%p) not found", s->typeName(), s);
-    return false;
+    if (i == end()) {
+        i = std::find_if(begin(), end(), [s](const std::pair<const int, Spanner*>& p) { return p.second == s; });
+    }
+
+    if (i == end()) {
+        LOGD("%s (%p) not found", s->typeName(), s);
+        return false;
+    }
+
+    erase(i);
+    if (!dirty) {
+        tree.remove(s);
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   updateSpanner
+//---------------------------------------------------------
+
+void SpannerMap::updateSpanner(Spanner* s)
+{
+    if (!dirty) {
+        tree.update(s);
+    }
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SpannerMap::clear()
+{
+    std::multimap<int, Spanner*>::clear();
+    tree.clear();
+    dirty = false;
 }
 
 #ifndef NDEBUG
@@ -24,11 +24,68 @@
 #define __SPANNERMAP_H__
 
 #include <map>
+#include <unordered_map>
+#include <vector>
+
 #include "thirdparty/intervaltree/IntervalTree.h"
 
 namespace Ms {
 class Spanner;
 
+//---------------------------------------------------------
+//   SpannerIntervalTree
+//    balanced (AVL) interval tree, every node keeps the
+//    maximal stop tick of its subtree, so the spanners are
+//    inserted and removed without rebuilding the tree
+//---------------------------------------------------------
+
+class SpannerIntervalTree
+{
+public:
+    using Interval = interval_tree::Interval<Spanner*>;
+
+    void clear();
+    size_t size() const { return spannerNodes.size(); }
+
+    void insert(Spanner* s, int start, int stop);
+    bool remove(Spanner* s);
+    void update(Spanner* s);
+
+    void findOverlapping(int start, int stop, std::vector<Interval>& result) const;
+    void findContained(int start, int stop, std::vector<Interval>& result) const;
+
+private:
+    struct Node {
+        int start = 0;
+        int stop = 0;
+        int maxStop = 0;
+        int height = 1;
+        int left = -1;
+        int right = -1;
+        Spanner* spanner = nullptr;
+    };
+
+    bool less(int start, int n, int other) const;
+    int height(int n) const { return n < 0 ? 0 : nodes[n].height; }
+    int balanceFactor(int n) const { return height(nodes[n].left) - height(nodes[n].right); }
+    void updateNode(int n);
+    int rotateLeft(int n);
+    int rotateRight(int n);
+    int rebalance(int n);
+
+    int insertNode(int root, int n);
+    int eraseNode(int root, int start, int n);
+    int eraseMin(int root, int& min);
+
+    void findOverlapping(int n, int start, int stop, std::vector<Interval>& result) const;
+    void findContained(int n, int start, int stop, std::vector<Interval>& result) const;
+
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    std::unordered_multimap<Spanner*, int> spannerNodes;
+    int root = -1;
+};
+
 //---------------------------------------------------------
 //   SpannerMap
 //---------------------------------------------------------
@@ -36,13 +93,16 @@ class Spanner;
 class SpannerMap : std::multimap<int, Spanner*>
 {
     mutable bool dirty;
-    mutable interval_tree::IntervalTree<Spanner*> tree;
+    mutable SpannerIntervalTree tree;
     std::vector<interval_tree::Interval<Spanner*> > results;
 
 public:
     SpannerMap();
     const std::vector<interval_tree::Interval<Spanner*> >& findContained(int start, int stop);
     const std::vector<interval_tree::Interval<Spanner*> >& findOverlapping(int start, int stop);
+    // doesn't modify the map, so it may be called from several threads at once;
+    // the lookup tree is not rebuilt, see update()
+    void findOverlapping(int start, int stop, std::vector<interval_tree::Interval<Spanner*> >& result) const;
     const std::multimap<int, Spanner*>& map() const { return *this; }
     std::multimap<int, Spanner*>::const_reverse_iterator crbegin() const { return std::multimap<int, Spanner*>::crbegin(); }
     std::multimap<int, Spanner*>::const_reverse_iterator crend() const { return std::multimap<int, Spanner*>::crend(); }
@@ -50,9 +110,10 @@ public:
     std::multimap<int, Spanner*>::const_iterator cend() const { return std::multimap<int, Spanner*>::cend(); }
     void addSpanner(Spanner* s);
     bool removeSpanner(Spanner* s);
-    void clear() { std::multimap<int, Spanner*>::clear(); dirty = true; }
+    void updateSpanner(Spanner* s);             // must be called if a spanner changes start/length
+    void clear();
     void update() const;
-    void setDirty() const { dirty = true; }     // must be called if a spanner changes start/length
+    void setDirty() const { dirty = true; }     // rebuilds the lookup tree on the next query
 #ifndef NDEBUG
     void dump() const;
 #endif
@@ -2747,8 +2747,9 @@ bool TextBase::validateText(QString& s)
     QString ss = "<data>" + d + "</data>\n";
     QByteArray ba = ss.toUtf8();
     XmlReader xml(ByteArray::fromRawData(reinterpret_cast<const uint8_t*>(ba.constData()), ba.size()));
-    while (xml.readNextStartElement()) {
-        // LOGD("  token %d <%s>", int(xml.tokenType()), qPrintable(xml.name().toString()));
+    //! NOTE The reader parses on demand, so read the whole document to validate it
+    while (!xml.atEnd()) {
+        xml.readNext();
     }
     if (xml.error() == XmlReader::NoError) {
         s = d;
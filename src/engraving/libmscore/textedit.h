@@ -110,6 +110,7 @@ public:
     virtual void undo(EditData*) override = 0;
     virtual void redo(EditData*) override = 0;
     const QString& string() const { return s; }
+    size_t ownedMemoryUsage() const override { return s.capacity() * sizeof(QChar); }
 };
 
 //---------------------------------------------------------
@@ -34,6 +34,8 @@
 
 #include "undo.h"
 
+#include <typeinfo>
+
 #include "engravingitem.h"
 #include "note.h"
 #include "score.h"
@@ -90,6 +92,11 @@
 #include "textedit.h"
 #include "textline.h"
 #include "linkedobjects.h"
+#include "stem.h"
+#include "hook.h"
+#include "notedot.h"
+#include "ledgerline.h"
+#include "lyrics.h"
 
 #include "masterscore.h"
 
@@ -253,6 +260,166 @@ void UndoCommand::filterChildren(UndoCommand::Filter f, EngravingItem* target)
     childList = std::move(acceptedList);
 }
 
+//---------------------------------------------------------
+//   memoryUsage
+//---------------------------------------------------------
+
+size_t UndoCommand::memoryUsage() const
+{
+    size_t result = selfMemoryUsage();
+    for (const UndoCommand* cmd : childList) {
+        result += cmd->memoryUsage();
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   objectClassSize
+//    size of the most derived class of the object, the
+//    frequent types are listed explicitly, the others
+//    are estimated by their base class
+//---------------------------------------------------------
+
+static size_t objectClassSize(const EngravingObject* obj)
+{
+    switch (obj->type()) {
+    case ElementType::SCORE:        return sizeof(Score);
+    case ElementType::PART:         return sizeof(Part);
+    case ElementType::STAFF:        return sizeof(Staff);
+    case ElementType::PAGE:         return sizeof(Page);
+    case ElementType::SYSTEM:       return sizeof(System);
+    case ElementType::MEASURE:      return sizeof(Measure);
+    case ElementType::SEGMENT:      return sizeof(Segment);
+    case ElementType::CHORD:        return sizeof(Chord);
+    case ElementType::NOTE:         return sizeof(Note);
+    case ElementType::REST:         return sizeof(Rest);
+    case ElementType::ACCIDENTAL:   return sizeof(Accidental);
+    case ElementType::STEM:         return sizeof(Stem);
+    case ElementType::HOOK:         return sizeof(Hook);
+    case ElementType::BEAM:         return sizeof(Beam);
+    case ElementType::NOTEDOT:      return sizeof(NoteDot);
+    case ElementType::LEDGER_LINE:  return sizeof(LedgerLine);
+    case ElementType::ARTICULATION: return sizeof(Articulation);
+    case ElementType::TIE:          return sizeof(Tie);
+    case ElementType::SLUR:         return sizeof(Slur);
+    case ElementType::CLEF:         return sizeof(Clef);
+    case ElementType::KEYSIG:       return sizeof(KeySig);
+    case ElementType::TIMESIG:      return sizeof(TimeSig);
+    case ElementType::BAR_LINE:     return sizeof(BarLine);
+    case ElementType::STAFF_LINES:  return sizeof(StaffLines);
+    case ElementType::TUPLET:       return sizeof(Tuplet);
+    case ElementType::HARMONY:      return sizeof(Harmony);
+    case ElementType::DYNAMIC:      return sizeof(Dynamic);
+    case ElementType::LYRICS:       return sizeof(Lyrics);
+    case ElementType::FINGERING:    return sizeof(Fingering);
+    case ElementType::HAIRPIN:      return sizeof(Hairpin);
+    case ElementType::IMAGE:        return sizeof(Image);
+    default:
+        break;
+    }
+
+    if (obj->isTextBase()) {
+        return sizeof(TextBase);
+    } else if (obj->isSLineSegment()) {
+        return sizeof(LineSegment);
+    } else if (obj->isSLine()) {
+        return sizeof(SLine);
+    } else if (obj->isEngravingItem()) {
+        return sizeof(EngravingItem);
+    }
+    return sizeof(EngravingObject);
+}
+
+//---------------------------------------------------------
+//   objectContainersSize
+//    heap memory of the containers of the object,
+//    except the owned objects themselves
+//---------------------------------------------------------
+
+static size_t objectContainersSize(const EngravingObject* obj)
+{
+    // the nodes of the children list
+    size_t result = obj->children().size() * 3 * sizeof(void*);
+
+    switch (obj->type()) {
+    case ElementType::MEASURE:
+        result += obj->score()->nstaves() * (sizeof(MStaff) + sizeof(MStaff*));
+        break;
+    case ElementType::SEGMENT: {
+        const Segment* segment = toSegment(obj);
+        result += (segment->elist().capacity() + segment->annotations().capacity()) * sizeof(EngravingItem*);
+    } break;
+    case ElementType::CHORD: {
+        const Chord* chord = toChord(obj);
+        result += chord->notes().capacity() * sizeof(Note*);
+        result += chord->graceNotes().capacity() * sizeof(Chord*);
+        result += chord->articulations().capacity() * sizeof(Articulation*);
+    } break;
+    case ElementType::NOTE: {
+        const Note* note = toNote(obj);
+        result += note->playEvents().capacity() * sizeof(NoteEvent);
+        result += note->el().capacity() * sizeof(EngravingItem*);
+        result += (note->spannerFor().capacity() + note->spannerBack().capacity()) * sizeof(Spanner*);
+    } break;
+    default:
+        break;
+    }
+
+    if (obj->isTextBase()) {
+        // the xml text and the laid out text blocks
+        result += 2 * toTextBase(obj)->xmlText().capacity() * sizeof(QChar);
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   objectMemoryUsage
+//    estimated memory of the object and of the tree of
+//    the objects owned by it
+//---------------------------------------------------------
+
+static size_t objectMemoryUsage(const EngravingObject* obj)
+{
+    if (!obj) {
+        return 0;
+    }
+
+    size_t result = objectClassSize(obj) + objectContainersSize(obj);
+    for (const EngravingObject* child : obj->children()) {
+        result += objectMemoryUsage(child);
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   mergePropertyChanges
+//---------------------------------------------------------
+
+void UndoCommand::mergePropertyChanges()
+{
+    auto isPropertyChange = [](const UndoCommand* cmd) {
+        // not the subclasses: they change other objects
+        return typeid(*cmd) == typeid(ChangeProperty) && cmd->childCount() == 0;
+    };
+
+    auto prev = childList.end();
+    for (auto it = childList.begin(); it != childList.end();) {
+        if (prev != childList.end() && isPropertyChange(*prev) && isPropertyChange(*it)) {
+            const ChangeProperty* first = static_cast<const ChangeProperty*>(*prev);
+            const ChangeProperty* next = static_cast<const ChangeProperty*>(*it);
+
+            if (first->getElement() == next->getElement() && first->getId() == next->getId()) {
+                delete *it;
+                it = childList.erase(it);
+                continue;
+            }
+        }
+
+        prev = it;
+        ++it;
+    }
+}
+
 //---------------------------------------------------------
 //   unwind
 //---------------------------------------------------------
@@ -278,6 +445,7 @@ UndoStack::UndoStack()
     cleanState = 0;
     stateList.push_back(cleanState);
     nextState = 1;
+    m_memoryLimit = MScore::undoHistoryMemoryLimit;
 }
 
 //---------------------------------------------------------
@@ -380,6 +548,9 @@ void UndoStack::remove(size_t idx)
 
 void UndoStack::mergeCommands(size_t startIdx)
 {
+    // the index is counted from the beginning of the whole history
+    startIdx = startIdx > m_removedCount ? startIdx - m_removedCount : 0;
+
     Q_ASSERT(startIdx <= curIdx);
 
     if (startIdx >= list.size()) {
@@ -392,6 +563,9 @@ void UndoStack::mergeCommands(size_t startIdx)
         startMacro->append(std::move(*list[idx]));
     }
     remove(startIdx + 1);   // TODO: remove from startIdx to curIdx only
+
+    startMacro->mergePropertyChanges();
+    startMacro->updateMemoryUsage();
 }
 
 //---------------------------------------------------------
@@ -444,11 +618,16 @@ void UndoStack::endMacro(bool rollback)
             cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
             delete cmd;
         }
+        curCmd->mergePropertyChanges();
+        curCmd->updateMemoryUsage();
+
         list.push_back(curCmd);
         stateList.push_back(nextState++);
         ++curIdx;
     }
     curCmd = 0;
+
+    limitMemoryUsage();
 }
 
 //---------------------------------------------------------
@@ -477,6 +656,64 @@ void UndoStack::setClean()
     cleanState = state();
 }
 
+//---------------------------------------------------------
+//   setMemoryLimit
+//---------------------------------------------------------
+
+void UndoStack::setMemoryLimit(size_t bytes)
+{
+    m_memoryLimit = bytes;
+    limitMemoryUsage();
+}
+
+//---------------------------------------------------------
+//   memoryUsage
+//---------------------------------------------------------
+
+size_t UndoStack::memoryUsage() const
+{
+    size_t result = 0;
+    for (const UndoMacro* macro : list) {
+        result += macro->memoryUsage();
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   limitMemoryUsage
+//    removes the oldest macros, the last done macro is always kept
+//---------------------------------------------------------
+
+void UndoStack::limitMemoryUsage()
+{
+    if (m_memoryLimit == 0 || curCmd) {
+        return;
+    }
+
+    size_t usage = memoryUsage();
+    size_t count = 0;
+    while (usage > m_memoryLimit && count + 1 < curIdx) {
+        usage -= list[count]->memoryUsage();
+        ++count;
+    }
+
+    if (count == 0) {
+        return;
+    }
+
+    for (size_t idx = 0; idx < count; ++idx) {
+        list[idx]->cleanup(true);
+        delete list[idx];
+    }
+
+    list.erase(list.begin(), list.begin() + count);
+    stateList.erase(stateList.begin(), stateList.begin() + count);
+    curIdx -= count;
+    m_removedCount += count;
+
+    LOGI() << "removed the oldest " << count << " undo steps, memory usage: " << usage << " bytes";
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -487,7 +724,7 @@ void UndoStack::undo(EditData* ed)
     // Are we currently editing text?
     if (ed && ed->element && ed->element->isTextBase()) {
         TextEditData* ted = static_cast<TextEditData*>(ed->getData(ed->element).get());
-        if (ted && ted->startUndoIdx == curIdx) {
+        if (ted && ted->startUndoIdx == getCurIdx()) {
             // No edits to undo, so do nothing
             return;
         }
@@ -576,6 +813,11 @@ void UndoMacro::undo(EditData* ed)
     }
 }
 
+void UndoMacro::updateMemoryUsage()
+{
+    m_memoryUsage = UndoCommand::memoryUsage();
+}
+
 void UndoMacro::redo(EditData* ed)
 {
     m_undoInputState = m_score->inputState();
@@ -847,6 +1089,18 @@ void AddElement::redo(EditData*)
     endUndoRedo(false);
 }
 
+//---------------------------------------------------------
+//   selfMemoryUsage
+//    the element is owned by the command while it is not
+//    in the score, it is counted always to keep the
+//    estimate the same after undo and redo
+//---------------------------------------------------------
+
+size_t AddElement::selfMemoryUsage() const
+{
+    return sizeof(*this) + objectMemoryUsage(element);
+}
+
 //---------------------------------------------------------
 //   name
 //---------------------------------------------------------
@@ -999,6 +1253,18 @@ void RemoveElement::redo(EditData*)
     }
 }
 
+//---------------------------------------------------------
+//   selfMemoryUsage
+//    the element is owned by the command while it is not
+//    in the score, it is counted always to keep the
+//    estimate the same after undo and redo
+//---------------------------------------------------------
+
+size_t RemoveElement::selfMemoryUsage() const
+{
+    return sizeof(*this) + objectMemoryUsage(element);
+}
+
 //---------------------------------------------------------
 //   name
 //---------------------------------------------------------
@@ -1055,6 +1321,15 @@ void InsertPart::redo(EditData*)
     part->score()->insertPart(part, idx);
 }
 
+//---------------------------------------------------------
+//   InsertPart::ownedMemoryUsage
+//---------------------------------------------------------
+
+size_t InsertPart::ownedMemoryUsage() const
+{
+    return objectMemoryUsage(part);
+}
+
 //---------------------------------------------------------
 //   RemovePart
 //---------------------------------------------------------
@@ -1075,6 +1350,15 @@ void RemovePart::redo(EditData*)
     part->score()->removePart(part);
 }
 
+//---------------------------------------------------------
+//   RemovePart::ownedMemoryUsage
+//---------------------------------------------------------
+
+size_t RemovePart::ownedMemoryUsage() const
+{
+    return objectMemoryUsage(part);
+}
+
 //---------------------------------------------------------
 //   SetSoloist
 //---------------------------------------------------------
@@ -1115,6 +1399,15 @@ void InsertStaff::redo(EditData*)
     staff->score()->insertStaff(staff, ridx);
 }
 
+//---------------------------------------------------------
+//   InsertStaff::ownedMemoryUsage
+//---------------------------------------------------------
+
+size_t InsertStaff::ownedMemoryUsage() const
+{
+    return objectMemoryUsage(staff);
+}
+
 //---------------------------------------------------------
 //   RemoveStaff
 //---------------------------------------------------------
@@ -1135,6 +1428,15 @@ void RemoveStaff::redo(EditData*)
     staff->score()->removeStaff(staff);
 }
 
+//---------------------------------------------------------
+//   RemoveStaff::ownedMemoryUsage
+//---------------------------------------------------------
+
+size_t RemoveStaff::ownedMemoryUsage() const
+{
+    return objectMemoryUsage(staff);
+}
+
 //---------------------------------------------------------
 //   InsertMStaff
 //---------------------------------------------------------
@@ -1376,6 +1678,15 @@ void ChangeElement::flip(EditData*)
     // score->setLayoutAll();
 }
 
+//---------------------------------------------------------
+//   ChangeElement::ownedMemoryUsage
+//---------------------------------------------------------
+
+size_t ChangeElement::ownedMemoryUsage() const
+{
+    return objectMemoryUsage(oldElement) + objectMemoryUsage(newElement);
+}
+
 //---------------------------------------------------------
 //   InsertStaves
 //---------------------------------------------------------
@@ -1605,6 +1916,15 @@ void EditText::redo(EditData*)
     undoRedo();
 }
 
+//---------------------------------------------------------
+//   EditText::ownedMemoryUsage
+//---------------------------------------------------------
+
+size_t EditText::ownedMemoryUsage() const
+{
+    return oldText.capacity() * sizeof(QChar);
+}
+
 //---------------------------------------------------------
 //   EditText::undoRedo
 //---------------------------------------------------------
@@ -1836,6 +2156,19 @@ void ChangeStyle::flip(EditData*)
     style = tmp;
 }
 
+//---------------------------------------------------------
+//   ChangeStyle::ownedMemoryUsage
+//---------------------------------------------------------
+
+size_t ChangeStyle::ownedMemoryUsage() const
+{
+    size_t result = 0;
+    for (int i = 0; i < static_cast<int>(Sid::STYLES); ++i) {
+        result += style.value(Sid(i)).heapMemoryUsage();
+    }
+    return result;
+}
+
 void ChangeStyle::undo(EditData* ed)
 {
     overlap = false;
@@ -1884,6 +2217,15 @@ void ChangeStyleVal::flip(EditData*)
     value = v;
 }
 
+//---------------------------------------------------------
+//   ChangeStyleVal::ownedMemoryUsage
+//---------------------------------------------------------
+
+size_t ChangeStyleVal::ownedMemoryUsage() const
+{
+    return value.heapMemoryUsage();
+}
+
 //---------------------------------------------------------
 //   ChangePageNumberOffset::flip
 //---------------------------------------------------------
@@ -2170,6 +2512,22 @@ void InsertRemoveMeasures::removeMeasures()
     score->setLayoutAll();
 }
 
+//---------------------------------------------------------
+//   InsertRemoveMeasures::ownedMemoryUsage
+//---------------------------------------------------------
+
+size_t InsertRemoveMeasures::ownedMemoryUsage() const
+{
+    size_t result = 0;
+    for (MeasureBase* mb = fm; mb; mb = mb->next()) {
+        result += objectMemoryUsage(mb);
+        if (mb == lm) {
+            break;
+        }
+    }
+    return result;
+}
+
 AddExcerpt::AddExcerpt(Excerpt* ex)
     : excerpt(ex)
 {}
@@ -2202,6 +2560,15 @@ void AddExcerpt::redo(EditData*)
     excerpt->masterScore()->addExcerpt(excerpt);
 }
 
+//---------------------------------------------------------
+//   AddExcerpt::ownedMemoryUsage
+//---------------------------------------------------------
+
+size_t AddExcerpt::ownedMemoryUsage() const
+{
+    return sizeof(Excerpt) + objectMemoryUsage(excerpt->excerptScore());
+}
+
 //---------------------------------------------------------
 //   RemoveExcerpt
 //---------------------------------------------------------
@@ -2240,6 +2607,15 @@ void RemoveExcerpt::redo(EditData*)
     excerpt->masterScore()->removeExcerpt(excerpt);
 }
 
+//---------------------------------------------------------
+//   RemoveExcerpt::ownedMemoryUsage
+//---------------------------------------------------------
+
+size_t RemoveExcerpt::ownedMemoryUsage() const
+{
+    return sizeof(Excerpt) + objectMemoryUsage(excerpt->excerptScore());
+}
+
 //---------------------------------------------------------
 //   SwapExcerpt::flip
 //---------------------------------------------------------
@@ -2442,6 +2818,15 @@ void ChangeProperty::flip(EditData*)
     flags = ps;
 }
 
+//---------------------------------------------------------
+//   ChangeProperty::ownedMemoryUsage
+//---------------------------------------------------------
+
+size_t ChangeProperty::ownedMemoryUsage() const
+{
+    return property.heapMemoryUsage();
+}
+
 //---------------------------------------------------------
 //   ChangeBracketProperty::flip
 //---------------------------------------------------------
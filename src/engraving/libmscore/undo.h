@@ -103,7 +103,9 @@ enum class PlayEventType : char;
 class Excerpt;
 class EditData;
 
-#define UNDO_NAME(a) const char* name() const override { return a; }
+#define UNDO_NAME(a) \
+    const char* name() const override { return a; } \
+    size_t selfMemoryUsage() const override { return sizeof(*this) + ownedMemoryUsage(); }
 #define UNDO_CHANGED_OBJECTS(...) std::vector<const EngravingObject*> objectItems() const override { return __VA_ARGS__; }
 
 //---------------------------------------------------------
@@ -117,6 +119,9 @@ class UndoCommand
 protected:
     virtual void flip(EditData*) {}
     void appendChildren(UndoCommand*);
+    virtual size_t selfMemoryUsage() const { return sizeof(UndoCommand); }
+    //! NOTE Estimated memory of the objects kept by the command (ex. the removed elements), see UNDO_NAME
+    virtual size_t ownedMemoryUsage() const { return 0; }
 
 public:
     enum class Filter {
@@ -143,6 +148,12 @@ public:
     virtual const char* name() const { return "UndoCommand"; }
 // #endif
 
+    //! Estimated memory used by the command and its children, in bytes
+    virtual size_t memoryUsage() const;
+    //! Leaves only the first of the consecutive changes of the same property of the same object,
+    //! undoing it restores the value before all of them, redoing it sets the value after all of them
+    void mergePropertyChanges();
+
     virtual bool isFiltered(Filter, const EngravingItem* /* target */) const { return false; }
     bool hasFilteredChildren(Filter, const EngravingItem* target) const;
     bool hasUnfilteredChildren(const std::vector<Filter>& filters, const EngravingItem* target) const;
@@ -181,6 +192,10 @@ public:
 
     std::unordered_set<ElementType> changedTypes() const;
 
+    //! NOTE Calculated when the macro is ended, see updateMemoryUsage
+    size_t memoryUsage() const override { return m_memoryUsage; }
+    void updateMemoryUsage();
+
     static bool canRecordSelectedElement(const EngravingItem* e);
 
     UNDO_NAME("UndoMacro");
@@ -192,6 +207,7 @@ private:
     SelectionInfo m_redoSelectionInfo;
 
     Score* m_score = nullptr;
+    size_t m_memoryUsage = 0;
 
     static void fillSelectionInfo(SelectionInfo&, const Selection&);
     static void applySelectionInfo(const SelectionInfo&, Selection&);
@@ -210,7 +226,13 @@ class UndoStack
     int cleanState;
     size_t curIdx = 0;
 
+    size_t m_memoryLimit = 0;
+    //! NOTE The macros removed from the beginning of the list because of the memory limit,
+    //! the indices returned by getCurIdx() and accepted by mergeCommands() don't change after that
+    size_t m_removedCount = 0;
+
     void remove(size_t idx);
+    void limitMemoryUsage();
 
 public:
     UndoStack();
@@ -227,7 +249,7 @@ public:
     bool canRedo() const { return curIdx < list.size(); }
     int state() const { return stateList[curIdx]; }
     bool isClean() const { return cleanState == state(); }
-    size_t getCurIdx() const { return curIdx; }
+    size_t getCurIdx() const { return m_removedCount + curIdx; }
     bool empty() const { return !canUndo() && !canRedo(); }
     UndoMacro* current() const { return curCmd; }
     UndoMacro* last() const { return curIdx > 0 ? list[curIdx - 1] : 0; }
@@ -239,6 +261,11 @@ public:
 
     void mergeCommands(size_t startIdx);
     void cleanRedoStack() { remove(curIdx); }
+
+    //! The oldest macros are removed when the memory used by the history exceeds the limit, 0 - no limit
+    size_t memoryLimit() const { return m_memoryLimit; }
+    void setMemoryLimit(size_t bytes);
+    size_t memoryUsage() const;
 };
 
 //---------------------------------------------------------
@@ -256,6 +283,7 @@ public:
     void redo(EditData*) override;
 
     UNDO_NAME("InsertPart")
+    size_t ownedMemoryUsage() const override;
     UNDO_CHANGED_OBJECTS({ part });
 };
 
@@ -273,6 +301,7 @@ public:
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
     UNDO_NAME("RemovePart")
+    size_t ownedMemoryUsage() const override;
     UNDO_CHANGED_OBJECTS({ part });
 };
 
@@ -307,6 +336,7 @@ public:
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
     UNDO_NAME("InsertStaff")
+    size_t ownedMemoryUsage() const override;
     UNDO_CHANGED_OBJECTS({ staff });
 };
 
@@ -324,6 +354,7 @@ public:
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
     UNDO_NAME("RemoveStaff")
+    size_t ownedMemoryUsage() const override;
     UNDO_CHANGED_OBJECTS({ staff });
 };
 
@@ -521,6 +552,7 @@ class ChangeElement : public UndoCommand
 public:
     ChangeElement(EngravingItem* oldElement, EngravingItem* newElement);
     UNDO_NAME("ChangeElement")
+    size_t ownedMemoryUsage() const override;
     UNDO_CHANGED_OBJECTS({ oldElement, newElement });
 };
 
@@ -648,6 +680,7 @@ public:
     EngravingItem* getElement() const { return element; }
     virtual void cleanup(bool) override;
     virtual const char* name() const override;
+    size_t selfMemoryUsage() const override;
 
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override;
 
@@ -668,6 +701,7 @@ public:
     virtual void redo(EditData*) override;
     virtual void cleanup(bool) override;
     virtual const char* name() const override;
+    size_t selfMemoryUsage() const override;
 
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override;
 
@@ -692,6 +726,7 @@ public:
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
     UNDO_NAME("EditText")
+    size_t ownedMemoryUsage() const override;
     UNDO_CHANGED_OBJECTS({ text });
 };
 
@@ -810,6 +845,7 @@ class ChangeStyle : public UndoCommand
 public:
     ChangeStyle(Score*, const MStyle&, const bool overlapOnly = false);
     UNDO_NAME("ChangeStyle")
+    size_t ownedMemoryUsage() const override;
     UNDO_CHANGED_OBJECTS({ score });
 };
 
@@ -829,6 +865,7 @@ public:
     ChangeStyleVal(Score* s, Sid i, const mu::engraving::PropertyValue& v)
         : score(s), idx(i), value(v) {}
     UNDO_NAME("ChangeStyleVal")
+    size_t ownedMemoryUsage() const override;
     UNDO_CHANGED_OBJECTS({ score });
 };
 
@@ -922,6 +959,7 @@ public:
     virtual void undo(EditData*) override = 0;
     virtual void redo(EditData*) override = 0;
     UNDO_CHANGED_OBJECTS({ fm, lm });
+    size_t ownedMemoryUsage() const override;
 };
 
 //---------------------------------------------------------
@@ -968,6 +1006,7 @@ public:
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
     UNDO_NAME("AddExcerpt")
+    size_t ownedMemoryUsage() const override;
 };
 
 //---------------------------------------------------------
@@ -987,6 +1026,7 @@ public:
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
     UNDO_NAME("RemoveExcerpt")
+    size_t ownedMemoryUsage() const override;
 };
 
 //---------------------------------------------------------
@@ -1198,6 +1238,7 @@ public:
     EngravingObject* getElement() const { return element; }
     mu::engraving::PropertyValue data() const { return property; }
     UNDO_NAME("ChangeProperty")
+    size_t ownedMemoryUsage() const override;
     UNDO_CHANGED_OBJECTS({ element });
 
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override
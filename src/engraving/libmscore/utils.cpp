@@ -22,6 +22,7 @@
 
 #include "utils.h"
 
+#include <algorithm>
 #include <cmath>
 #include <QtMath>
 #include <QRegularExpression>
@@ -62,34 +63,91 @@ RectF handleRect(const PointF& pos)
 }
 
 //---------------------------------------------------------
-//   tick2measure
+//   measureTickIndex
+//    rebuilds the index if the measure list or the
+//    multi measure rest setting changed since the last lookup
 //---------------------------------------------------------
 
-Measure* Score::tick2measure(const Fraction& tick) const
+const MeasureTickIndex& Score::measureTickIndex(bool mmRests) const
 {
-    if (tick == Fraction(-1, 1)) {   // special number
-        return lastMeasure();
+    MeasureTickIndex& index = mmRests ? _tickIndexMM : _tickIndex;
+    bool createMMRests = mmRests && styleB(Sid::createMultiMeasureRests);
+
+    if (index.valid && index.revision == _measures.revision() && index.mmRests == createMMRests) {
+        return index;
     }
-    if (tick <= Fraction(0, 1)) {
-        return firstMeasure();
+
+    index.measures.clear();
+    index.ticks.clear();
+    index.sorted = true;
+
+    Measure* m = mmRests ? firstMeasureMM() : firstMeasure();
+    while (m) {
+        Fraction tick = m->tick();
+        if (!index.ticks.empty() && tick < index.ticks.back()) {
+            index.sorted = false;
+        }
+        index.measures.push_back(m);
+        index.ticks.push_back(tick);
+        m = mmRests ? m->nextMeasureMM() : m->nextMeasure();
     }
 
-    Measure* lm = 0;
-    for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
-        if (tick < m->tick()) {
-            Q_ASSERT(lm);
-            return lm;
+    index.valid = true;
+    index.mmRests = createMMRests;
+    index.revision = _measures.revision();
+
+    return index;
+}
+
+//---------------------------------------------------------
+//   findMeasure
+//    returns the last measure starting at or before tick,
+//    the same as walking the measure list
+//---------------------------------------------------------
+
+static Measure* findMeasure(const MeasureTickIndex& index, const Fraction& tick, const char* name)
+{
+    const std::vector<Fraction>& ticks = index.ticks;
+    size_t i = 0;
+    if (index.sorted) {
+        i = std::upper_bound(ticks.begin(), ticks.end(), tick) - ticks.begin();
+    } else {
+        //! NOTE The ticks are not fixed yet (ex. in the middle of an edit)
+        while (i < ticks.size() && !(tick < ticks[i])) {
+            ++i;
         }
-        lm = m;
     }
+
+    if (i < ticks.size()) {
+        Q_ASSERT(i > 0);
+        return i > 0 ? index.measures[i - 1] : nullptr;
+    }
+
     // check last measure
+    Measure* lm = index.measures.empty() ? nullptr : index.measures.back();
     if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
         return lm;
     }
-    LOGD("tick2measure %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
+    LOGD("%s %d (max %d) not found", name, tick.ticks(), lm ? lm->tick().ticks() : -1);
     return 0;
 }
 
+//---------------------------------------------------------
+//   tick2measure
+//---------------------------------------------------------
+
+Measure* Score::tick2measure(const Fraction& tick) const
+{
+    if (tick == Fraction(-1, 1)) {   // special number
+        return lastMeasure();
+    }
+    if (tick <= Fraction(0, 1)) {
+        return firstMeasure();
+    }
+
+    return findMeasure(measureTickIndex(false), tick, "tick2measure");
+}
+
 //---------------------------------------------------------
 //   tick2measureMM
 //---------------------------------------------------------
@@ -104,21 +162,7 @@ Measure* Score::tick2measureMM(const Fraction& t) const
         tick = Fraction(0, 1);
     }
 
-    Measure* lm = 0;
-
-    for (Measure* m = firstMeasureMM(); m; m = m->nextMeasureMM()) {
-        if (tick < m->tick()) {
-            Q_ASSERT(lm);
-            return lm;
-        }
-        lm = m;
-    }
-    // check last measure
-    if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
-        return lm;
-    }
-    LOGD("tick2measureMM %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
-    return 0;
+    return findMeasure(measureTickIndex(true), tick, "tick2measureMM");
 }
 
 //---------------------------------------------------------
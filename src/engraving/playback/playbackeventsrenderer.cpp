@@ -77,6 +77,8 @@ void PlaybackEventsRenderer::render(const Ms::EngravingItem* item, const mpe::ti
         return;
     }
 
+    //! NOTE The event list returned by result[] stays valid only until the next key is inserted into result,
+    //! so it's taken for each call and filled in right away
     if (item->type() == Ms::ElementType::CHORD) {
         const Ms::Chord* chord = Ms::toChord(item);
 
@@ -163,6 +165,8 @@ void PlaybackEventsRenderer::renderNoteEvents(const Ms::Chord* chord, const int
 
     ChordArticulationsParser::buildChordArticulationMap(chord, ctx, ctx.commonArticulations);
 
+    //! NOTE renderArticulations() only fills in the given list, it doesn't insert anything into result,
+    //! so the reference returned by result[] stays valid
     renderArticulations(chord, ctx, result[ctx.nominalTimestamp]);
 }
 
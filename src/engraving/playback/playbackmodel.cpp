@@ -22,6 +22,9 @@
 
 #include "playbackmodel.h"
 
+#include <atomic>
+#include <thread>
+
 #include <QString>
 
 #include "libmscore/score.h"
@@ -36,6 +39,9 @@
 
 #include "utils/pitchutils.h"
 
+#include "runtime.h"
+#include "log.h"
+
 using namespace mu;
 using namespace mu::engraving;
 using namespace mu::mpe;
@@ -70,7 +76,15 @@ void PlaybackModel::load(Ms::Score* score)
         notifyAboutChanges(std::move(trackChanges), std::move(existingTracks));
     });
 
-    update(0, m_score->lastMeasure()->endTick().ticks(), 0, m_score->ntracks());
+    TRACEFUNC;
+
+    updateSetupData();
+    updateContext(0, m_score->ntracks());
+
+    //! NOTE The parts are rendered in parallel, but load() returns only when all of them are rendered,
+    //! so the tracks are announced once everything is ready. The score can be edited on this thread
+    //! as soon as load() returns, so rendering can't continue in the background
+    updateEventsInParallel(0, m_score->lastMeasure()->endTick().ticks());
 
     for (const auto& pair : m_playbackDataMap) {
         m_trackAdded.send(pair.first);
@@ -94,7 +108,9 @@ void PlaybackModel::reload()
         pair.second.originEvents.clear();
     }
 
-    update(tickFrom, tickTo, trackFrom, trackTo);
+    updateSetupData();
+    updateContext(trackFrom, trackTo);
+    updateEventsInParallel(tickFrom, tickTo);
 
     for (auto& pair : m_playbackDataMap) {
         pair.second.mainStream.send(pair.second.originEvents);
@@ -240,6 +256,102 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
                                  ChangedTrackIdSet* trackChanges)
 {
     std::set<Ms::ID> changedPartIdSet = m_score->partIdsFromRange(trackFrom, trackTo);
+    TrackProfilesMap profiles = resolveProfiles(changedPartIdSet);
+
+    TrackEventsMap result;
+    renderEvents(tickFrom, tickTo, 0, m_score->ntracks(), changedPartIdSet, profiles, true /*withMetronome*/, result);
+
+    for (auto& pair : result) {
+        mergeEvents(std::move(pair.second), m_playbackDataMap[pair.first].originEvents);
+        collectChangesTracks(pair.first, trackChanges);
+    }
+}
+
+void PlaybackModel::updateEventsInParallel(const int tickFrom, const int tickTo)
+{
+    TRACEFUNC;
+
+    std::vector<const Ms::Part*> parts = m_score->parts();
+    std::set<Ms::ID> partIdSet;
+    for (const Ms::Part* part : parts) {
+        partIdSet.insert(part->id());
+    }
+
+    //! NOTE The profiles repository, the contexts and the repeat list (unwound lazily) are not thread safe,
+    //! so everything the workers need is prepared here
+    TrackProfilesMap profiles = resolveProfiles(partIdSet);
+    repeatList();
+
+    size_t threadsCount = std::min(static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1u)), parts.size());
+
+    std::vector<TrackEventsMap> partsEvents(parts.size());
+    std::atomic<size_t> next = 0;
+
+    auto renderParts = [&]() {
+        for (size_t idx = next.fetch_add(1); idx < parts.size(); idx = next.fetch_add(1)) {
+            TRACEFUNC_C("render part events");
+
+            const Ms::Part* part = parts.at(idx);
+            renderEvents(tickFrom, tickTo, part->startTrack(), part->endTrack(), { part->id() }, profiles, false /*withMetronome*/,
+                         partsEvents[idx]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    if (threadsCount > 1) {
+        for (size_t i = 0; i < threadsCount; ++i) {
+            threads.emplace_back([&renderParts]() {
+                runtime::setThreadName("playback_render");
+                renderParts();
+            });
+        }
+    }
+
+    //! NOTE The metronome is rendered here, while the workers render the parts
+    TrackEventsMap metronomeEvents;
+    renderEvents(tickFrom, tickTo, 0, 0, {}, profiles, true /*withMetronome*/, metronomeEvents);
+
+    //! NOTE Helps the workers, or renders everything if there are none
+    renderParts();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    //! NOTE The events are merged in the order of the parts, so the result doesn't depend on the threads
+    for (TrackEventsMap& partEvents : partsEvents) {
+        for (auto& pair : partEvents) {
+            mergeEvents(std::move(pair.second), m_playbackDataMap[pair.first].originEvents);
+        }
+    }
+
+    for (auto& pair : metronomeEvents) {
+        mergeEvents(std::move(pair.second), m_playbackDataMap[pair.first].originEvents);
+    }
+}
+
+PlaybackModel::TrackProfilesMap PlaybackModel::resolveProfiles(const std::set<Ms::ID>& partIdSet)
+{
+    TrackProfilesMap result;
+
+    for (const Ms::Part* part : m_score->parts()) {
+        if (partIdSet.find(part->id()) == partIdSet.cend()) {
+            continue;
+        }
+
+        for (const InstrumentTrackId& trackId : part->instrumentTrackIdSet()) {
+            result.emplace(trackId, profilesRepository()->defaultProfile(m_playbackDataMap[trackId].setupData.category));
+        }
+    }
+
+    return result;
+}
+
+void PlaybackModel::renderEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
+                                 const std::set<Ms::ID>& partIdSet, const TrackProfilesMap& profiles, const bool withMetronome,
+                                 TrackEventsMap& result) const
+{
+    static const PlaybackContext emptyCtx;
 
     for (const Ms::RepeatSegment* repeatSegment : repeatList()) {
         int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
@@ -270,14 +382,19 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
                     continue;
                 }
 
-                for (const Ms::EngravingItem* item : segment->elist()) {
+                const std::vector<Ms::EngravingItem*>& elist = segment->elist();
+                track_idx_t elistTrackTo = std::min(trackTo, static_cast<track_idx_t>(elist.size()));
+
+                for (track_idx_t track = trackFrom; track < elistTrackTo; ++track) {
+                    const Ms::EngravingItem* item = elist.at(track);
+
                     if (!item || !item->isChordRest() || !item->part()) {
                         continue;
                     }
 
                     Ms::ID partId = item->part()->id();
 
-                    if (changedPartIdSet.find(partId) == changedPartIdSet.cend()) {
+                    if (partIdSet.find(partId) == partIdSet.cend()) {
                         continue;
                     }
 
@@ -287,9 +404,11 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
                         continue;
                     }
 
-                    const PlaybackContext& ctx = m_playbackCtxMap[trackId];
+                    auto ctxSearch = m_playbackCtxMap.find(trackId);
+                    const PlaybackContext& ctx = ctxSearch != m_playbackCtxMap.cend() ? ctxSearch->second : emptyCtx;
 
-                    ArticulationsProfilePtr profile = profilesRepository()->defaultProfile(m_playbackDataMap[trackId].setupData.category);
+                    auto profileSearch = profiles.find(trackId);
+                    ArticulationsProfilePtr profile = profileSearch != profiles.cend() ? profileSearch->second : nullptr;
                     if (!profile) {
                         LOGE() << "unsupported instrument family: " << partId;
                         continue;
@@ -297,17 +416,39 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
 
                     m_renderer.render(item, tickPositionOffset, ctx.appliableDynamicLevel(segmentStartTick + tickPositionOffset),
                                       ctx.persistentArticulationType(segmentStartTick + tickPositionOffset), std::move(profile),
-                                      m_playbackDataMap[trackId].originEvents);
+                                      result[trackId]);
+                }
 
-                    collectChangesTracks(trackId, trackChanges);
+                if (withMetronome) {
+                    m_renderer.renderMetronome(m_score, segmentStartTick, segment->ticks().ticks(),
+                                               tickPositionOffset, result[METRONOME_TRACK_ID]);
                 }
+            }
+        }
+    }
+}
 
-                m_renderer.renderMetronome(m_score, segmentStartTick, segment->ticks().ticks(),
-                                           tickPositionOffset, m_playbackDataMap[METRONOME_TRACK_ID].originEvents);
-                collectChangesTracks(METRONOME_TRACK_ID, trackChanges);
+void PlaybackModel::mergeEvents(mpe::PlaybackEventsMap&& events, mpe::PlaybackEventsMap& result)
+{
+    //! NOTE The curves are interned here, on the calling thread, once the events are rendered
+    for (auto& pair : events) {
+        for (PlaybackEvent& event : pair.second) {
+            if (NoteEvent* noteEvent = std::get_if<NoteEvent>(&event)) {
+                noteEvent->internCurves(m_curvesInternPool);
             }
         }
     }
+
+    if (result.empty()) {
+        result = std::move(events);
+        return;
+    }
+
+    for (auto& pair : events) {
+        //! NOTE The reference is invalidated by the next insertion into the result
+        PlaybackEventList& list = result[pair.first];
+        list.insert(list.end(), std::make_move_iterator(pair.second.begin()), std::make_move_iterator(pair.second.end()));
+    }
 }
 
 bool PlaybackModel::hasToReloadTracks(const std::unordered_set<Ms::ElementType>& changedTypes) const
@@ -445,21 +586,21 @@ void PlaybackModel::removeEvents(const InstrumentTrackId& trackId, const mpe::ti
 
     PlaybackData& trackPlaybackData = search->second;
 
+    const PlaybackEventsMap& events = trackPlaybackData.originEvents;
+
     PlaybackEventsMap::const_iterator lowerBound;
 
     if (timestampFrom == 0) {
         //!Note Some events might be started RIGHT before the "official" start of the track
         //!     Need to make sure that we don't miss those events
-        lowerBound = trackPlaybackData.originEvents.begin();
+        lowerBound = events.cbegin();
     } else {
-        lowerBound = trackPlaybackData.originEvents.lower_bound(timestampFrom);
+        lowerBound = events.lower_bound(timestampFrom);
     }
 
-    auto upperBound = trackPlaybackData.originEvents.upper_bound(timestampTo);
+    auto upperBound = events.upper_bound(timestampTo);
 
-    for (auto it = lowerBound; it != upperBound;) {
-        it = trackPlaybackData.originEvents.erase(it);
-    }
+    trackPlaybackData.originEvents.erase(lowerBound, upperBound);
 }
 
 PlaybackModel::TrackBoundaries PlaybackModel::trackBoundaries(const Ms::ScoreChangesRange& changesRange) const
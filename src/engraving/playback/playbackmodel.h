@@ -25,6 +25,7 @@
 
 #include <unordered_map>
 #include <map>
+#include <set>
 #include <functional>
 
 #include "async/asyncable.h"
@@ -76,6 +77,8 @@ private:
     static const InstrumentTrackId METRONOME_TRACK_ID;
 
     using ChangedTrackIdSet = InstrumentTrackIdSet;
+    using TrackEventsMap = std::unordered_map<InstrumentTrackId, mpe::PlaybackEventsMap>;
+    using TrackProfilesMap = std::unordered_map<InstrumentTrackId, mpe::ArticulationsProfilePtr>;
 
     struct TickBoundaries
     {
@@ -99,6 +102,13 @@ private:
     void updateContext(const track_idx_t trackFrom, const track_idx_t trackTo);
     void updateEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
                       ChangedTrackIdSet* trackChanges = nullptr);
+    void updateEventsInParallel(const int tickFrom, const int tickTo);
+
+    TrackProfilesMap resolveProfiles(const std::set<Ms::ID>& partIdSet);
+    void renderEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
+                      const std::set<Ms::ID>& partIdSet, const TrackProfilesMap& profiles, const bool withMetronome,
+                      TrackEventsMap& result) const;
+    void mergeEvents(mpe::PlaybackEventsMap&& events, mpe::PlaybackEventsMap& result);
 
     bool hasToReloadTracks(const std::unordered_set<Ms::ElementType>& changedTypes) const;
     bool hasToReloadScore(const std::unordered_set<Ms::ElementType>& changedTypes) const;
@@ -125,6 +135,7 @@ private:
 
     std::unordered_map<InstrumentTrackId, PlaybackContext> m_playbackCtxMap;
     std::unordered_map<InstrumentTrackId, mpe::PlaybackData> m_playbackDataMap;
+    mpe::CurvesInternPool m_curvesInternPool;
 
     async::Notification m_dataChanged;
     async::Channel<InstrumentTrackId> m_trackAdded;
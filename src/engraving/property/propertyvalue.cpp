@@ -37,6 +37,30 @@ P_TYPE PropertyValue::type() const
     return m_type;
 }
 
+size_t PropertyValue::heapMemoryUsage() const
+{
+    switch (m_type) {
+    case P_TYPE::STRING: {
+        const QString* str = get<QString>();
+        return str ? str->capacity() * sizeof(QChar) : 0;
+    }
+    case P_TYPE::INT_VEC:
+        return sharedVectorMemoryUsage<std::vector<int> >();
+    case P_TYPE::PITCH_VALUES:
+        return sharedVectorMemoryUsage<PitchValues>();
+    case P_TYPE::GROUPS:
+        return sharedVectorMemoryUsage<GroupNodes>();
+    case P_TYPE::DRAW_PATH: {
+        const PainterPath* path = get<PainterPath>();
+        return path ? sizeof(PainterPath) + path->elementCount() * sizeof(PainterPath::Element) : 0;
+    }
+    default:
+        break;
+    }
+
+    return 0;
+}
+
 bool PropertyValue::operator ==(const PropertyValue& v) const
 {
     if (v.m_type == P_TYPE::UNDEFINED || m_type == P_TYPE::UNDEFINED) {
@@ -69,17 +93,22 @@ bool PropertyValue::operator ==(const PropertyValue& v) const
         return RealIsEqual(v.value<qreal>(), value<qreal>());
     }
 
-    assert(m_data);
-    if (!m_data) {
+    assert(m_ops);
+    if (!m_ops) {
+        return false;
+    }
+
+    assert(v.m_ops);
+    if (!v.m_ops) {
         return false;
     }
 
-    assert(v.m_data);
-    if (!v.m_data) {
+    if (v.m_type != m_type) {
         return false;
     }
 
-    return v.m_type == m_type && v.m_data->equal(m_data.get());
+    assert(v.m_ops == m_ops);
+    return v.m_ops == m_ops && m_ops->equal(m_storage, v.m_storage);
 }
 
 QVariant PropertyValue::toQVariant() const
@@ -26,6 +26,9 @@
 #include <any>
 #include <string>
 #include <memory>
+#include <cstring>
+#include <new>
+#include <type_traits>
 
 #include <QVariant>
 
@@ -112,245 +115,247 @@ public:
 
     // Base
     PropertyValue(bool v)
-        : m_type(P_TYPE::BOOL), m_data(make_data<bool>(v)) {}
+        : m_type(P_TYPE::BOOL) { init<bool>(v); }
 
     PropertyValue(int v)
-        : m_type(P_TYPE::INT), m_data(make_data<int>(v)) {}
+        : m_type(P_TYPE::INT) { init<int>(v); }
 
     PropertyValue(const std::vector<int>& v)
-        : m_type(P_TYPE::INT_VEC), m_data(make_data<std::vector<int> >(v)) {}
+        : m_type(P_TYPE::INT_VEC) { init<std::vector<int> >(v); }
 
     PropertyValue(size_t v)
-        : m_type(P_TYPE::SIZE_T), m_data(make_data<size_t>(v)) {}
+        : m_type(P_TYPE::SIZE_T) { init<size_t>(v); }
 
     PropertyValue(qreal v)
-        : m_type(P_TYPE::REAL), m_data(make_data<qreal>(v)) {}
+        : m_type(P_TYPE::REAL) { init<qreal>(v); }
 
     PropertyValue(const char* v)
-        : m_type(P_TYPE::STRING), m_data(make_data<QString>(QString(v))) {}
+        : m_type(P_TYPE::STRING) { init<QString>(QString(v)); }
 
     PropertyValue(const QString& v)
-        : m_type(P_TYPE::STRING), m_data(make_data<QString>(v)) {}
+        : m_type(P_TYPE::STRING) { init<QString>(v); }
 
     // Geometry
     PropertyValue(const PointF& v)
-        : m_type(P_TYPE::POINT), m_data(make_data<PointF>(v)) {}
+        : m_type(P_TYPE::POINT) { init<PointF>(v); }
 
     PropertyValue(const PairF& v)
-        : m_type(P_TYPE::PAIR_REAL), m_data(make_data<PairF>(v)) {}
+        : m_type(P_TYPE::PAIR_REAL) { init<PairF>(v); }
 
     PropertyValue(const SizeF& v)
-        : m_type(P_TYPE::SIZE), m_data(make_data<SizeF>(v)) {}
+        : m_type(P_TYPE::SIZE) { init<SizeF>(v); }
 
     PropertyValue(const PainterPath& v)
-        : m_type(P_TYPE::DRAW_PATH), m_data(make_data<PainterPath>(v)) {}
+        : m_type(P_TYPE::DRAW_PATH) { init<PainterPath>(v); }
 
     PropertyValue(const ScaleF& v)
-        : m_type(P_TYPE::SCALE), m_data(make_data<ScaleF>(v)) {}
+        : m_type(P_TYPE::SCALE) { init<ScaleF>(v); }
 
     PropertyValue(const Spatium& v)
-        : m_type(P_TYPE::SPATIUM), m_data(make_data<Spatium>(v)) {}
+        : m_type(P_TYPE::SPATIUM) { init<Spatium>(v); }
 
     PropertyValue(const Millimetre& v)
-        : m_type(P_TYPE::MILLIMETRE), m_data(make_data<Millimetre>(v)) {}
+        : m_type(P_TYPE::MILLIMETRE) { init<Millimetre>(v); }
 
     // Draw
     PropertyValue(SymId v)
-        : m_type(P_TYPE::SYMID), m_data(make_data<SymId>(v)) {}
+        : m_type(P_TYPE::SYMID) { init<SymId>(v); }
 
     PropertyValue(const Color& v)
-        : m_type(P_TYPE::COLOR), m_data(make_data<Color>(v)) {}
+        : m_type(P_TYPE::COLOR) { init<Color>(v); }
 
     PropertyValue(OrnamentStyle v)
-        : m_type(P_TYPE::ORNAMENT_STYLE), m_data(make_data<OrnamentStyle>(v)) {}
+        : m_type(P_TYPE::ORNAMENT_STYLE) { init<OrnamentStyle>(v); }
 
     PropertyValue(GlissandoStyle v)
-        : m_type(P_TYPE::GLISS_STYLE), m_data(make_data<GlissandoStyle>(v)) {}
+        : m_type(P_TYPE::GLISS_STYLE) { init<GlissandoStyle>(v); }
 
     // Layout
     PropertyValue(Align v)
-        : m_type(P_TYPE::ALIGN), m_data(make_data<Align>(v)) {}
+        : m_type(P_TYPE::ALIGN) { init<Align>(v); }
 
     PropertyValue(PlacementV v)
-        : m_type(P_TYPE::PLACEMENT_V), m_data(make_data<PlacementV>(v)) {}
+        : m_type(P_TYPE::PLACEMENT_V) { init<PlacementV>(v); }
     PropertyValue(PlacementH v)
-        : m_type(P_TYPE::PLACEMENT_H), m_data(make_data<PlacementH>(v)) {}
+        : m_type(P_TYPE::PLACEMENT_H) { init<PlacementH>(v); }
 
     PropertyValue(TextPlace v)
-        : m_type(P_TYPE::TEXT_PLACE), m_data(make_data<TextPlace>(v)) {}
+        : m_type(P_TYPE::TEXT_PLACE) { init<TextPlace>(v); }
 
     PropertyValue(DirectionV v)
-        : m_type(P_TYPE::DIRECTION_V), m_data(make_data<DirectionV>(v)) {}
+        : m_type(P_TYPE::DIRECTION_V) { init<DirectionV>(v); }
     PropertyValue(DirectionH v)
-        : m_type(P_TYPE::DIRECTION_H), m_data(make_data<DirectionH>(v)) {}
+        : m_type(P_TYPE::DIRECTION_H) { init<DirectionH>(v); }
 
     PropertyValue(Orientation v)
-        : m_type(P_TYPE::ORIENTATION), m_data(make_data<Orientation>(v)) {}
+        : m_type(P_TYPE::ORIENTATION) { init<Orientation>(v); }
 
     PropertyValue(BeamMode v)
-        : m_type(P_TYPE::BEAM_MODE), m_data(make_data<BeamMode>(v)) {}
+        : m_type(P_TYPE::BEAM_MODE) { init<BeamMode>(v); }
 
     PropertyValue(const AccidentalRole& v)
-        : m_type(P_TYPE::ACCIDENTAL_ROLE), m_data(make_data<AccidentalRole>(v)) {}
+        : m_type(P_TYPE::ACCIDENTAL_ROLE) { init<AccidentalRole>(v); }
 
     // Sound
     PropertyValue(const Fraction& v)
-        : m_type(P_TYPE::FRACTION), m_data(make_data<Fraction>(v)) {}
+        : m_type(P_TYPE::FRACTION) { init<Fraction>(v); }
     PropertyValue(const DurationTypeWithDots& v)
-        : m_type(P_TYPE::DURATION_TYPE_WITH_DOTS), m_data(make_data<DurationTypeWithDots>(v)) {}
+        : m_type(P_TYPE::DURATION_TYPE_WITH_DOTS) { init<DurationTypeWithDots>(v); }
     PropertyValue(ChangeMethod v)
-        : m_type(P_TYPE::CHANGE_METHOD), m_data(make_data<ChangeMethod>(v)) {}
+        : m_type(P_TYPE::CHANGE_METHOD) { init<ChangeMethod>(v); }
     PropertyValue(const PitchValues& v)
-        : m_type(P_TYPE::PITCH_VALUES), m_data(make_data<PitchValues>(v)) {}
+        : m_type(P_TYPE::PITCH_VALUES) { init<PitchValues>(v); }
     PropertyValue(const BeatsPerSecond& v)
-        : m_type(P_TYPE::TEMPO), m_data(make_data<BeatsPerSecond>(v)) {}
+        : m_type(P_TYPE::TEMPO) { init<BeatsPerSecond>(v); }
 
     // Types
     PropertyValue(LayoutBreakType v)
-        : m_type(P_TYPE::LAYOUTBREAK_TYPE), m_data(make_data<LayoutBreakType>(v)) {}
+        : m_type(P_TYPE::LAYOUTBREAK_TYPE) { init<LayoutBreakType>(v); }
 
     PropertyValue(VeloType v)
-        : m_type(P_TYPE::VELO_TYPE), m_data(make_data<VeloType>(v)) {}
+        : m_type(P_TYPE::VELO_TYPE) { init<VeloType>(v); }
 
     PropertyValue(BarLineType v)
-        : m_type(P_TYPE::BARLINE_TYPE), m_data(make_data<BarLineType>(v)) {}
+        : m_type(P_TYPE::BARLINE_TYPE) { init<BarLineType>(v); }
 
     PropertyValue(NoteHeadType v)
-        : m_type(P_TYPE::NOTEHEAD_TYPE), m_data(make_data<NoteHeadType>(v)) {}
+        : m_type(P_TYPE::NOTEHEAD_TYPE) { init<NoteHeadType>(v); }
     PropertyValue(NoteHeadScheme v)
-        : m_type(P_TYPE::NOTEHEAD_SCHEME), m_data(make_data<NoteHeadScheme>(v)) {}
+        : m_type(P_TYPE::NOTEHEAD_SCHEME) { init<NoteHeadScheme>(v); }
     PropertyValue(NoteHeadGroup v)
-        : m_type(P_TYPE::NOTEHEAD_GROUP), m_data(make_data<NoteHeadGroup>(v)) {}
+        : m_type(P_TYPE::NOTEHEAD_GROUP) { init<NoteHeadGroup>(v); }
 
     PropertyValue(ClefType v)
-        : m_type(P_TYPE::CLEF_TYPE), m_data(make_data<ClefType>(v)) {}
+        : m_type(P_TYPE::CLEF_TYPE) { init<ClefType>(v); }
 
     PropertyValue(DynamicType v)
-        : m_type(P_TYPE::DYNAMIC_TYPE), m_data(make_data<DynamicType>(v)) {}
+        : m_type(P_TYPE::DYNAMIC_TYPE) { init<DynamicType>(v); }
     PropertyValue(DynamicRange v)
-        : m_type(P_TYPE::DYNAMIC_RANGE), m_data(make_data<DynamicRange>(v)) {}
+        : m_type(P_TYPE::DYNAMIC_RANGE) { init<DynamicRange>(v); }
     PropertyValue(DynamicSpeed v)
-        : m_type(P_TYPE::DYNAMIC_SPEED), m_data(make_data<DynamicSpeed>(v)) {}
+        : m_type(P_TYPE::DYNAMIC_SPEED) { init<DynamicSpeed>(v); }
 
     PropertyValue(HookType v)
-        : m_type(P_TYPE::HOOK_TYPE), m_data(make_data<HookType>(v)) {}
+        : m_type(P_TYPE::HOOK_TYPE) { init<HookType>(v); }
 
     PropertyValue(KeyMode v)
-        : m_type(P_TYPE::KEY_MODE), m_data(make_data<KeyMode>(v)) {}
+        : m_type(P_TYPE::KEY_MODE) { init<KeyMode>(v); }
 
     PropertyValue(TextStyleType v)
-        : m_type(P_TYPE::TEXT_STYLE), m_data(make_data<TextStyleType>(v)) {}
+        : m_type(P_TYPE::TEXT_STYLE) { init<TextStyleType>(v); }
 
     PropertyValue(PlayingTechniqueType v)
-        : m_type(P_TYPE::PLAYTECH_TYPE), m_data(make_data<PlayingTechniqueType>(v)) {}
+        : m_type(P_TYPE::PLAYTECH_TYPE) { init<PlayingTechniqueType>(v); }
 
     PropertyValue(TempoTechniqueType v)
-        : m_type(P_TYPE::TEMPOCHANGE_TYPE), m_data(make_data<TempoTechniqueType>(v)) {}
+        : m_type(P_TYPE::TEMPOCHANGE_TYPE) { init<TempoTechniqueType>(v); }
 
     PropertyValue(SlurStyleType v)
-        : m_type(P_TYPE::SLUR_STYLE_TYPE), m_data(make_data<SlurStyleType>(v)) {}
+        : m_type(P_TYPE::SLUR_STYLE_TYPE) { init<SlurStyleType>(v); }
 
     // Other
     PropertyValue(const GroupNodes& v)
-        : m_type(P_TYPE::GROUPS), m_data(make_data<GroupNodes>(v)) {}
+        : m_type(P_TYPE::GROUPS) { init<GroupNodes>(v); }
 
     bool isValid() const;
 
     P_TYPE type() const;
-    bool isEnum() const { return m_data ? m_data->isEnum() : false; }
+    bool isEnum() const { return m_ops ? m_ops->isEnum : false; }
+
+    //! NOTE Estimated size of the heap memory owned by the value (ex. the characters of a string)
+    size_t heapMemoryUsage() const;
 
     template<typename T>
     T value() const
     {
+        //! NOTE Fast path, the value is stored exactly as T
+        if (const T* v = get<T>()) {
+            return *v;
+        }
+
         if (m_type == P_TYPE::UNDEFINED) {
             return T();
         }
 
-        assert(m_data);
-        if (!m_data) {
+        assert(m_ops);
+        if (!m_ops) {
             return T();
         }
 
-        Arg<T>* at = get<T>();
-        if (!at) {
-            //! HACK Temporary hack for int to enum
-            if constexpr (std::is_enum<T>::value) {
-                if (P_TYPE::INT == m_type) {
-                    return static_cast<T>(value<int>());
-                }
+        //! HACK Temporary hack for int to enum
+        if constexpr (std::is_enum<T>::value) {
+            if (P_TYPE::INT == m_type) {
+                return static_cast<T>(value<int>());
             }
+        }
 
-            //! HACK Temporary hack for enum to int
-            if constexpr (std::is_same<T, int>::value) {
-                if (m_data->isEnum()) {
-                    return m_data->enumToInt();
-                }
+        //! HACK Temporary hack for enum to int
+        if constexpr (std::is_same<T, int>::value) {
+            if (m_ops->isEnum) {
+                return m_ops->enumToInt(m_storage);
             }
+        }
 
-            //! HACK Temporary hack for bool to int
-            if constexpr (std::is_same<T, int>::value) {
-                if (P_TYPE::BOOL == m_type) {
-                    return value<bool>();
-                }
+        //! HACK Temporary hack for bool to int
+        if constexpr (std::is_same<T, int>::value) {
+            if (P_TYPE::BOOL == m_type) {
+                return value<bool>();
             }
+        }
 
-            //! HACK Temporary hack for int to bool
-            if constexpr (std::is_same<T, bool>::value) {
-                return value<int>();
-            }
+        //! HACK Temporary hack for int to bool
+        if constexpr (std::is_same<T, bool>::value) {
+            return value<int>();
+        }
 
-            //! HACK Temporary hack for int to size_t
-            if constexpr (std::is_same<T, int>::value) {
-                if (P_TYPE::SIZE_T == m_type) {
-                    return static_cast<int>(value<size_t>());
-                }
+        //! HACK Temporary hack for int to size_t
+        if constexpr (std::is_same<T, int>::value) {
+            if (P_TYPE::SIZE_T == m_type) {
+                return static_cast<int>(value<size_t>());
             }
+        }
 
-            //! HACK Temporary hack for real to Spatium
-            if constexpr (std::is_same<T, Spatium>::value) {
-                if (P_TYPE::REAL == m_type) {
-                    Arg<qreal>* srv = get<qreal>();
-                    assert(srv);
-                    return srv ? Spatium(srv->v) : Spatium();
-                }
+        //! HACK Temporary hack for real to Spatium
+        if constexpr (std::is_same<T, Spatium>::value) {
+            if (P_TYPE::REAL == m_type) {
+                const qreal* srv = get<qreal>();
+                assert(srv);
+                return srv ? Spatium(*srv) : Spatium();
             }
+        }
 
-            //! HACK Temporary hack for Spatium to real
-            if constexpr (std::is_same<T, qreal>::value) {
-                if (P_TYPE::SPATIUM == m_type) {
-                    return value<Spatium>().val();
-                }
+        //! HACK Temporary hack for Spatium to real
+        if constexpr (std::is_same<T, qreal>::value) {
+            if (P_TYPE::SPATIUM == m_type) {
+                return value<Spatium>().val();
             }
+        }
 
-            //! HACK Temporary hack for real to Millimetre
-            if constexpr (std::is_same<T, Millimetre>::value) {
-                if (P_TYPE::REAL == m_type) {
-                    Arg<qreal>* mrv = get<qreal>();
-                    assert(mrv);
-                    return mrv ? Millimetre(mrv->v) : Millimetre();
-                }
+        //! HACK Temporary hack for real to Millimetre
+        if constexpr (std::is_same<T, Millimetre>::value) {
+            if (P_TYPE::REAL == m_type) {
+                const qreal* mrv = get<qreal>();
+                assert(mrv);
+                return mrv ? Millimetre(*mrv) : Millimetre();
             }
+        }
 
-            //! HACK Temporary hack for Spatium to real
-            if constexpr (std::is_same<T, qreal>::value) {
-                if (P_TYPE::MILLIMETRE == m_type) {
-                    return value<Millimetre>().val();
-                }
+        //! HACK Temporary hack for Spatium to real
+        if constexpr (std::is_same<T, qreal>::value) {
+            if (P_TYPE::MILLIMETRE == m_type) {
+                return value<Millimetre>().val();
             }
+        }
 
-            //! HACK Temporary hack for Fraction to String
-            if constexpr (std::is_same<T, QString>::value) {
-                if (P_TYPE::FRACTION == m_type) {
-                    return value<Fraction>().toString();
-                }
+        //! HACK Temporary hack for Fraction to String
+        if constexpr (std::is_same<T, QString>::value) {
+            if (P_TYPE::FRACTION == m_type) {
+                return value<Fraction>().toString();
             }
         }
 
-        assert(at);
-        if (!at) {
-            return T();
-        }
-        return at->v;
+        assert(false);
+        return T();
     }
 
     bool toBool() const { return value<bool>(); }
@@ -369,60 +374,164 @@ public:
     QVariant toQVariant() const;
     static PropertyValue fromQVariant(const QVariant& v, P_TYPE type);
 
+    PropertyValue(const PropertyValue& other)
+        : m_type(other.m_type), m_ops(other.m_ops) { copyData(other); }
+
+    PropertyValue(PropertyValue&& other) noexcept
+        : m_type(other.m_type), m_ops(other.m_ops) { moveData(other); }
+
+    PropertyValue& operator=(const PropertyValue& other)
+    {
+        if (this != &other) {
+            reset();
+            m_type = other.m_type;
+            m_ops = other.m_ops;
+            copyData(other);
+        }
+        return *this;
+    }
+
+    PropertyValue& operator=(PropertyValue&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            m_type = other.m_type;
+            m_ops = other.m_ops;
+            moveData(other);
+        }
+        return *this;
+    }
+
+    ~PropertyValue() { reset(); }
+
 private:
-    struct IArg {
-        virtual ~IArg() = default;
+    //! NOTE Scalars, enums and geometry types are stored inline,
+    //! so making, copying and reading them doesn't allocate.
+    //! Types that don't fit (ex. vectors, paths) are shared on the heap.
+    static constexpr size_t INLINE_SIZE = 16;
+
+    template<typename T>
+    static constexpr bool isInline()
+    {
+        return sizeof(T) <= INLINE_SIZE && alignof(T) <= alignof(double);
+    }
+
+    template<typename T>
+    using Shared = std::shared_ptr<const T>;
 
-        virtual bool equal(const IArg* a) const = 0;
+    template<typename T>
+    size_t sharedVectorMemoryUsage() const
+    {
+        const T* v = get<T>();
+        return v ? sizeof(T) + v->capacity() * sizeof(typename T::value_type) : 0;
+    }
 
-        virtual bool isEnum() const = 0;
-        virtual int enumToInt() const = 0;
+    struct Ops {
+        bool isTrivial = false; // can be copied as bytes and needn't be destroyed
+        bool isEnum = false;
+        void (*copy)(void* dst, const void* src) = nullptr;
+        void (*move)(void* dst, void* src) = nullptr;
+        void (*destroy)(void* data) = nullptr;
+        bool (*equal)(const void* a, const void* b) = nullptr;
+        int (*enumToInt)(const void* data) = nullptr;
     };
 
     template<typename T>
-    struct Arg : public IArg {
-        T v;
-        Arg(const T& v)
-            : IArg(), v(v) {}
-
-        bool equal(const IArg* a) const override
-        {
-            assert(a);
-            const Arg<T>* at = dynamic_cast<const Arg<T>*>(a);
-            assert(at);
-            return at ? at->v == v : false;
-        }
-
-        //! HACK Temporary hack for enum to int
-        bool isEnum() const override
-        {
-            return std::is_enum<T>::value;
+    static const T* dataOf(const void* storage)
+    {
+        if constexpr (isInline<T>()) {
+            return static_cast<const T*>(storage);
+        } else {
+            return static_cast<const Shared<T>*>(storage)->get();
         }
+    }
 
-        int enumToInt() const override
-        {
-            if constexpr (std::is_enum<T>::value) {
-                return static_cast<int>(v);
-            } else {
-                return -1;
+    //! NOTE One instance per type, so the type check of the stored value is a pointer comparison
+    template<typename T>
+    static const Ops* ops()
+    {
+        using Stored = std::conditional_t<isInline<T>(), T, Shared<T> >;
+        static_assert(sizeof(Stored) <= INLINE_SIZE && alignof(Stored) <= alignof(double));
+
+        static constexpr Ops s_ops {
+            isInline<T>() && std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+            std::is_enum<T>::value,
+            [](void* dst, const void* src) { new (dst) Stored(*static_cast<const Stored*>(src)); },
+            [](void* dst, void* src) {
+                new (dst) Stored(std::move(*static_cast<Stored*>(src)));
+                static_cast<Stored*>(src)->~Stored();
+            },
+            [](void* data) { static_cast<Stored*>(data)->~Stored(); },
+            [](const void* a, const void* b) { return *dataOf<T>(a) == *dataOf<T>(b); },
+            []([[maybe_unused]] const void* data) {
+                //! HACK Temporary hack for enum to int
+                if constexpr (std::is_enum<T>::value) {
+                    return static_cast<int>(*dataOf<T>(data));
+                } else {
+                    return -1;
+                }
             }
-        }
-    };
+        };
+
+        return &s_ops;
+    }
 
     template<typename T>
-    inline std::shared_ptr<IArg> make_data(const T& v) const
+    inline void init(const T& v)
     {
-        return std::shared_ptr<IArg>(new Arg<T>(v));
+        m_ops = ops<T>();
+        if constexpr (isInline<T>()) {
+            new (m_storage) T(v);
+        } else {
+            new (m_storage) Shared<T>(std::make_shared<const T>(v));
+        }
     }
 
     template<typename T>
-    inline Arg<T>* get() const
+    inline const T* get() const
+    {
+        return m_ops == ops<T>() ? dataOf<T>(m_storage) : nullptr;
+    }
+
+    inline void copyData(const PropertyValue& other)
+    {
+        if (!m_ops) {
+            return;
+        }
+
+        if (m_ops->isTrivial) {
+            std::memcpy(m_storage, other.m_storage, INLINE_SIZE);
+        } else {
+            m_ops->copy(m_storage, other.m_storage);
+        }
+    }
+
+    inline void moveData(PropertyValue& other)
     {
-        return dynamic_cast<Arg<T>*>(m_data.get());
+        if (!m_ops) {
+            return;
+        }
+
+        if (m_ops->isTrivial) {
+            std::memcpy(m_storage, other.m_storage, INLINE_SIZE);
+        } else {
+            m_ops->move(m_storage, other.m_storage);
+            other.m_type = P_TYPE::UNDEFINED;
+            other.m_ops = nullptr;
+        }
+    }
+
+    inline void reset()
+    {
+        if (m_ops && !m_ops->isTrivial) {
+            m_ops->destroy(m_storage);
+        }
+        m_ops = nullptr;
     }
 
     P_TYPE m_type = P_TYPE::UNDEFINED;
-    std::shared_ptr<IArg> m_data = nullptr;
+    const Ops* m_ops = nullptr;
+    alignas(double) unsigned char m_storage[INLINE_SIZE];
 };
 }
 
@@ -0,0 +1,142 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "excerptfilesloader.h"
+
+#include <algorithm>
+
+#include "runtime.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+ExcerptFilesLoader::ExcerptFilesLoader(const MscReader& reader, const std::vector<QString>& names)
+    : m_reader(reader), m_names(names), m_slots(names.size())
+{
+}
+
+ExcerptFilesLoader::~ExcerptFilesLoader()
+{
+    finish();
+}
+
+void ExcerptFilesLoader::start()
+{
+    IF_ASSERT_FAILED(m_threads.empty()) {
+        return;
+    }
+
+    if (m_names.empty()) {
+        return;
+    }
+
+    const MscReader::Params& params = m_reader.params();
+
+    //! NOTE The device can't be read from several threads
+    if (params.device || params.filePath.isEmpty()) {
+        m_threads.emplace_back([this]() {
+            threadLoop(&m_reader);
+        });
+        return;
+    }
+
+    size_t threadsCount = std::min(std::max(std::thread::hardware_concurrency(), 1u), static_cast<unsigned>(m_names.size()));
+    for (size_t i = 0; i < threadsCount; ++i) {
+        m_threads.emplace_back([this, params]() {
+            MscReader reader(params);
+            if (!reader.open()) {
+                LOGW() << "failed open: " << params.filePath;
+                return;
+            }
+
+            threadLoop(&reader);
+        });
+    }
+}
+
+void ExcerptFilesLoader::finish()
+{
+    m_canceled = true;
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+
+    m_threads.clear();
+}
+
+void ExcerptFilesLoader::threadLoop(const MscReader* reader)
+{
+    runtime::setThreadName("excerpt_files_loader");
+
+    while (!m_canceled) {
+        size_t idx = m_next.fetch_add(1);
+        if (idx >= m_names.size()) {
+            return;
+        }
+
+        Files files;
+        files.styleData = reader->readExcerptStyleFile(m_names.at(idx));
+        files.data = reader->readExcerptFile(m_names.at(idx));
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_slots[idx].files = std::move(files);
+            m_slots[idx].ready = true;
+        }
+
+        m_cv.notify_all();
+    }
+}
+
+ExcerptFilesLoader::Files ExcerptFilesLoader::take(size_t idx)
+{
+    IF_ASSERT_FAILED(idx < m_slots.size()) {
+        return Files();
+    }
+
+    Slot& slot = m_slots[idx];
+
+    //! NOTE The slot is claimed by a thread, it will be ready soon
+    if (idx < m_next.load()) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [&slot]() { return slot.ready; });
+        return std::move(slot.files);
+    }
+
+    //! NOTE Not claimed yet (not started or no thread could open the container),
+    //! claim the rest and read by ourselves
+    finish();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (slot.ready) {
+            return std::move(slot.files);
+        }
+    }
+
+    Files files;
+    files.styleData = m_reader.readExcerptStyleFile(m_names.at(idx));
+    files.data = m_reader.readExcerptFile(m_names.at(idx));
+    return files;
+}
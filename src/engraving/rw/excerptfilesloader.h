@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_EXCERPTFILESLOADER_H
+#define MU_ENGRAVING_EXCERPTFILESLOADER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QString>
+
+#include "types/bytearray.h"
+#include "../infrastructure/io/mscreader.h"
+
+namespace mu::engraving {
+//! NOTE Reads (decompresses) the files of the excerpts in the background,
+//! while the master score and the previous excerpts are being built.
+//! If the container is opened by the path, every thread opens the container itself,
+//! otherwise one thread reads from the given reader,
+//! so the reader must not be used by anybody else until the loader is finished
+class ExcerptFilesLoader
+{
+public:
+    struct Files {
+        ByteArray styleData;
+        ByteArray data;
+    };
+
+    ExcerptFilesLoader(const MscReader& reader, const std::vector<QString>& names);
+    ~ExcerptFilesLoader();
+
+    void start();
+    void finish();
+
+    //! Waits until the files of the excerpt are read and returns them
+    Files take(size_t idx);
+
+private:
+    struct Slot {
+        Files files;
+        bool ready = false;
+    };
+
+    void threadLoop(const MscReader* reader);
+
+    const MscReader& m_reader;
+    std::vector<QString> m_names;
+    std::vector<Slot> m_slots;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::atomic<size_t> m_next = 0;
+    std::atomic<bool> m_canceled = false;
+};
+}
+
+#endif // MU_ENGRAVING_EXCERPTFILESLOADER_H
@@ -28,6 +28,7 @@
 #include "compat/read206.h"
 #include "compat/read302.h"
 #include "read400.h"
+#include "excerptfilesloader.h"
 
 #include "../libmscore/excerpt.h"
 #include "../libmscore/imageStore.h"
@@ -87,9 +88,19 @@ Err ScoreReader::loadMscz(Ms::MasterScore* masterScore, const mu::engraving::Msc
 
     Err retval = Err::NoError;
 
+    ByteArray scoreData = mscReader.readScoreFile();
+
+    //! NOTE The files of the excerpts are read in the background while the master score is being built,
+    //! the scores themselves are built and linked one by one on this thread
+    std::vector<QString> excerptNames;
+    if (mscReader.params().mode != MscIoMode::XmlFile) {
+        excerptNames = mscReader.excerptNames();
+    }
+    ExcerptFilesLoader excerptFilesLoader(mscReader, excerptNames);
+    excerptFilesLoader.start();
+
     // Read score
     {
-        ByteArray scoreData = mscReader.readScoreFile();
         QString docName = masterScore->fileInfo()->fileName().toQString();
 
         compat::ReadStyleHook styleHook(masterScore, scoreData, docName);
@@ -103,8 +114,10 @@ Err ScoreReader::loadMscz(Ms::MasterScore* masterScore, const mu::engraving::Msc
 
     // Read excerpts
     if (masterScore->mscVersion() >= 400) {
-        std::vector<QString> excerptNames = mscReader.excerptNames();
-        for (const QString& excerptName : excerptNames) {
+        for (size_t i = 0; i < excerptNames.size(); ++i) {
+            const QString& excerptName = excerptNames.at(i);
+            ExcerptFilesLoader::Files excerptFiles = excerptFilesLoader.take(i);
+
             Score* partScore = masterScore->createScore();
 
             compat::ReadStyleHook::setupDefaultStyle(partScore);
@@ -112,17 +125,14 @@ Err ScoreReader::loadMscz(Ms::MasterScore* masterScore, const mu::engraving::Msc
             Excerpt* ex = new Excerpt(masterScore);
             ex->setExcerptScore(partScore);
 
-            ByteArray excerptStyleData = mscReader.readExcerptStyleFile(excerptName);
-            Buffer excerptStyleBuf(&excerptStyleData);
+            Buffer excerptStyleBuf(&excerptFiles.styleData);
             excerptStyleBuf.open(IODevice::ReadOnly);
             partScore->style().read(&excerptStyleBuf);
 
-            ByteArray excerptData = mscReader.readExcerptFile(excerptName);
-
             ReadContext ctx(partScore);
             ctx.initLinks(masterScoreCtx);
 
-            XmlReader xml(excerptData);
+            XmlReader xml(excerptFiles.data);
             xml.setDocName(excerptName);
             xml.setContext(&ctx);
 
@@ -137,6 +147,8 @@ Err ScoreReader::loadMscz(Ms::MasterScore* masterScore, const mu::engraving::Msc
         }
     }
 
+    excerptFilesLoader.finish();
+
     //  Read audio
     {
         if (masterScore->audio()) {
@@ -0,0 +1,182 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "accessibility/accessibleitem.h"
+
+#include "libmscore/masterscore.h"
+#include "libmscore/segment.h"
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/accidental.h"
+#include "libmscore/factory.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace Ms;
+
+class AccessibleItemTests : public ::testing::Test
+{
+protected:
+    std::vector<Note*> notes(Score* score) const
+    {
+        std::vector<Note*> result;
+        for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+            EngravingItem* e = s->element(0);
+            if (e && e->isChord()) {
+                result.push_back(toChord(e)->upNote());
+            }
+        }
+
+        return result;
+    }
+
+    //! NOTE The same as it is done when the element gets focused
+    void focus(EngravingItem* item) const
+    {
+        std::list<EngravingItem*> parents;
+        for (EngravingItem* parent = item->parentItem(); parent; parent = parent->parentItem()) {
+            parents.push_front(parent);
+        }
+
+        for (EngravingItem* parent : parents) {
+            parent->setupAccessible();
+        }
+
+        item->setupAccessible();
+        AccessibleItem::markAsUsed(item->accessible());
+    }
+
+    bool parentsHaveAccessible(const EngravingItem* item) const
+    {
+        for (const EngravingItem* parent = item->parentItem(); parent; parent = parent->parentItem()) {
+            if (parent->type() != ElementType::ROOT_ITEM && parent->type() != ElementType::DUMMY && !parent->accessible()) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+/**
+ * @brief AccessibleItemTests_ReleaseUnusedItems
+ * @details Only the accessible objects of the most recently focused elements are kept,
+ *          the others are released together with the parents left without accessible children
+ */
+TEST_F(AccessibleItemTests, ReleaseUnusedItems)
+{
+    // [GIVEN] A score with several notes
+    MasterScore* score = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score);
+
+    std::vector<Note*> allNotes = notes(score);
+    ASSERT_GT(allNotes.size(), size_t(2));
+
+    // [GIVEN] Only two accessible objects are kept
+    size_t usedItemsLimit = AccessibleItem::usedItemsLimit;
+    AccessibleItem::usedItemsLimit = 2;
+
+    // [WHEN] All the notes get focused one by one
+    for (Note* note : allNotes) {
+        focus(note);
+    }
+
+    // [THEN] The accessible objects of the two last notes are kept
+    size_t keptFrom = allNotes.size() - 2;
+    for (size_t i = 0; i < allNotes.size(); ++i) {
+        Note* note = allNotes.at(i);
+        bool kept = i >= keptFrom;
+
+        EXPECT_EQ(note->accessible() != nullptr, kept);
+        EXPECT_EQ(note->chord()->accessible() != nullptr, kept);
+        EXPECT_EQ(note->chord()->segment()->accessible() != nullptr, kept);
+    }
+
+    // [WHEN] The first note gets focused again
+    focus(allNotes.front());
+
+    // [THEN] Its accessible object is created again and the least recently focused one is released
+    EXPECT_TRUE(allNotes.front()->accessible());
+    EXPECT_FALSE(allNotes.at(keptFrom)->accessible());
+    EXPECT_TRUE(allNotes.back()->accessible());
+
+    AccessibleItem::usedItemsLimit = usedItemsLimit;
+    delete score;
+}
+
+/**
+ * @brief AccessibleItemTests_KeepParentsOfUsedChildren
+ * @details The accessible object of an element is not released while its children have accessible objects,
+ *          even if the element itself is the least recently focused one
+ */
+TEST_F(AccessibleItemTests, KeepParentsOfUsedChildren)
+{
+    // [GIVEN] A score with several notes, the first one has an accidental
+    MasterScore* score = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score);
+
+    std::vector<Note*> allNotes = notes(score);
+    ASSERT_GT(allNotes.size(), size_t(2));
+
+    Note* note = allNotes.at(0);
+    Accidental* accidental = Factory::createAccidental(note);
+    accidental->setAccidentalType(AccidentalType::SHARP);
+    note->add(accidental);
+
+    // [GIVEN] Only two accessible objects are kept
+    size_t usedItemsLimit = AccessibleItem::usedItemsLimit;
+    AccessibleItem::usedItemsLimit = 2;
+
+    // [WHEN] The note gets focused, then its accidental, then the next note
+    focus(note);
+    focus(accidental);
+    focus(allNotes.at(1));
+
+    // [THEN] The least recently focused note is kept while its accidental has the accessible object
+    EXPECT_TRUE(note->accessible());
+    EXPECT_FALSE(accidental->accessible());
+
+    // [THEN] The parents of all the accessible objects have the accessible objects too
+    EXPECT_TRUE(parentsHaveAccessible(note));
+    EXPECT_TRUE(parentsHaveAccessible(allNotes.at(1)));
+
+    // [WHEN] The next note gets focused
+    focus(allNotes.at(2));
+
+    // [THEN] The first note is released, it has no accessible children anymore
+    EXPECT_FALSE(note->accessible());
+    EXPECT_TRUE(parentsHaveAccessible(allNotes.at(2)));
+
+    // [WHEN] The accidental gets focused again
+    focus(accidental);
+
+    // [THEN] Its parents are set up again
+    EXPECT_TRUE(accidental->accessible());
+    EXPECT_TRUE(parentsHaveAccessible(accidental));
+
+    AccessibleItem::usedItemsLimit = usedItemsLimit;
+    delete score;
+}
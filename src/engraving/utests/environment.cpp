@@ -20,6 +20,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <QTemporaryDir>
+
 #include "testing/environment.h"
 
 #include "engraving/engravingmodule.h"
@@ -28,6 +30,7 @@
 
 #include "libmscore/masterscore.h"
 #include "libmscore/musescoreCore.h"
+#include "libmscore/scorefont.h"
 
 #include "mocks/engravingconfigurationmock.h"
 
@@ -43,16 +46,21 @@ static mu::testing::SuiteEnvironment engraving_se(
     Ms::MScore::testMode = true;
     Ms::MScore::noGui = true;
 
-    new Ms::MuseScoreCore;
-    Ms::MScore* mscore = new Ms::MScore();
-    mscore->init();
-
-    Ms::loadInstrumentTemplates(":/data/instruments.xml");
+    //! NOTE The font metrics cache of the tests is written to a temporary folder, not to the user app data
+    static QTemporaryDir fontMetricsCacheDir;
 
     std::shared_ptr<testing::NiceMock<mu::engraving::EngravingConfigurationMock> > configurator
         = std::make_shared<testing::NiceMock<mu::engraving::EngravingConfigurationMock> >();
     ON_CALL(*configurator, isAccessibleEnabled()).WillByDefault(testing::Return(false));
     ON_CALL(*configurator, defaultColor()).WillByDefault(testing::Return(mu::draw::Color::black));
+    ON_CALL(*configurator, fontMetricsCachePath()).WillByDefault(testing::Return(mu::io::path_t(fontMetricsCacheDir.path())));
     Ms::EngravingItem::setengravingConfiguration(configurator);
+    Ms::ScoreFont::setengravingConfiguration(configurator);
+
+    new Ms::MuseScoreCore;
+    Ms::MScore* mscore = new Ms::MScore();
+    mscore->init();
+
+    Ms::loadInstrumentTemplates(":/data/instruments.xml");
 }
     );
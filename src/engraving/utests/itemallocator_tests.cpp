@@ -0,0 +1,203 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "libmscore/itemallocator.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+
+#include "utils/scorerw.h"
+
+static const QString ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace Ms;
+
+class ItemAllocatorTests : public ::testing::Test
+{
+};
+
+TEST_F(ItemAllocatorTests, ReuseFreedBlocks)
+{
+    //! GIVEN Allocator with some blocks allocated
+    ItemAllocator allocator;
+
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < 100; ++i) {
+        blocks.push_back(allocator.allocate(200));
+    }
+
+    ItemAllocator::Stats stats = allocator.stats();
+    EXPECT_EQ(stats.usedBlocks, 100);
+    EXPECT_EQ(stats.allocations, 100);
+    EXPECT_EQ(stats.chunks, 1);
+    EXPECT_TRUE(ItemAllocator::isPooled(blocks.front()));
+    EXPECT_TRUE(ItemAllocator::isPooled(blocks.back()));
+
+    //! DO Free the blocks and allocate them again
+    for (void* block : blocks) {
+        ItemAllocator::deallocate(block);
+    }
+
+    EXPECT_EQ(allocator.stats().usedBlocks, 0);
+
+    for (size_t i = 0; i < 100; ++i) {
+        blocks[i] = allocator.allocate(200);
+    }
+
+    //! CHECK No new chunks were reserved
+    stats = allocator.stats();
+    EXPECT_EQ(stats.usedBlocks, 100);
+    EXPECT_EQ(stats.peakUsedBlocks, 100);
+    EXPECT_EQ(stats.chunks, 1);
+
+    //! DO Allocate a block too large for the size classes
+    void* large = allocator.allocate(100000);
+
+    //! CHECK It's taken from the heap
+    EXPECT_EQ(allocator.stats().heapAllocations, 1);
+    EXPECT_FALSE(ItemAllocator::isPooled(large));
+
+    ItemAllocator::deallocate(large);
+    for (void* block : blocks) {
+        ItemAllocator::deallocate(block);
+    }
+}
+
+TEST_F(ItemAllocatorTests, BlocksOutliveAllocator)
+{
+    //! GIVEN Allocator with some blocks allocated
+    ItemAllocator* allocator = new ItemAllocator();
+
+    std::vector<int*> blocks;
+    for (int i = 0; i < 10; ++i) {
+        int* value = static_cast<int*>(allocator->allocate(sizeof(int)));
+        *value = i;
+        blocks.push_back(value);
+    }
+
+    //! DO Destroy the allocator
+    delete allocator;
+
+    //! CHECK The blocks are still valid and can be freed
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(*blocks[i], i);
+        ItemAllocator::deallocate(blocks[i]);
+    }
+}
+
+TEST_F(ItemAllocatorTests, OtherThreads)
+{
+    //! GIVEN Allocator with some blocks allocated
+    ItemAllocator allocator;
+
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < 100; ++i) {
+        blocks.push_back(allocator.allocate(100));
+    }
+
+    //! DO Free the blocks and allocate a block on another thread
+    void* otherThreadBlock = nullptr;
+    std::thread thread([&]() {
+        for (void* block : blocks) {
+            ItemAllocator::deallocate(block);
+        }
+
+        otherThreadBlock = allocator.allocate(100);
+    });
+    thread.join();
+
+    //! CHECK The blocks are returned to the allocator, the block of the other thread is taken from the heap
+    ItemAllocator::Stats stats = allocator.stats();
+    EXPECT_EQ(stats.usedBlocks, 0);
+    EXPECT_EQ(stats.heapAllocations, 1);
+    EXPECT_FALSE(ItemAllocator::isPooled(otherThreadBlock));
+
+    //! DO Allocate the blocks again on the thread of the allocator
+    for (size_t i = 0; i < 100; ++i) {
+        blocks[i] = allocator.allocate(100);
+    }
+
+    //! CHECK The freed blocks were reused
+    stats = allocator.stats();
+    EXPECT_EQ(stats.usedBlocks, 100);
+    EXPECT_EQ(stats.chunks, 1);
+
+    ItemAllocator::deallocate(otherThreadBlock);
+    for (void* block : blocks) {
+        ItemAllocator::deallocate(block);
+    }
+}
+
+TEST_F(ItemAllocatorTests, ScoreItems)
+{
+    //! GIVEN The allocator is enabled
+    MScore::useItemAllocator = true;
+
+    //! DO Read the score
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    //! CHECK The items of the score are taken from its allocator
+    ItemAllocator* allocator = score->itemAllocator();
+    ASSERT_TRUE(allocator);
+
+    ItemAllocator::Stats stats = allocator->stats();
+    EXPECT_GT(stats.usedBlocks, 0);
+    EXPECT_GT(stats.chunks, 0);
+
+    ASSERT_TRUE(score->firstMeasure());
+    EXPECT_TRUE(ItemAllocator::isPooled(score->firstMeasure()->first()));
+
+    //! DO Layout the score again
+    score->doLayout();
+
+    //! CHECK The ledger lines and hooks of the previous layout were reused
+    EXPECT_LE(allocator->stats().chunks, stats.chunks + 1);
+
+    delete score;
+
+    MScore::useItemAllocator = false;
+}
+
+TEST_F(ItemAllocatorTests, ScoreItemsWithoutAllocator)
+{
+    //! GIVEN The allocator is disabled
+
+    //! DO Read the score
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    //! CHECK The items of the score are taken from the heap as is
+    EXPECT_FALSE(score->itemAllocator());
+
+    ASSERT_TRUE(score->firstMeasure());
+    EXPECT_FALSE(ItemAllocator::isPooled(score->firstMeasure()->first()));
+
+    delete score;
+}
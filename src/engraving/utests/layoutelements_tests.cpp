@@ -126,6 +126,79 @@ TEST_F(LayoutElementsTests, tstLayoutMoonlight)
     tstLayoutAll("moonlight.mscx");
 }
 
+//---------------------------------------------------------
+//   itemsLayoutState
+//    type, position on the canvas and bounding box of every item
+//---------------------------------------------------------
+
+struct ItemLayoutState {
+    ElementType type = ElementType::INVALID;
+    PointF pos;
+    RectF bbox;
+};
+
+static void collectItemLayoutState(void* data, EngravingItem* e)
+{
+    std::vector<ItemLayoutState>* state = static_cast<std::vector<ItemLayoutState>*>(data);
+    state->push_back({ e->type(), e->canvasPos(), e->bbox() });
+}
+
+static std::vector<ItemLayoutState> itemsLayoutState(Score* score)
+{
+    std::vector<ItemLayoutState> state;
+    score->scanElements(&state, collectItemLayoutState, /* all */ true);
+    return state;
+}
+
+//---------------------------------------------------------
+//   tstIncrementalLayout
+//    Test that the layout of the edited range gives
+//    the same geometry of the items as the full layout
+//---------------------------------------------------------
+
+static void tstIncrementalLayout(const QString& file)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+    ASSERT_TRUE(score);
+
+    // [WHEN] A measure in the middle of the score is stretched, so the systems after it are reflowed
+    Measure* m = score->crMeasure(static_cast<int>(score->nmeasures() / 2));
+    ASSERT_TRUE(m);
+
+    score->startCmd();
+    m->undoChangeProperty(Pid::USER_STRETCH, 2.0);
+    score->endCmd();
+
+    std::vector<ItemLayoutState> actual = itemsLayoutState(score);
+
+    // [THEN] The items, the spanner segments of the stable systems included,
+    //        have the geometry the full layout of the edited score gives them
+    score->doLayout();
+
+    std::vector<ItemLayoutState> expected = itemsLayoutState(score);
+
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i].type, expected[i].type);
+        EXPECT_NEAR(actual[i].pos.x(), expected[i].pos.x(), 0.001);
+        EXPECT_NEAR(actual[i].pos.y(), expected[i].pos.y(), 0.001);
+        EXPECT_NEAR(actual[i].bbox.width(), expected[i].bbox.width(), 0.001);
+        EXPECT_NEAR(actual[i].bbox.height(), expected[i].bbox.height(), 0.001);
+    }
+
+    delete score;
+}
+
+TEST_F(LayoutElementsTests, tstIncrementalLayoutMoonlight)
+{
+    tstIncrementalLayout("moonlight.mscx");
+}
+
+TEST_F(LayoutElementsTests, tstIncrementalLayoutElements)
+{
+    tstIncrementalLayout("layout_elements.mscx");
+}
+
 // FIXME goldberg.mscx does not pass the test because of some
 // TimeSig and Clef elements. Need to check it later!
 TEST_F(LayoutElementsTests, DISABLED_tstLayoutGoldberg)
@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 #include "libmscore/masterscore.h"
 #include "libmscore/excerpt.h"
 #include "libmscore/part.h"
@@ -37,6 +39,8 @@
 #include "libmscore/engravingitem.h"
 #include "libmscore/system.h"
 #include "libmscore/durationtype.h"
+#include "libmscore/factory.h"
+#include "libmscore/timesig.h"
 
 #include "utils/scorerw.h"
 #include "utils/scorecomp.h"
@@ -559,3 +563,99 @@ TEST_F(MeasureTests, measureNumbers)
 
     delete score;
 }
+
+//---------------------------------------------------------
+//   linear reference of tick2measure(MM)
+//---------------------------------------------------------
+
+static Measure* walkTick2measure(Score* score, const Fraction& tick, bool mmRests)
+{
+    Measure* lm = nullptr;
+    for (Measure* m = mmRests ? score->firstMeasureMM() : score->firstMeasure(); m;
+         m = mmRests ? m->nextMeasureMM() : m->nextMeasure()) {
+        if (tick < m->tick()) {
+            return lm;
+        }
+        lm = m;
+    }
+    if (lm && tick >= lm->tick() && tick <= lm->endTick()) {
+        return lm;
+    }
+    return nullptr;
+}
+
+static void checkTick2measure(Score* score, std::mt19937& random)
+{
+    std::vector<Fraction> ticks;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        ticks.push_back(m->tick());
+        ticks.push_back(m->tick() + m->ticks() / 2);
+        ticks.push_back(m->endTick());
+    }
+    std::uniform_int_distribution<int> randomTick(0, score->lastMeasure()->endTick().ticks() + Constants::division);
+    for (int i = 0; i < 20; ++i) {
+        ticks.push_back(Fraction::fromTicks(randomTick(random)));
+    }
+
+    for (const Fraction& tick : ticks) {
+        EXPECT_EQ(score->tick2measure(tick), walkTick2measure(score, tick, false));
+        EXPECT_EQ(score->tick2measureMM(tick), walkTick2measure(score, tick, true));
+    }
+}
+
+//---------------------------------------------------------
+///   tick2measureIndex
+///    tick2measure(MM) lookups after random edits are
+///    the same as walking the measure list
+//---------------------------------------------------------
+
+TEST_F(MeasureTests, tick2measureIndex)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + "mmrest.mscx");
+    EXPECT_TRUE(score);
+
+    std::mt19937 random(20211);
+    static const Fraction sigs[] = { Fraction(4, 4), Fraction(3, 4), Fraction(5, 8), Fraction(7, 16) };
+
+    for (int step = 0; step < 60; ++step) {
+        size_t measures = score->nmeasures();
+        Measure* m = score->crMeasure(static_cast<int>(random() % measures));
+
+        switch (random() % 5) {
+        case 0:
+            score->startCmd();
+            score->insertMeasure(ElementType::MEASURE, m);
+            score->endCmd();
+            break;
+        case 1:
+            if (measures > 2) {
+                score->startCmd();
+                score->deleteMeasures(m, m);
+                score->endCmd();
+            }
+            break;
+        case 2:
+        {
+            TimeSig* ts = Factory::createTimeSig(score->dummy()->segment());
+            ts->setSig(sigs[random() % 4], TimeSigType::NORMAL);
+            score->startCmd();
+            score->cmdAddTimeSig(m, 0, ts, false);
+            score->endCmd();
+            break;
+        }
+        case 3:
+            score->undoRedo(true, nullptr);
+            break;
+        case 4:
+            score->startCmd();
+            score->undo(new ChangeStyleVal(score, Sid::createMultiMeasureRests, !score->styleB(Sid::createMultiMeasureRests)));
+            score->setLayoutAll();
+            score->endCmd();
+            break;
+        }
+
+        checkTick2measure(score, random);
+    }
+
+    delete score;
+}
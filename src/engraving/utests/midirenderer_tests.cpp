@@ -0,0 +1,134 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+
+#include "utils/scorerw.h"
+#include "compat/midi/event.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/rendermidi.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+//! NOTE The scores of the old midi tests
+static const QString MIDI_TEST_FILES_DIR("../tests/midi_data/");
+static const QString MIDIRENDERER_DATA_DIR("midirenderer_data/");
+
+class MidiRendererTests : public ::testing::Test
+{
+protected:
+    Ms::EventMap renderEvents(Ms::MasterScore* score, bool parallel, size_t threadsCount = 0) const
+    {
+        Ms::MidiRenderer::Context ctx;
+        ctx.renderHarmony = true;
+        ctx.parallel = parallel;
+        ctx.threadsCount = threadsCount;
+
+        Ms::EventMap events;
+        Ms::MidiRenderer(score).renderScore(&events, ctx);
+
+        return events;
+    }
+
+    bool isEqual(const Ms::EventMap& events1, const Ms::EventMap& events2) const
+    {
+        if (events1.size() != events2.size()) {
+            return false;
+        }
+
+        for (auto it1 = events1.cbegin(), it2 = events2.cbegin(); it1 != events1.cend(); ++it1, ++it2) {
+            const Ms::NPlayEvent& e1 = it1->second;
+            const Ms::NPlayEvent& e2 = it2->second;
+
+            if (it1->first != it2->first
+                || !(e1 == e2)
+                || e1.discard() != e2.discard()
+                || e1.tuning() != e2.tuning()
+                || e1.getOriginatingStaff() != e2.getOriginatingStaff()
+                || e1.note() != e2.note()
+                || e1.harmony() != e2.harmony()) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+/**
+ * @brief MidiRendererTests_ParallelRenderingIsTheSame
+ * @details Renders every score of the midi tests chunk by chunk and in parallel,
+ *          the events must be the same and in the same order
+ */
+TEST_F(MidiRendererTests, ParallelRenderingIsTheSame)
+{
+    QDir dir(ScoreRW::rootPath() + "/" + MIDI_TEST_FILES_DIR);
+    QStringList files = dir.entryList({ "*.mscx" }, QDir::Files);
+    ASSERT_FALSE(files.isEmpty());
+
+    for (const QString& file : files) {
+        // [GIVEN] The score of the midi tests
+        Ms::MasterScore* score = ScoreRW::readScore(MIDI_TEST_FILES_DIR + file);
+        ASSERT_TRUE(score) << file.toStdString();
+
+        // [WHEN] The score is rendered chunk by chunk and in parallel
+        Ms::EventMap expectedEvents = renderEvents(score, false);
+        Ms::EventMap events = renderEvents(score, true);
+
+        // [THEN] The events are the same
+        EXPECT_FALSE(expectedEvents.empty()) << file.toStdString();
+        EXPECT_TRUE(isEqual(events, expectedEvents)) << file.toStdString();
+
+        delete score;
+    }
+}
+
+/**
+ * @brief MidiRendererTests_ParallelRenderingOfTrills
+ * @details The trills and the grace notes merged into them are looked up in the spanner map
+ *          of the score, which is shared by the staves. Renders the scores with many staves
+ *          of trills on a thread per staff, the events must be the same as rendered chunk by chunk
+ */
+TEST_F(MidiRendererTests, ParallelRenderingOfTrills)
+{
+    for (const QString& file : { "graceTrillStaves.mscx", "trillLinesStaves.mscx" }) {
+        // [GIVEN] The score with eight staves of trills
+        Ms::MasterScore* score = ScoreRW::readScore(MIDIRENDERER_DATA_DIR + file);
+        ASSERT_TRUE(score) << file.toStdString();
+        ASSERT_EQ(score->nstaves(), size_t(8)) << file.toStdString();
+
+        Ms::EventMap expectedEvents = renderEvents(score, false);
+        EXPECT_FALSE(expectedEvents.empty()) << file.toStdString();
+
+        // [WHEN] The score is rendered many times with a thread per staff
+        // [THEN] The events are always the same
+        for (int i = 0; i < 20; ++i) {
+            Ms::EventMap events = renderEvents(score, true, score->nstaves());
+            EXPECT_TRUE(isEqual(events, expectedEvents)) << file.toStdString();
+        }
+
+        delete score;
+    }
+}
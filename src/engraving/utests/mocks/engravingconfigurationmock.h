@@ -38,6 +38,8 @@ public:
 
     MOCK_METHOD(std::string, iconsFontFamily, (), (const, override));
 
+    MOCK_METHOD(io::path_t, fontMetricsCachePath, (), (const, override));
+
     MOCK_METHOD(draw::Color, defaultColor, (), (const, override));
     MOCK_METHOD(draw::Color, scoreInversionColor, (), (const, override));
     MOCK_METHOD(draw::Color, invisibleColor, (), (const, override));
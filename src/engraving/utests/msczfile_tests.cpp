@@ -24,12 +24,22 @@
 #include <QByteArray>
 
 #include "io/buffer.h"
+#include "io/file.h"
 #include "io/mscwriter.h"
 #include "io/mscreader.h"
 
+#include "compat/scoreaccess.h"
+#include "rw/excerptfilesloader.h"
+#include "rw/scorereader.h"
+#include "libmscore/excerpt.h"
+#include "libmscore/masterscore.h"
+
+#include "utils/scorerw.h"
+
 using namespace mu;
 using namespace mu::io;
 using namespace mu::engraving;
+using namespace Ms;
 
 class MsczFileTests : public ::testing::Test
 {
@@ -87,3 +97,111 @@ TEST_F(MsczFileTests, MsczFile_WriteRead)
         EXPECT_EQ(imageData, originImageData);
     }
 }
+
+static MasterScore* loadMscz(const MscReader::Params& params)
+{
+    MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+    MscReader reader(params);
+    EXPECT_TRUE(reader.open());
+
+    ScoreReader scoreReader;
+    Err err = scoreReader.loadMscz(score, reader, false);
+
+    EXPECT_EQ(err, Err::NoError);
+    return score;
+}
+
+//! NOTE The files of the excerpts read by the loader must be the same as read one by one
+static void checkExcerptFilesLoader(const MscReader::Params& params)
+{
+    MscReader reader(params);
+    ASSERT_TRUE(reader.open());
+
+    std::vector<QString> names = reader.excerptNames();
+    ASSERT_FALSE(names.empty());
+
+    std::vector<ExcerptFilesLoader::Files> expected;
+    for (const QString& name : names) {
+        expected.push_back({ reader.readExcerptStyleFile(name), reader.readExcerptFile(name) });
+    }
+
+    ExcerptFilesLoader loader(reader, names);
+    loader.start();
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        ExcerptFilesLoader::Files files = loader.take(i);
+        EXPECT_FALSE(files.data.empty());
+        EXPECT_EQ(files.styleData, expected.at(i).styleData);
+        EXPECT_EQ(files.data, expected.at(i).data);
+    }
+
+    loader.finish();
+}
+
+TEST_F(MsczFileTests, MsczFile_ReadExcerpts)
+{
+    //! CASE Reading the excerpts, their files are read in the background
+
+    //! GIVEN The score with the parts
+    MasterScore* origin = ScoreRW::readScore("implode_explode_data/explode1.mscx");
+    ASSERT_TRUE(origin);
+    for (Excerpt* ex : Excerpt::createExcerptsFromParts(origin->parts())) {
+        origin->initAndAddExcerpt(ex, false);
+    }
+    ASSERT_EQ(origin->excerpts().size(), 8);
+
+    const QString path("msczfile_excerpts.mscz");
+    {
+        MscWriter::Params params;
+        params.filePath = path;
+        params.mode = MscIoMode::Zip;
+
+        MscWriter writer(params);
+        ASSERT_TRUE(writer.open());
+        ASSERT_TRUE(origin->writeMscz(writer, false, false));
+    }
+
+    //! DO Read by the path (every loader thread opens the file itself)
+    MscReader::Params pathParams;
+    pathParams.filePath = path;
+    pathParams.mode = MscIoMode::Zip;
+
+    checkExcerptFilesLoader(pathParams);
+    MasterScore* byPath = loadMscz(pathParams);
+
+    //! DO Read from the device (one loader thread)
+    File file(path);
+    ASSERT_TRUE(file.open(IODevice::ReadOnly));
+    ByteArray msczData = file.readAll();
+    file.close();
+
+    Buffer buf(&msczData);
+    MscReader::Params deviceParams;
+    deviceParams.device = &buf;
+    deviceParams.filePath = path;
+    deviceParams.mode = MscIoMode::Zip;
+
+    MasterScore* byDevice = loadMscz(deviceParams);
+
+    Buffer checkBuf(&msczData);
+    deviceParams.device = &checkBuf;
+    checkExcerptFilesLoader(deviceParams);
+
+    //! CHECK The excerpts are the same and in the same order
+    for (MasterScore* score : { byPath, byDevice }) {
+        ASSERT_EQ(score->excerpts().size(), origin->excerpts().size());
+        for (size_t i = 0; i < origin->excerpts().size(); ++i) {
+            Excerpt* ex = score->excerpts().at(i);
+            Excerpt* originEx = origin->excerpts().at(i);
+            EXPECT_EQ(ex->name(), originEx->name());
+            EXPECT_EQ(ex->excerptScore()->nmeasures(), originEx->excerptScore()->nmeasures());
+            EXPECT_EQ(ex->excerptScore()->nstaves(), originEx->excerptScore()->nstaves());
+            EXPECT_EQ(ex->tracksMapping(), originEx->tracksMapping());
+        }
+    }
+
+    delete byPath;
+    delete byDevice;
+    delete origin;
+    file.remove();
+}
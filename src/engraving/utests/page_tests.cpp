@@ -0,0 +1,129 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "infrastructure/draw/bufferedpaintprovider.h"
+#include "infrastructure/draw/painter.h"
+#include "paint/paint.h"
+
+#include "libmscore/masterscore.h"
+#include "libmscore/page.h"
+#include "libmscore/text.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace Ms;
+
+class PageTests : public ::testing::Test
+{
+protected:
+    //! NOTE The texts drawn by the painter, joined
+    QString drawnText(const draw::BufferedPaintProvider& provider) const
+    {
+        QString result;
+        for (const draw::DrawData::Object& obj : provider.drawData().objects) {
+            for (const draw::DrawData::Data& data : obj.datas) {
+                for (const draw::DrawText& text : data.texts) {
+                    result += text.text;
+                }
+            }
+        }
+
+        return result;
+    }
+};
+
+/**
+ * @brief PageTests_ParallelHeaderFooter
+ * @details The copies of the header/footer texts of each page can be painted in parallel,
+ *          each page gets its own page number, the same as when the pages are drawn one by one
+ */
+TEST_F(PageTests, ParallelHeaderFooter)
+{
+    // [GIVEN] A score of several pages with the page numbers in the header of every page
+    MasterScore* score = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score);
+
+    score->startCmd();
+    score->appendMeasures(300);
+    score->endCmd();
+
+    score->setStyleValue(Sid::headerFirstPage, true);
+    score->setLayoutAll();
+    score->update();
+
+    const std::vector<Page*>& pages = score->pages();
+    ASSERT_GT(pages.size(), size_t(2));
+
+    // [GIVEN] The texts drawn by the pages one by one
+    std::vector<QString> expectedTexts;
+    for (const Page* page : pages) {
+        auto provider = std::make_shared<draw::BufferedPaintProvider>();
+        draw::Painter painter(provider, "page");
+        Paint::paintElement(painter, page);
+        painter.endDraw();
+
+        expectedTexts.push_back(drawnText(*provider));
+    }
+
+    // [WHEN] The copies of the header/footer texts are made on the main thread and painted in parallel
+    std::vector<std::vector<Text*> > texts;
+    for (const Page* page : pages) {
+        texts.push_back(page->cloneHeaderFooterTexts());
+    }
+
+    std::vector<QString> drawnTexts(pages.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < pages.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            auto provider = std::make_shared<draw::BufferedPaintProvider>();
+            draw::Painter painter(provider, "page");
+            for (const Text* text : texts[i]) {
+                Paint::paintElement(painter, text);
+            }
+            painter.endDraw();
+
+            drawnTexts[i] = drawnText(*provider);
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // [THEN] Each page has its own page number, the same as drawn by the page
+    for (size_t i = 0; i < pages.size(); ++i) {
+        EXPECT_TRUE(drawnTexts[i].contains(QString::number(i + 1)));
+        EXPECT_EQ(drawnTexts[i], expectedTexts[i]);
+    }
+
+    for (const std::vector<Text*>& pageTexts : texts) {
+        qDeleteAll(pageTexts);
+    }
+
+    delete score;
+}
@@ -23,6 +23,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <memory>
+#include <set>
 
 #include "async/channel.h"
 #include "async/asyncable.h"
@@ -688,3 +689,109 @@ TEST_F(PlaybackModelTests, Playback_Setup_Data_MultiInstrument)
         }
     }
 }
+
+/**
+ * @brief PlaybackModelTests_Parallel_Load_MultiInstrument
+ * @details In this case we're loading a score with 12 instruments, the events of every instrument are rendered on worker threads
+ *          Then we're requesting the whole score to be re-rendered on the main thread and comparing the results
+ */
+TEST_F(PlaybackModelTests, Parallel_Load_MultiInstrument)
+{
+    // [GIVEN] Score with 12 instruments
+    Ms::Score* score = ScoreRW::readScore(PLAYBACK_MODEL_TEST_FILES_DIR + "playback_setup_instruments/playback_setup_instruments.mscx");
+
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->parts().size(), 12);
+
+    // [GIVEN] The articulation profiles repository will be returning profiles for every family
+    EXPECT_CALL(*m_repositoryMock, defaultProfile(_)).WillRepeatedly(Return(m_defaultProfile));
+
+    // [GIVEN] The playback model
+    PlaybackModel model;
+    model.setprofilesRepository(m_repositoryMock);
+
+    InstrumentTrackIdSet addedTracks;
+    model.trackAdded().onReceive(this, [&addedTracks](const InstrumentTrackId& trackId) {
+        EXPECT_TRUE(addedTracks.insert(trackId).second);
+    });
+
+    // [WHEN] The playback model requested to be loaded
+    model.load(score);
+
+    // [THEN] Every track has been added once
+    EXPECT_EQ(addedTracks.size(), 13); // 12 instruments + metronome
+    EXPECT_TRUE(addedTracks.find(model.metronomeTrackId()) != addedTracks.cend());
+
+    std::unordered_map<InstrumentTrackId, PlaybackEventsMap> loadedEvents;
+    for (const InstrumentTrackId& trackId : addedTracks) {
+        loadedEvents[trackId] = model.resolveTrackPlaybackData(trackId).originEvents;
+    }
+
+    // [WHEN] The whole score is re-rendered on the main thread
+    Ms::ScoreChangesRange range;
+    range.tickFrom = 0;
+    range.tickTo = score->lastMeasure()->endTick().ticks();
+    range.staffIdxFrom = 0;
+    range.staffIdxTo = score->nstaves();
+    range.changedTypes = { Ms::ElementType::TEMPO_TEXT };
+
+    score->changesChannel().send(range);
+
+    // [THEN] The events rendered in parallel match the events rendered sequentially
+    for (const auto& pair : loadedEvents) {
+        EXPECT_FALSE(pair.second.empty());
+        EXPECT_EQ(model.resolveTrackPlaybackData(pair.first).originEvents, pair.second);
+    }
+}
+
+/**
+ * @brief PlaybackModelTests_Load_CurvesAreShared
+ * @details In this case we're loading a score with 12 instruments and counting the pitch and expression curves of its note events
+ *          The curves are interned by the playback model, so the most of the events share their curves instead of keeping a copy
+ */
+TEST_F(PlaybackModelTests, Load_CurvesAreShared)
+{
+    // [GIVEN] Score with 12 instruments
+    Ms::Score* score = ScoreRW::readScore(PLAYBACK_MODEL_TEST_FILES_DIR + "playback_setup_instruments/playback_setup_instruments.mscx");
+
+    ASSERT_TRUE(score);
+
+    // [GIVEN] The articulation profiles repository will be returning profiles for every family
+    EXPECT_CALL(*m_repositoryMock, defaultProfile(_)).WillRepeatedly(Return(m_defaultProfile));
+
+    // [GIVEN] The playback model
+    PlaybackModel model;
+    model.setprofilesRepository(m_repositoryMock);
+
+    InstrumentTrackIdSet addedTracks;
+    model.trackAdded().onReceive(this, [&addedTracks](const InstrumentTrackId& trackId) {
+        addedTracks.insert(trackId);
+    });
+
+    // [WHEN] The playback model requested to be loaded
+    model.load(score);
+
+    // [THEN] The note events share the data of the equal curves, the curves with the same data have their first points at the same address
+    size_t noteEventsCount = 0;
+    std::set<const void*> pitchCurves;
+    std::set<const void*> expressionCurves;
+
+    for (const InstrumentTrackId& trackId : addedTracks) {
+        for (const auto& pair : model.resolveTrackPlaybackData(trackId).originEvents) {
+            for (const PlaybackEvent& event : pair.second) {
+                const NoteEvent* noteEvent = std::get_if<NoteEvent>(&event);
+                if (!noteEvent || noteEvent->pitchCtx().pitchCurve.empty() || noteEvent->expressionCtx().expressionCurve.empty()) {
+                    continue;
+                }
+
+                ++noteEventsCount;
+                pitchCurves.insert(&(*noteEvent->pitchCtx().pitchCurve.cbegin()));
+                expressionCurves.insert(&(*noteEvent->expressionCtx().expressionCurve.cbegin()));
+            }
+        }
+    }
+
+    ASSERT_GT(noteEventsCount, 12);
+    EXPECT_LT(pitchCurves.size(), noteEventsCount);
+    EXPECT_LT(expressionCurves.size(), noteEventsCount);
+}
@@ -0,0 +1,241 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "property/propertyvalue.h"
+
+#include "libmscore/chord.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/note.h"
+#include "libmscore/segment.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+static const QString ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace Ms;
+
+class PropertyValueTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   ReferenceBoxedValue
+//    The previous storage of PropertyValue, every value
+//    is boxed on the heap, used to compare the performance
+//---------------------------------------------------------
+
+class ReferenceBoxedValue
+{
+public:
+    ReferenceBoxedValue() = default;
+
+    template<typename T>
+    ReferenceBoxedValue(const T& v)
+        : m_data(std::shared_ptr<IArg>(new Arg<T>(v))) {}
+
+    template<typename T>
+    T value() const
+    {
+        Arg<T>* at = dynamic_cast<Arg<T>*>(m_data.get());
+        return at ? at->v : T();
+    }
+
+private:
+    struct IArg {
+        virtual ~IArg() = default;
+    };
+
+    template<typename T>
+    struct Arg : public IArg {
+        T v;
+        Arg(const T& v)
+            : IArg(), v(v) {}
+    };
+
+    std::shared_ptr<IArg> m_data;
+};
+
+static std::vector<Note*> scoreNotes(MasterScore* score)
+{
+    std::vector<Note*> notes;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        for (EngravingItem* e : s->elist()) {
+            if (e && e->isChord()) {
+                for (Note* n : toChord(e)->notes()) {
+                    notes.push_back(n);
+                }
+            }
+        }
+    }
+    return notes;
+}
+
+TEST_F(PropertyValueTests, tstValues)
+{
+    // inline values
+    EXPECT_EQ(PropertyValue(true).value<bool>(), true);
+    EXPECT_EQ(PropertyValue(42).value<int>(), 42);
+    EXPECT_EQ(PropertyValue(size_t(7)).value<size_t>(), size_t(7));
+    EXPECT_DOUBLE_EQ(PropertyValue(2.5).value<qreal>(), 2.5);
+    EXPECT_EQ(PropertyValue(PointF(1.0, 2.0)).value<PointF>(), PointF(1.0, 2.0));
+    EXPECT_EQ(PropertyValue(Color(10, 20, 30)).value<Color>(), Color(10, 20, 30));
+    EXPECT_EQ(PropertyValue(Fraction(3, 8)).value<Fraction>(), Fraction(3, 8));
+    EXPECT_EQ(PropertyValue(DirectionV::DOWN).value<DirectionV>(), DirectionV::DOWN);
+    EXPECT_EQ(PropertyValue(QString("text")).value<QString>(), QString("text"));
+
+    // heap values
+    std::vector<int> vec = { 1, 2, 3 };
+    EXPECT_EQ(PropertyValue(vec).value<std::vector<int> >(), vec);
+
+    // conversions
+    EXPECT_EQ(PropertyValue(true).value<int>(), 1);
+    EXPECT_EQ(PropertyValue(1).value<bool>(), true);
+    EXPECT_EQ(PropertyValue(2).value<DirectionV>(), DirectionV(2));
+    EXPECT_EQ(PropertyValue(DirectionV::DOWN).value<int>(), static_cast<int>(DirectionV::DOWN));
+    EXPECT_EQ(PropertyValue(size_t(5)).value<int>(), 5);
+    EXPECT_DOUBLE_EQ(PropertyValue(1.5).value<Spatium>().val(), 1.5);
+    EXPECT_DOUBLE_EQ(PropertyValue(Spatium(1.5)).value<qreal>(), 1.5);
+    EXPECT_DOUBLE_EQ(PropertyValue(Millimetre(3.0)).value<qreal>(), 3.0);
+    EXPECT_EQ(PropertyValue(Fraction(1, 4)).value<QString>(), QString("1/4"));
+    EXPECT_TRUE(PropertyValue(DirectionV::UP).isEnum());
+    EXPECT_FALSE(PropertyValue(1).isEnum());
+
+    // comparisons
+    EXPECT_EQ(PropertyValue(true), PropertyValue(1));
+    EXPECT_EQ(PropertyValue(2), PropertyValue(DirectionV(2)));
+    EXPECT_EQ(PropertyValue(Spatium(2.5)), PropertyValue(2.5));
+    EXPECT_NE(PropertyValue(Fraction(2, 8)), PropertyValue(Fraction(1, 4)));
+    EXPECT_NE(PropertyValue(QString("a")), PropertyValue(QString("b")));
+    EXPECT_EQ(PropertyValue(), PropertyValue());
+    EXPECT_NE(PropertyValue(), PropertyValue(0));
+
+    // copy and move
+    PropertyValue str(QString("text"));
+    PropertyValue copy = str;
+    EXPECT_EQ(copy, str);
+
+    PropertyValue moved = std::move(copy);
+    EXPECT_EQ(moved, str);
+    EXPECT_FALSE(copy.isValid());
+
+    PropertyValue assigned(vec);
+    assigned = str;
+    EXPECT_EQ(assigned, str);
+    assigned = PropertyValue(Color(1, 2, 3));
+    EXPECT_EQ(assigned.value<Color>(), Color(1, 2, 3));
+}
+
+//---------------------------------------------------------
+//   tstPerformance
+//    style value reads and property undo churn
+//---------------------------------------------------------
+
+TEST_F(PropertyValueTests, tstPerformance)
+{
+    using clock = std::chrono::steady_clock;
+
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    ASSERT_TRUE(score);
+    score->doLayout();
+
+    std::vector<Note*> notes = scoreNotes(score);
+    ASSERT_FALSE(notes.empty());
+
+    constexpr int STYLE_REPEATS = 1000;
+    constexpr int UNDO_REPEATS = 20;
+
+    // style values
+    qreal checksum = 0.0;
+    clock::time_point started = clock::now();
+    for (int r = 0; r < STYLE_REPEATS; ++r) {
+        for (int i = 0; i < static_cast<int>(Sid::STYLES); ++i) {
+            PropertyValue v = score->styleV(static_cast<Sid>(i));
+            if (v.type() == P_TYPE::REAL || v.type() == P_TYPE::SPATIUM) {
+                checksum += v.toReal();
+            }
+        }
+    }
+    int64_t styleTime = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - started).count();
+
+    qreal referenceChecksum = 0.0;
+    started = clock::now();
+    for (int r = 0; r < STYLE_REPEATS; ++r) {
+        for (int i = 0; i < static_cast<int>(Sid::STYLES); ++i) {
+            const PropertyValue& sv = score->styleV(static_cast<Sid>(i));
+            if (sv.type() == P_TYPE::REAL || sv.type() == P_TYPE::SPATIUM) {
+                ReferenceBoxedValue v(sv.toReal());
+                referenceChecksum += v.value<qreal>();
+            }
+        }
+    }
+    int64_t referenceStyleTime = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - started).count();
+
+    EXPECT_DOUBLE_EQ(checksum, referenceChecksum);
+
+    // element properties
+    started = clock::now();
+    int visibleCount = 0;
+    for (int r = 0; r < STYLE_REPEATS; ++r) {
+        for (Note* n : notes) {
+            visibleCount += n->getProperty(Pid::VISIBLE).toBool();
+            visibleCount += n->propertyDefault(Pid::COLOR) == n->getProperty(Pid::COLOR);
+        }
+    }
+    int64_t propertyTime = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - started).count();
+    EXPECT_GT(visibleCount, 0);
+
+    // undo churn
+    std::vector<bool> visible;
+    for (Note* n : notes) {
+        visible.push_back(n->visible());
+    }
+
+    started = clock::now();
+    for (int r = 0; r < UNDO_REPEATS; ++r) {
+        score->startCmd();
+        for (Note* n : notes) {
+            n->undoChangeProperty(Pid::COLOR, PropertyValue(Color(255, 0, 0)));
+            n->undoChangeProperty(Pid::VISIBLE, false);
+        }
+        score->endCmd();
+        score->undoRedo(true, nullptr);
+    }
+    int64_t undoTime = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - started).count();
+
+    for (size_t i = 0; i < notes.size(); ++i) {
+        EXPECT_EQ(notes.at(i)->visible(), visible.at(i));
+    }
+
+    LOGI() << "style values: " << styleTime << " us, boxed reference: " << referenceStyleTime << " us";
+    LOGI() << "element properties: " << propertyTime << " us";
+    LOGI() << "property undo churn: " << undoTime << " us";
+
+    delete score;
+}
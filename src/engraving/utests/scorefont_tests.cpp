@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include "libmscore/scorefont.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace Ms;
+
+class ScoreFontTests : public ::testing::Test
+{
+};
+
+static QString metricsCacheDir()
+{
+    return ScoreFont::engravingConfiguration()->fontMetricsCachePath().toQString();
+}
+
+/**
+ * @brief ScoreFontTests_MetricsCacheInTempDir
+ * @details The tests write the metrics cache into a temporary folder, not into the user app data
+ */
+TEST_F(ScoreFontTests, MetricsCacheInTempDir)
+{
+    //! [GIVEN] The fonts are initialized by the test environment
+    QString dir = metricsCacheDir();
+    ASSERT_FALSE(dir.isEmpty());
+
+    //! [WHEN] The fallback font is loaded
+    ScoreFont* font = ScoreFont::fallbackFont();
+    ASSERT_TRUE(font);
+
+    //! [THEN] The cache files are in the temporary folder
+    EXPECT_TRUE(QDir::cleanPath(dir).startsWith(QDir::cleanPath(QDir::tempPath())));
+    EXPECT_GT(QFileInfo(dir + "/glyphnames.bin").size(), 0);
+    EXPECT_GT(QFileInfo(dir + "/" + font->name().toLower() + ".bin").size(), 0);
+}
+
+/**
+ * @brief ScoreFontTests_PartialCacheIsIgnored
+ * @details A partially written cache file is ignored and written again
+ */
+TEST_F(ScoreFontTests, PartialCacheIsIgnored)
+{
+    //! [GIVEN] A valid cache of the glyph codes
+    QFile file(metricsCacheDir() + "/glyphnames.bin");
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    QByteArray validData = file.readAll();
+    file.close();
+    ASSERT_FALSE(validData.isEmpty());
+
+    //! [GIVEN] The cache is cut, like a file read while it's being written
+    ASSERT_TRUE(file.resize(validData.size() / 2));
+
+    //! [WHEN] The fonts are initialized again
+    ScoreFont::initScoreFonts();
+
+    //! [THEN] The broken cache is ignored, the codes are read from the glyph names and written again
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    EXPECT_EQ(file.readAll(), validData);
+}
@@ -0,0 +1,210 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/segment.h"
+#include "libmscore/shape.h"
+
+#include "utils/scorerw.h"
+
+static const QString ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace Ms;
+
+class ShapeTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   referenceMinHorizontalDistance
+//    The previous pairwise implementation of
+//    Shape::minHorizontalDistance, which the current one
+//    must match exactly
+//---------------------------------------------------------
+
+static qreal referenceMinHorizontalDistance(const Shape& s, const Shape& a, Score* score)
+{
+    qreal dist = -1000000.0;
+    double verticalClearance = 0.2 * score->spatium();
+    for (const ShapeElement& r2 : a) {
+        const EngravingItem* item2 = r2.toItem;
+        for (const ShapeElement& r1 : s) {
+            const EngravingItem* item1 = r1.toItem;
+            bool intersection = Ms::intersects(r1.top(), r1.bottom(), r2.top(), r2.bottom(), verticalClearance);
+            KerningType kerningType = KerningType::NON_KERNING;
+            if (item1 && item2) {
+                kerningType = item1->computeKerningType(item2);
+            }
+            if (intersection
+                || (r1.width() == 0 || r2.width() == 0)
+                || (!item1 && item2 && item2->isLyrics())
+                || kerningType == KerningType::NON_KERNING) {
+                double padding = (item1 && item2) ? item1->computePadding(item2) : 0.0;
+                dist = qMax(dist, r1.right() - r2.left() + padding);
+            }
+            if (kerningType == KerningType::KERNING_UNTIL_ORIGIN) {
+                dist = qMax(dist, r1.left() - r2.left());
+            }
+        }
+    }
+    return dist;
+}
+
+static qreal referenceMinVerticalDistance(const Shape& s, const Shape& a)
+{
+    if (s.empty() || a.empty()) {
+        return 0.0;
+    }
+
+    qreal dist = -1000000.0;
+    for (const RectF& r2 : a) {
+        if (r2.height() <= 0.0) {
+            continue;
+        }
+        for (const RectF& r1 : s) {
+            if (r1.height() <= 0.0) {
+                continue;
+            }
+            if (Ms::intersects(r1.left(), r1.right(), r2.left(), r2.right(), 0.0)) {
+                dist = qMax(dist, r1.bottom() - r2.top());
+            }
+        }
+    }
+    return dist;
+}
+
+static bool referenceIntersects(const Shape& s, const Shape& a)
+{
+    for (const RectF& r1 : s) {
+        for (const RectF& r2 : a) {
+            if (r1.intersects(r2)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------
+//   RandomShapes
+//    Deterministic random shapes made of the rectangles of
+//    the given items, including the zero width/height ones
+//---------------------------------------------------------
+
+class RandomShapes
+{
+public:
+    RandomShapes(const std::vector<const EngravingItem*>& items)
+        : m_items(items) {}
+
+    Shape shape(size_t size)
+    {
+        Shape result;
+        for (size_t i = 0; i < size; ++i) {
+            qreal x = next(100) / 10.0;
+            qreal y = next(100) / 10.0 - 5.0;
+            qreal w = next(8) == 0 ? 0.0 : next(30) / 10.0;
+            qreal h = next(10) == 0 ? 0.0 : next(30) / 10.0;
+            const EngravingItem* item = next(15) == 0 ? nullptr : m_items[next(m_items.size())];
+            result.add(RectF(x, y, w, h), item);
+        }
+        return result;
+    }
+
+private:
+    size_t next(size_t max)
+    {
+        m_seed = m_seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<size_t>(m_seed >> 33) % max;
+    }
+
+    std::vector<const EngravingItem*> m_items;
+    uint64_t m_seed = 1;
+};
+
+/**
+ * @brief ShapeTests_MinHorizontalDistance
+ * @details The distances between the shapes of the segments and between the random shapes
+ *          made of the items of the score are the same as the ones of the pairwise comparison
+ */
+TEST_F(ShapeTests, MinHorizontalDistance)
+{
+    // [GIVEN] The score with the notes, rests, lyrics, chord symbols, bar lines, clefs etc.
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "layout_elements.mscx");
+    ASSERT_TRUE(score);
+
+    std::vector<const Segment*> segments;
+    std::vector<const EngravingItem*> items;
+    for (Segment* s = score->firstSegment(SegmentType::All); s; s = s->next1()) {
+        segments.push_back(s);
+        for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+            for (const ShapeElement& r : s->staffShape(staffIdx)) {
+                if (r.toItem) {
+                    items.push_back(r.toItem);
+                }
+            }
+        }
+    }
+    ASSERT_FALSE(items.empty());
+
+    // [THEN] The distances between the neighbour segments are the same
+    for (size_t i = 0; i + 1 < segments.size(); ++i) {
+        for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+            const Shape& s1 = segments[i]->staffShape(staffIdx);
+            const Shape& s2 = segments[i + 1]->staffShape(staffIdx);
+            EXPECT_EQ(s1.minHorizontalDistance(s2, score), referenceMinHorizontalDistance(s1, s2, score));
+        }
+    }
+
+    // [THEN] The distances between the random shapes, small and large, are the same
+    RandomShapes randomShapes(items);
+    for (size_t i = 0; i < 500; ++i) {
+        Shape s1 = randomShapes.shape(i % 40);
+        Shape s2 = randomShapes.shape((i * 7) % 40);
+        EXPECT_EQ(s1.minHorizontalDistance(s2, score), referenceMinHorizontalDistance(s1, s2, score));
+    }
+
+    delete score;
+}
+
+/**
+ * @brief ShapeTests_MinVerticalDistanceAndIntersects
+ * @details The vertical distances and the intersections of the random shapes
+ *          are the same as the ones of the pairwise comparison
+ */
+TEST_F(ShapeTests, MinVerticalDistanceAndIntersects)
+{
+    RandomShapes randomShapes({ nullptr });
+    for (size_t i = 0; i < 500; ++i) {
+        Shape s1 = randomShapes.shape(i % 40);
+        Shape s2 = randomShapes.shape((i * 7) % 40);
+        EXPECT_EQ(s1.minVerticalDistance(s2), referenceMinVerticalDistance(s1, s2));
+        EXPECT_EQ(s1.intersects(s2), referenceIntersects(s1, s2));
+    }
+}
@@ -0,0 +1,331 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/shape.h"
+#include "libmscore/skyline.h"
+#include "libmscore/staff.h"
+#include "libmscore/system.h"
+
+#include "utils/scorerw.h"
+
+static const QString ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace Ms;
+
+class SkylineTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   ReferenceSkylineLine
+//    The previous array of structures implementation of
+//    SkylineLine, which the current one must match exactly
+//---------------------------------------------------------
+
+class ReferenceSkylineLine
+{
+public:
+    ReferenceSkylineLine(bool n)
+        : north(n) {}
+
+    void add(qreal x, qreal y, qreal w)
+    {
+        if (x < 0.0) {
+            w -= -x;
+            x = 0.0;
+            if (w <= 0.0) {
+                return;
+            }
+        }
+
+        SegIter i = find(x);
+        qreal cx = seg.empty() ? 0.0 : i->x;
+        for (; i != seg.end(); ++i) {
+            qreal cy = i->y;
+            if ((x + w) <= cx) {
+                return;
+            }
+            if (x > (cx + i->w)) {
+                cx += i->w;
+                continue;
+            }
+            if ((north && (cy <= y)) || (!north && (cy >= y))) {
+                cx += i->w;
+                continue;
+            }
+            if ((x >= cx) && ((x + w) < (cx + i->w))) {
+                qreal w1 = x - cx;
+                qreal w2 = w;
+                qreal w3 = i->w - (w1 + w2);
+                if (w1 > 0.0000001) {
+                    i->w = w1;
+                    ++i;
+                    i = insert(i, x, y, w2);
+                } else {
+                    i->w = w2;
+                    i->y = y;
+                }
+                if (w3 > 0.0000001) {
+                    ++i;
+                    insert(i, x + w2, cy, w3);
+                }
+                return;
+            } else if ((x <= cx) && ((x + w) >= (cx + i->w))) {
+                i->y = y;
+            } else if (x < cx) {
+                qreal w1 = x + w - cx;
+                i->w -= w1;
+                insert(i, cx, y, w1);
+                return;
+            } else {
+                qreal w1 = x - cx;
+                qreal w2 = i->w - w1;
+                if (w2 > 0.0000001) {
+                    i->w = w1;
+                    cx += w1;
+                    ++i;
+                    i = insert(i, cx, y, w2);
+                }
+            }
+            cx += i->w;
+        }
+        if (x >= cx) {
+            if (x > cx) {
+                seg.emplace_back(cx, north ? 1000000.0 : -1000000.0, x - cx);
+            }
+            seg.emplace_back(x, y, w);
+        } else if (x + w > cx) {
+            seg.emplace_back(cx, y, x + w - cx);
+        }
+    }
+
+    qreal minDistance(const ReferenceSkylineLine& sl) const
+    {
+        qreal dist = -1000000.0;
+
+        qreal x1 = 0.0;
+        qreal x2 = 0.0;
+        auto k = sl.seg.begin();
+        for (auto i = seg.begin(); i != seg.end(); ++i) {
+            while (k != sl.seg.end() && (x2 + k->w) < x1) {
+                x2 += k->w;
+                ++k;
+            }
+            if (k == sl.seg.end()) {
+                break;
+            }
+            for (;;) {
+                if ((x1 + i->w > x2) && (x1 < x2 + k->w)) {
+                    dist = qMax(dist, i->y - k->y);
+                }
+                if (x2 + k->w < x1 + i->w) {
+                    x2 += k->w;
+                    ++k;
+                    if (k == sl.seg.end()) {
+                        break;
+                    }
+                } else {
+                    break;
+                }
+            }
+            if (k == sl.seg.end()) {
+                break;
+            }
+            x1 += i->w;
+        }
+        return dist;
+    }
+
+    qreal max() const
+    {
+        qreal val = north ? 1000000.0 : -1000000.0;
+        for (const SkylineSegment& s : seg) {
+            val = north ? qMin(val, s.y) : qMax(val, s.y);
+        }
+        return val;
+    }
+
+    std::vector<SkylineSegment> seg;
+
+private:
+    using SegIter = std::vector<SkylineSegment>::iterator;
+
+    SegIter insert(SegIter i, qreal x, qreal y, qreal w)
+    {
+        const qreal xr = x + w;
+        if (i != seg.end() && xr > i->x) {
+            i->x = xr;
+        }
+        return seg.emplace(i, x, y, w);
+    }
+
+    SegIter find(qreal x)
+    {
+        auto it = std::upper_bound(seg.begin(), seg.end(), x, [](qreal x, const SkylineSegment& s) { return x < s.x; });
+        if (it == seg.begin()) {
+            return it;
+        }
+        return --it;
+    }
+
+    const bool north;
+};
+
+//---------------------------------------------------------
+//   staffRects
+//    rectangles the skylines of every system staff of the
+//    laid out score are built from
+//---------------------------------------------------------
+
+static std::vector<std::vector<RectF> > staffRects(Score* score)
+{
+    std::vector<std::vector<RectF> > result;
+    for (System* system : score->systems()) {
+        for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+            std::vector<RectF> rects;
+            for (MeasureBase* mb : system->measures()) {
+                if (!mb->isMeasure()) {
+                    continue;
+                }
+                Measure* m = toMeasure(mb);
+                rects.push_back(m->staffLines(staffIdx)->bbox().translated(m->pos()));
+                for (const Segment& s : m->segments()) {
+                    for (const ShapeElement& r : s.staffShape(staffIdx)) {
+                        rects.push_back(r.translated(s.pos() + m->pos()));
+                    }
+                }
+            }
+            result.push_back(std::move(rects));
+        }
+    }
+
+    return result;
+}
+
+template<typename Line>
+static Line buildLine(const std::vector<RectF>& rects, bool north)
+{
+    Line line(north);
+    for (const RectF& r : rects) {
+        line.add(r.x(), north ? r.top() : r.bottom(), r.width());
+    }
+    return line;
+}
+
+//---------------------------------------------------------
+//   tstSkylineMatchesReference
+//    Skylines of every staff of a real score must be equal
+//    to the ones built by the reference implementation
+//---------------------------------------------------------
+
+TEST_F(SkylineTests, tstSkylineMatchesReference)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    ASSERT_TRUE(score);
+    score->doLayout();
+
+    std::vector<std::vector<RectF> > rects = staffRects(score);
+    ASSERT_FALSE(rects.empty());
+
+    for (size_t i = 0; i < rects.size(); ++i) {
+        for (bool north : { true, false }) {
+            SkylineLine line = buildLine<SkylineLine>(rects[i], north);
+            ReferenceSkylineLine reference = buildLine<ReferenceSkylineLine>(rects[i], north);
+
+            ASSERT_EQ(line.size(), reference.seg.size());
+            for (size_t j = 0; j < line.size(); ++j) {
+                EXPECT_EQ(line.segment(j).x, reference.seg[j].x);
+                EXPECT_EQ(line.segment(j).y, reference.seg[j].y);
+                EXPECT_EQ(line.segment(j).w, reference.seg[j].w);
+            }
+            EXPECT_EQ(line.max(), reference.max());
+        }
+
+        if (i + 1 < rects.size()) {
+            SkylineLine south = buildLine<SkylineLine>(rects[i], false);
+            SkylineLine north = buildLine<SkylineLine>(rects[i + 1], true);
+            ReferenceSkylineLine referenceSouth = buildLine<ReferenceSkylineLine>(rects[i], false);
+            ReferenceSkylineLine referenceNorth = buildLine<ReferenceSkylineLine>(rects[i + 1], true);
+
+            EXPECT_EQ(south.minDistance(north), referenceSouth.minDistance(referenceNorth));
+        }
+    }
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   tstSkylineOverlappingRects
+//    Rectangles overlapping in every possible way: inside,
+//    across the start or the end of one or several
+//    segments, higher and lower than them, must give the
+//    same skylines as the reference implementation
+//---------------------------------------------------------
+
+TEST_F(SkylineTests, tstSkylineOverlappingRects)
+{
+    // deterministic pseudo random rectangles, so a failure can be reproduced
+    unsigned int seed = 1;
+    auto next = [&seed](unsigned int max) {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) % max;
+    };
+
+    for (int test = 0; test < 50; ++test) {
+        std::vector<RectF> rects;
+        for (int i = 0; i < 40; ++i) {
+            rects.push_back(RectF(next(100), next(20), 1 + next(30), 1 + next(20)));
+        }
+
+        for (bool north : { true, false }) {
+            SkylineLine line = buildLine<SkylineLine>(rects, north);
+            ReferenceSkylineLine reference = buildLine<ReferenceSkylineLine>(rects, north);
+
+            ASSERT_EQ(line.size(), reference.seg.size());
+            for (size_t j = 0; j < line.size(); ++j) {
+                EXPECT_EQ(line.segment(j).x, reference.seg[j].x);
+                EXPECT_EQ(line.segment(j).y, reference.seg[j].y);
+                EXPECT_EQ(line.segment(j).w, reference.seg[j].w);
+            }
+            EXPECT_EQ(line.max(), reference.max());
+        }
+
+        std::vector<RectF> otherRects;
+        for (int i = 0; i < 40; ++i) {
+            otherRects.push_back(RectF(next(100), 30 + next(20), 1 + next(30), 1 + next(20)));
+        }
+
+        SkylineLine south = buildLine<SkylineLine>(rects, false);
+        SkylineLine north = buildLine<SkylineLine>(otherRects, true);
+        ReferenceSkylineLine referenceSouth = buildLine<ReferenceSkylineLine>(rects, false);
+        ReferenceSkylineLine referenceNorth = buildLine<ReferenceSkylineLine>(otherRects, true);
+
+        EXPECT_EQ(south.minDistance(north), referenceSouth.minDistance(referenceNorth));
+    }
+}
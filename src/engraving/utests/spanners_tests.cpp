@@ -22,10 +22,14 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <random>
+
 #include "libmscore/factory.h"
 #include "libmscore/chord.h"
 #include "libmscore/excerpt.h"
 #include "libmscore/glissando.h"
+#include "libmscore/hairpin.h"
 #include "libmscore/layoutbreak.h"
 #include "libmscore/lyrics.h"
 #include "libmscore/measure.h"
@@ -35,10 +39,13 @@
 #include "libmscore/system.h"
 #include "libmscore/undo.h"
 #include "libmscore/line.h"
+#include "libmscore/spannermap.h"
 
 #include "utils/scorerw.h"
 #include "utils/scorecomp.h"
 
+#include "log.h"
+
 static const QString SPANNERS_DATA_DIR("spanners_data/");
 
 using namespace Ms;
@@ -594,3 +601,104 @@ TEST_F(SpannersTests, spanners16)
     EXPECT_TRUE(ScoreComp::saveCompareScore(score, "smallstaff01.mscx", SPANNERS_DATA_DIR + "smallstaff01-ref.mscx"));
     delete score;
 }
+
+//---------------------------------------------------------
+//   spannerMap
+//    bulk insertion of spanners interleaved with range
+//    queries (as in paste and import), the results are
+//    compared with a plain search
+//---------------------------------------------------------
+
+TEST_F(SpannersTests, spannerMap)
+{
+    using clock = std::chrono::steady_clock;
+
+    MasterScore* score = ScoreRW::readScore(SPANNERS_DATA_DIR + "glissando01.mscx");
+    EXPECT_TRUE(score);
+
+    constexpr int SPANNERS_COUNT = 5000;
+    constexpr int TICKS_PER_SPANNER = 120;
+
+    std::mt19937 random(13);
+    std::uniform_int_distribution<int> randomTicks(0, 8 * Constants::division);
+
+    std::vector<Spanner*> spanners;
+    for (int i = 0; i < SPANNERS_COUNT; ++i) {
+        Hairpin* hairpin = Factory::createHairpin(score->dummy()->segment());
+        hairpin->setTick(Fraction::fromTicks(i * TICKS_PER_SPANNER));
+        hairpin->setTicks(Fraction::fromTicks(randomTicks(random)));
+        spanners.push_back(hairpin);
+    }
+
+    auto checkQueries = [&spanners](SpannerMap& map, int start, int stop) {
+        size_t overlapping = 0;
+        size_t contained = 0;
+        for (const Spanner* s : spanners) {
+            if (s->tick2().ticks() >= start && s->tick().ticks() <= stop) {
+                ++overlapping;
+            }
+            if (s->tick().ticks() >= start && s->tick2().ticks() <= stop) {
+                ++contained;
+            }
+        }
+        EXPECT_EQ(map.findOverlapping(start, stop).size(), overlapping);
+        EXPECT_EQ(map.findContained(start, stop).size(), contained);
+    };
+
+    SpannerMap map;
+    size_t found = 0;
+
+    clock::time_point started = clock::now();
+    for (Spanner* s : spanners) {
+        map.addSpanner(s);
+        found += map.findOverlapping(s->tick().ticks(), s->tick2().ticks()).size();
+    }
+    int64_t insertTime = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - started).count();
+    EXPECT_GE(found, spanners.size());
+
+    const int endTick = SPANNERS_COUNT * TICKS_PER_SPANNER;
+    started = clock::now();
+    for (int i = 0; i < 1000; ++i) {
+        int start = static_cast<int>(random() % endTick);
+        found += map.findOverlapping(start, start + Constants::division * 4).size();
+    }
+    int64_t queryTime = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - started).count();
+
+    for (int i = 0; i < 100; ++i) {
+        int start = static_cast<int>(random() % endTick);
+        checkQueries(map, start, start + randomTicks(random));
+    }
+
+    // move and remove some of the spanners
+    for (int i = 0; i < 500; ++i) {
+        Spanner* s = spanners.at(random() % spanners.size());
+        s->setTick(Fraction::fromTicks(static_cast<int>(random() % endTick)));
+        map.updateSpanner(s);
+    }
+    for (int i = 0; i < 500; ++i) {
+        size_t idx = random() % spanners.size();
+        EXPECT_TRUE(map.removeSpanner(spanners.at(idx)));
+        delete spanners.at(idx);
+        spanners.erase(spanners.begin() + idx);
+    }
+    EXPECT_EQ(map.map().size(), spanners.size());
+
+    for (int i = 0; i < 100; ++i) {
+        int start = static_cast<int>(random() % endTick);
+        checkQueries(map, start, start + randomTicks(random));
+    }
+
+    // full rebuild gives the same results
+    map.setDirty();
+    for (int i = 0; i < 100; ++i) {
+        int start = static_cast<int>(random() % endTick);
+        checkQueries(map, start, start + randomTicks(random));
+    }
+
+    LOGI() << "spanner map: insert " << SPANNERS_COUNT << " spanners with queries: " << insertTime << " us, "
+           << "1000 range queries: " << queryTime << " us";
+
+    map.clear();
+    qDeleteAll(spanners);
+    delete score;
+}
@@ -0,0 +1,184 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/undo.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace Ms;
+
+class UndoStackTests : public ::testing::Test
+{
+protected:
+    Note* firstNote(Score* score) const
+    {
+        for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+            EngravingItem* e = s->element(0);
+            if (e && e->isChord()) {
+                return toChord(e)->upNote();
+            }
+        }
+
+        return nullptr;
+    }
+
+    void changeColor(Score* score, Note* note, const draw::Color& color) const
+    {
+        score->startCmd();
+        note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(color));
+        score->endCmd();
+    }
+};
+
+/**
+ * @brief UndoStackTests_MergePropertyChanges
+ * @details The consecutive changes of the same property of the same element in one command
+ *          are merged into one change, which undoes and redoes all of them
+ */
+TEST_F(UndoStackTests, MergePropertyChanges)
+{
+    // [GIVEN] A score with a note
+    MasterScore* score = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score);
+
+    Note* note = firstNote(score);
+    ASSERT_TRUE(note);
+
+    draw::Color initialColor = note->color();
+
+    // [WHEN] The color of the note is changed three times in one command
+    score->startCmd();
+    note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(draw::Color::redColor));
+    note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(draw::Color::greenColor));
+    note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(draw::Color::blueColor));
+    score->endCmd();
+
+    // [THEN] The command contains only one change of the color
+    size_t colorChanges = 0;
+    for (const UndoCommand* cmd : score->undoStack()->last()->commands()) {
+        const ChangeProperty* change = dynamic_cast<const ChangeProperty*>(cmd);
+        if (change && change->getElement() == note && change->getId() == Pid::COLOR) {
+            ++colorChanges;
+        }
+    }
+    EXPECT_EQ(colorChanges, 1);
+
+    // [THEN] Undo restores the initial color, redo sets the last one
+    EditData ed;
+    score->undoStack()->undo(&ed);
+    EXPECT_EQ(note->color(), initialColor);
+
+    score->undoStack()->redo(&ed);
+    EXPECT_EQ(note->color(), draw::Color::blueColor);
+
+    delete score;
+}
+
+/**
+ * @brief UndoStackTests_MemoryLimit
+ * @details The oldest commands are removed when the history uses more memory than allowed,
+ *          the last command is always kept and the indices of the stack don't change
+ */
+TEST_F(UndoStackTests, MemoryLimit)
+{
+    // [GIVEN] A score with a history of 10 commands
+    MasterScore* score = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score);
+
+    Note* note = firstNote(score);
+    ASSERT_TRUE(note);
+
+    UndoStack* undoStack = score->undoStack();
+    undoStack->setMemoryLimit(0);
+
+    for (int i = 0; i < 10; ++i) {
+        changeColor(score, note, i % 2 ? draw::Color::redColor : draw::Color::blueColor);
+    }
+
+    size_t curIdx = undoStack->getCurIdx();
+    size_t lastMacroUsage = undoStack->last()->memoryUsage();
+    EXPECT_GT(lastMacroUsage, 0);
+    EXPECT_GE(undoStack->memoryUsage(), 10 * lastMacroUsage / 2);
+
+    // [WHEN] The limit allows to keep about two commands
+    undoStack->setMemoryLimit(lastMacroUsage * 2);
+
+    // [THEN] The history fits the limit, the index is the same
+    EXPECT_LE(undoStack->memoryUsage(), lastMacroUsage * 2);
+    EXPECT_EQ(undoStack->getCurIdx(), curIdx);
+    EXPECT_TRUE(undoStack->canUndo());
+
+    // [WHEN] The next command is done
+    changeColor(score, note, draw::Color::greenColor);
+
+    // [THEN] The history still fits the limit
+    EXPECT_LE(undoStack->memoryUsage(), lastMacroUsage * 2);
+    EXPECT_EQ(undoStack->getCurIdx(), curIdx + 1);
+
+    // [THEN] Only the kept commands can be undone
+    EditData ed;
+    size_t undoCount = 0;
+    while (undoStack->canUndo()) {
+        undoStack->undo(&ed);
+        ++undoCount;
+    }
+    EXPECT_GE(undoCount, 1);
+    EXPECT_LE(undoCount, 2);
+
+    delete score;
+}
+
+/**
+ * @brief UndoStackTests_RemovedMeasureMemoryUsage
+ * @details The memory usage of the command removing a measure includes the elements of the measure
+ */
+TEST_F(UndoStackTests, RemovedMeasureMemoryUsage)
+{
+    // [GIVEN] A score with a note in the first measure
+    MasterScore* score = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score);
+
+    Note* note = firstNote(score);
+    ASSERT_TRUE(note);
+
+    Measure* measure = note->chord()->measure();
+
+    // [WHEN] The measure is removed
+    score->startCmd();
+    score->deleteMeasures(measure, measure);
+    score->endCmd();
+
+    // [THEN] The command counts the removed measure with its segments, chords and notes
+    size_t minUsage = sizeof(Measure) + sizeof(Segment) + sizeof(Chord) + sizeof(Note);
+    EXPECT_GT(score->undoStack()->last()->memoryUsage(), minUsage);
+
+    delete score;
+}
@@ -114,7 +114,7 @@ void AbstractSynthesizer::revokePlayingNotes()
 
 bool AbstractSynthesizer::isActive() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_POOL_THREAD;
 
     return m_isActive;
 }
@@ -128,7 +128,7 @@ void AbstractSynthesizer::setIsActive(bool arg)
 
 audio::msecs_t AbstractSynthesizer::samplesToMsecs(const samples_t samplesPerChannel, const samples_t sampleRate) const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_POOL_THREAD;
 
     return samplesPerChannel * 1000 / sampleRate;
 }
@@ -142,14 +142,14 @@ msecs_t AbstractSynthesizer::actualPlaybackPositionStart() const
 
 audio::msecs_t mu::audio::synth::AbstractSynthesizer::playbackPosition() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_POOL_THREAD;
 
     return m_playbackPosition;
 }
 
 void AbstractSynthesizer::setPlaybackPosition(const msecs_t newPosition)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_POOL_THREAD;
 
     m_playbackPosition = newPosition;
 }
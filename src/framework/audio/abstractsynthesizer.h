@@ -23,6 +23,9 @@
 #ifndef MU_AUDIO_ISYNTHESIZER_H
 #define MU_AUDIO_ISYNTHESIZER_H
 
+#include <algorithm>
+#include <vector>
+
 #include "async/channel.h"
 #include "async/asyncable.h"
 #include "mpe/events.h"
@@ -72,6 +75,11 @@ protected:
 
         void load(const mpe::PlaybackEventsMap& events)
         {
+            //! NOTE The actual timestamps are not in the order of the nominal ones,
+            //! so the events are sorted once and then appended to the end of the flat map,
+            //! instead of being inserted into the middle of it one by one
+            std::vector<std::pair<mpe::timestamp_t, const mpe::PlaybackEvent*> > noteEvents;
+
             for (const auto& pair : events) {
                 for (const mpe::PlaybackEvent& event : pair.second) {
                     if (!std::holds_alternative<mpe::NoteEvent>(event)) {
@@ -80,9 +88,18 @@ protected:
 
                     mpe::timestamp_t actualTimestamp = std::get<mpe::NoteEvent>(event).arrangementCtx().actualTimestamp;
 
-                    m_events[actualTimestamp].emplace_back(event);
+                    noteEvents.emplace_back(actualTimestamp, &event);
                 }
             }
+
+            std::stable_sort(noteEvents.begin(), noteEvents.end(), [](const auto& first, const auto& second) {
+                return first.first < second.first;
+            });
+
+            for (const auto& pair : noteEvents) {
+                m_events[pair.first].emplace_back(*pair.second);
+            }
+
             updateBoundaries();
         }
 
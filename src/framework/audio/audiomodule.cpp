@@ -106,6 +106,7 @@ void AudioModule::registerExports()
     ioc()->registerExport<IAudioThreadSecurer>(moduleName(), std::make_shared<AudioThreadSecurer>());
     ioc()->registerExport<IAudioDriver>(moduleName(), s_audioDriver);
     ioc()->registerExport<IPlayback>(moduleName(), s_playbackFacade);
+    ioc()->registerExport<IAudioBuffer>(moduleName(), s_audioBuffer);
 
     ioc()->registerExport<ISynthResolver>(moduleName(), s_synthResolver);
     ioc()->registerExport<IFxResolver>(moduleName(), s_fxResolver);
@@ -194,6 +195,7 @@ void AudioModule::onInit(const framework::IApplication::RunMode& mode)
         AudioEngine::instance()->setAudioChannelsCount(s_audioConfiguration->audioChannelsCount());
         AudioEngine::instance()->setSampleRate(activeSpec.sampleRate);
         AudioEngine::instance()->setReadBufferSize(activeSpec.samples);
+        AudioEngine::instance()->setMixerThreadsCount(s_audioConfiguration->mixerThreadsCount());
 
         auto fluidResolver = std::make_shared<FluidResolver>(s_audioConfiguration->soundFontDirectories(),
                                                              s_audioConfiguration->soundFontDirectoriesChanged());
@@ -231,6 +231,9 @@ struct AudioSignalVal {
 
 using AudioSignalChanges = async::Channel<audioch_t, AudioSignalVal>;
 
+//! NOTE Share of the real time, which is spent on rendering of the track
+using AudioDspLoadChanges = async::Channel<TrackId, float>;
+
 struct AudioSignalsNotifier {
     void updateSignalValues(const audioch_t audioChNumber, const float newAmplitude, const volume_dbfs_t newPressure)
     {
@@ -33,6 +33,7 @@ WaveFormModel::WaveFormModel(QObject* parent)
     playback()->audioOutput()->masterSignalChanges().onResolve(this, [this](AudioSignalChanges signalChanges) {
         signalChanges.onReceive(this, [this](const audioch_t, const AudioSignalVal& newValue) {
             setCurrentSignalAmplitude(newValue.amplitude);
+            updateXrunCount();
 
             if (newValue.pressure < MIN_DISPLAYED_DBFS) {
                 setCurrentVolumePressure(MIN_DISPLAYED_DBFS);
@@ -65,6 +66,22 @@ volume_dbfs_t WaveFormModel::currentVolumePressure() const
     return m_currentVolumePressure;
 }
 
+int WaveFormModel::xrunCount() const
+{
+    return m_xrunCount;
+}
+
+void WaveFormModel::updateXrunCount()
+{
+    int xrunCount = audioBuffer() ? static_cast<int>(audioBuffer()->xrunCount()) : 0;
+    if (m_xrunCount == xrunCount) {
+        return;
+    }
+
+    m_xrunCount = xrunCount;
+    emit xrunCountChanged(m_xrunCount);
+}
+
 void WaveFormModel::setAvailableSources(QStringList availableSources)
 {
     if (m_availableSources == availableSources) {
@@ -30,6 +30,7 @@
 
 #include "iaudiooutput.h"
 #include "iplayback.h"
+#include "internal/iaudiobuffer.h"
 
 namespace mu::audio {
 class WaveFormModel : public QObject, public async::Asyncable
@@ -37,6 +38,7 @@ class WaveFormModel : public QObject, public async::Asyncable
     Q_OBJECT
 
     INJECT(audio, IPlayback, playback)
+    INJECT(audio, IAudioBuffer, audioBuffer)
 
     Q_PROPERTY(QStringList availableSources READ availableSources NOTIFY availableSourcesChanged)
     Q_PROPERTY(QString currentSourceName READ currentSourceName WRITE setCurrentSourceName NOTIFY currentSourceNameChanged)
@@ -44,6 +46,8 @@ class WaveFormModel : public QObject, public async::Asyncable
     Q_PROPERTY(float currentSignalAmplitude READ currentSignalAmplitude NOTIFY currentSignalAmplitudeChanged)
     Q_PROPERTY(float currentVolumePressure READ currentVolumePressure NOTIFY currentVolumePressureChanged)
 
+    Q_PROPERTY(int xrunCount READ xrunCount NOTIFY xrunCountChanged)
+
     Q_PROPERTY(float minDisplayedDbfs READ minDisplayedDbfs CONSTANT)
     Q_PROPERTY(float maxDisplayedDbfs READ maxDisplayedDbfs CONSTANT)
 
@@ -55,6 +59,7 @@ public:
 
     float currentSignalAmplitude() const;
     float currentVolumePressure() const;
+    int xrunCount() const;
 
     float minDisplayedDbfs() const;
     float maxDisplayedDbfs() const;
@@ -75,13 +80,17 @@ signals:
 
     void currentSignalAmplitudeChanged(float currentSignalAmplitude);
     void currentVolumePressureChanged(float currentVolumePressure);
+    void xrunCountChanged(int xrunCount);
 
 private:
+    void updateXrunCount();
+
     QStringList m_availableSources;
     QString m_currentSourceName;
 
     float m_currentSignalAmplitude = 0.f;
     float m_currentVolumePressure = 0.f;
+    int m_xrunCount = 0;
 };
 }
 
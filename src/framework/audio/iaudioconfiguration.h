@@ -46,6 +46,9 @@ public:
     virtual audioch_t audioChannelsCount() const = 0;
     virtual unsigned int driverBufferSize() const = 0; // samples
 
+    //! NOTE 0 - tracks are mixed on the audio worker thread only
+    virtual size_t mixerThreadsCount() const = 0;
+
     // synthesizers
     virtual AudioInputParams defaultAudioInputParams() const = 0;
     virtual io::paths_t soundFontDirectories() const = 0;
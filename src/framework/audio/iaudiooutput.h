@@ -27,6 +27,7 @@
 
 #include "async/promise.h"
 #include "async/channel.h"
+#include "global/progress.h"
 
 #include "audiotypes.h"
 
@@ -48,9 +49,11 @@ public:
 
     virtual async::Promise<AudioSignalChanges> signalChanges(const TrackSequenceId sequenceId, const TrackId trackId) const = 0;
     virtual async::Promise<AudioSignalChanges> masterSignalChanges() const = 0;
+    virtual async::Promise<AudioDspLoadChanges> dspLoadChanges() const = 0;
 
     virtual async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                 const SoundTrackFormat& format) = 0;
+    virtual async::Channel<TrackSequenceId, framework::Progress> saveSoundTrackProgressChanged() const = 0;
 };
 
 using IAudioOutputPtr = std::shared_ptr<IAudioOutput>;
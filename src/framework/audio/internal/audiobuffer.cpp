@@ -27,99 +27,113 @@
 
 using namespace mu::audio;
 
-void AudioBuffer::init(const audioch_t audioChannelsCount, const samples_t samplesPerChannel)
+static size_t nextPowerOfTwo(size_t value)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+
+    return result;
+}
 
-    m_samplesPerChannel = samplesPerChannel;
+void AudioBuffer::init(const audioch_t audioChannelsCount, const samples_t samplesPerChannel)
+{
     m_audioChannelsCount = audioChannelsCount;
 
-    m_data.resize(m_samplesPerChannel * m_audioChannelsCount, 0.f);
+    size_t capacity = nextPowerOfTwo(samplesPerChannel * audioChannelsCount);
+    m_mask = capacity - 1;
+
+    m_data.assign(capacity, 0.f);
+    m_fillBuffer.assign(FILL_SAMPLES * audioChannelsCount, 0.f);
+
+    m_writeIndex.store(0, std::memory_order_relaxed);
+    m_readIndex.store(0, std::memory_order_relaxed);
+    m_xrunCount.store(0, std::memory_order_relaxed);
 }
 
 void AudioBuffer::setSource(std::shared_ptr<IAudioSource> source)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
     m_source = source;
+    m_hasSource.store(m_source != nullptr, std::memory_order_release);
 }
 
 void AudioBuffer::forward()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
     fillup();
 }
 
 void AudioBuffer::pop(float* dest, size_t sampleCount)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    const size_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+    const size_t writeIndex = m_writeIndex.load(std::memory_order_acquire);
 
-    size_t from = m_readIndex;
-    auto memStep = sizeof(float);
-    size_t to = m_readIndex + sampleCount * m_audioChannelsCount;
-    if (to > m_data.size()) {
-        to = m_data.size();
-    }
-    auto count = to - from;
-    std::memcpy(dest, m_data.data() + from, count * memStep);
-    m_readIndex += count;
-
-    size_t left = sampleCount * m_audioChannelsCount - count;
-    if (left > 0) {
-        std::memcpy(dest + count, m_data.data(), left * memStep);
-        m_readIndex = left;
-    }
+    const size_t required = sampleCount * m_audioChannelsCount;
+    const size_t count = std::min(writeIndex - readIndex, required);
+
+    const size_t from = readIndex & m_mask;
+    const size_t firstPart = std::min(count, m_data.size() - from);
+    std::memcpy(dest, m_data.data() + from, firstPart * sizeof(float));
+    std::memcpy(dest + firstPart, m_data.data(), (count - firstPart) * sizeof(float));
+
+    m_readIndex.store(readIndex + count, std::memory_order_release);
 
-    if (m_readIndex >= m_data.size()) {
-        m_readIndex -= m_data.size();
+    if (count < required) {
+        std::memset(dest + count, 0, (required - count) * sizeof(float));
+
+        if (m_hasSource.load(std::memory_order_acquire)) {
+            m_xrunCount.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 }
 
 void AudioBuffer::setMinSampleLag(size_t lag)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    IF_ASSERT_FAILED(lag < m_data.size()) {
-        lag = m_data.size();
+    size_t maxLag = m_data.size() / m_audioChannelsCount - FILL_SAMPLES - FILL_OVER;
+    IF_ASSERT_FAILED(lag < maxLag) {
+        lag = maxLag;
     }
     m_minSampleLag = lag;
 }
 
+uint64_t AudioBuffer::xrunCount() const
+{
+    return m_xrunCount.load(std::memory_order_relaxed);
+}
+
 void AudioBuffer::fillup()
 {
     if (!m_source) {
         return;
     }
 
-    while (sampleLag() < m_minSampleLag + FILL_OVER) {
-        m_source->process(m_data.data() + m_writeIndex, FILL_SAMPLES);
-        updateWriteIndex(FILL_SAMPLES);
-    }
-}
+    const size_t chunkSize = FILL_SAMPLES * m_audioChannelsCount;
+    size_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
 
-void AudioBuffer::updateWriteIndex(const unsigned int samplesPerChannel)
-{
-    size_t from = m_writeIndex;
+    while (sampleLag(writeIndex, m_readIndex.load(std::memory_order_acquire)) < m_minSampleLag + FILL_OVER) {
+        const size_t to = writeIndex & m_mask;
 
-    auto to = m_writeIndex + samplesPerChannel * m_audioChannelsCount;
-    if (to > m_data.size()) {
-        to = m_data.size() - 1;
-    }
-    auto count = to - from;
-    m_writeIndex += count;
+        if (to + chunkSize <= m_data.size()) {
+            m_source->process(m_data.data() + to, FILL_SAMPLES);
+        } else {
+            m_source->process(m_fillBuffer.data(), FILL_SAMPLES);
+            write(m_fillBuffer.data(), chunkSize, writeIndex);
+        }
 
-    if (m_writeIndex >= m_data.size()) {
-        m_writeIndex -= m_data.size();
+        writeIndex += chunkSize;
+        m_writeIndex.store(writeIndex, std::memory_order_release);
     }
 }
 
-unsigned int AudioBuffer::sampleLag() const
+void AudioBuffer::write(const float* src, size_t count, size_t writeIndex)
 {
-    size_t lag = 0;
-    if (m_readIndex <= m_writeIndex) {
-        lag = m_writeIndex - m_readIndex;
-    } else {
-        lag = m_writeIndex + m_data.size() - m_readIndex;
-    }
+    const size_t to = writeIndex & m_mask;
+    const size_t firstPart = std::min(count, m_data.size() - to);
+    std::memcpy(m_data.data() + to, src, firstPart * sizeof(float));
+    std::memcpy(m_data.data(), src + firstPart, (count - firstPart) * sizeof(float));
+}
 
-    return static_cast<unsigned int>(lag / m_audioChannelsCount);
+size_t AudioBuffer::sampleLag(size_t writeIndex, size_t readIndex) const
+{
+    return (writeIndex - readIndex) / m_audioChannelsCount;
 }
@@ -31,12 +31,19 @@
 #include "iaudiobuffer.h"
 
 namespace mu::audio {
+//! NOTE Wait-free single producer / single consumer ring buffer.
+//! The producer is the worker thread (forward, setSource, setMinSampleLag),
+//! the consumer is the driver thread (pop).
+//! Read and write indices are monotonic counters of floats,
+//! the capacity is a power of two, so the position in the data is (index & mask)
 class AudioBuffer : public IAudioBuffer
 {
     static const samples_t DEFAULT_SIZE = 16384;
     static const samples_t FILL_SAMPLES = 1024;
     static const samples_t FILL_OVER    = 1024;
 
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
 public:
     AudioBuffer() = default;
 
@@ -48,20 +55,25 @@ public:
     void pop(float* dest, size_t sampleCount) override;
     void setMinSampleLag(size_t lag) override;
 
+    uint64_t xrunCount() const override;
+
 private:
 
-    unsigned int sampleLag() const;
+    size_t sampleLag(size_t writeIndex, size_t readIndex) const;
     void fillup();
-    void updateWriteIndex(const unsigned int samplesPerChannel);
+    void write(const float* src, size_t count, size_t writeIndex);
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_writeIndex = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_readIndex = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_xrunCount = 0;
+    std::atomic<bool> m_hasSource = false;
 
-    std::mutex m_mutex;
     size_t m_minSampleLag = FILL_SAMPLES;
-    size_t m_writeIndex = 0;
-    size_t m_readIndex = 0;
-    samples_t m_samplesPerChannel = 0;
+    size_t m_mask = 0;
     audioch_t m_audioChannelsCount = 0;
 
-    std::vector<float> m_data = {};
+    std::vector<float> m_data;
+    std::vector<float> m_fillBuffer;
     std::shared_ptr<IAudioSource> m_source = nullptr;
 };
 }
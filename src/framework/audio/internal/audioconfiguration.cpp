@@ -41,6 +41,7 @@ static const audioch_t AUDIO_CHANNELS = 2;
 //TODO: add other setting: audio device etc
 static const Settings::Key AUDIO_API_KEY("audio", "io/audioApi");
 static const Settings::Key AUDIO_BUFFER_SIZE("audio", "driver_buffer");
+static const Settings::Key AUDIO_MIXER_THREADS_COUNT("audio", "mixer_threads");
 
 static const Settings::Key USER_SOUNDFONTS_PATHS("midi", "application/paths/mySoundfonts");
 
@@ -57,6 +58,7 @@ void AudioConfiguration::init()
     defaultBufferSize = 1024;
 #endif
     settings()->setDefaultValue(AUDIO_BUFFER_SIZE, Val(defaultBufferSize));
+    settings()->setDefaultValue(AUDIO_MIXER_THREADS_COUNT, Val(0));
 
     settings()->setDefaultValue(AUDIO_API_KEY, Val("Core Audio"));
 
@@ -102,6 +104,11 @@ unsigned int AudioConfiguration::driverBufferSize() const
     return settings()->value(AUDIO_BUFFER_SIZE).toInt();
 }
 
+size_t AudioConfiguration::mixerThreadsCount() const
+{
+    return static_cast<size_t>(std::max(settings()->value(AUDIO_MIXER_THREADS_COUNT).toInt(), 0));
+}
+
 SoundFontPaths AudioConfiguration::soundFontDirectories() const
 {
     SoundFontPaths paths = userSoundFontDirectories();
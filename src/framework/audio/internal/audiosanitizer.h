@@ -39,11 +39,17 @@ public:
     static void setupWorkerThread();
     static std::thread::id workerThread();
     static bool isWorkerThread();
+
+    //! NOTE Threads of AudioWorkerPool render mixer channels on behalf of the worker thread
+    static void setupWorkerPoolThread();
+    static bool isWorkerPoolThread();
 };
 }
 
 #define ONLY_AUDIO_WORKER_THREAD assert(mu::audio::AudioSanitizer::isWorkerThread())
 #define ONLY_AUDIO_MAIN_THREAD assert(mu::audio::AudioSanitizer::isMainThread())
 #define ONLY_AUDIO_MAIN_OR_WORKER_THREAD assert((mu::audio::AudioSanitizer::isWorkerThread() || mu::audio::AudioSanitizer::isMainThread()))
+#define ONLY_AUDIO_WORKER_OR_POOL_THREAD assert((mu::audio::AudioSanitizer::isWorkerThread() \
+                                                 || mu::audio::AudioSanitizer::isWorkerPoolThread()))
 
 #endif // MU_AUDIO_AUDIOSANITIZER_H
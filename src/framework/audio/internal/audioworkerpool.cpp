@@ -0,0 +1,178 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audioworkerpool.h"
+
+#include "runtime.h"
+
+#include "audiosanitizer.h"
+
+using namespace mu::audio;
+
+//! NOTE How long a helper thread waits for the next batch actively, and how long it sleeps at most
+static constexpr int SPIN_ITERATIONS = 2000;
+static constexpr std::chrono::milliseconds SLEEP_TIMEOUT(2);
+
+static constexpr uint64_t makeNext(uint32_t generation, uint32_t idx)
+{
+    return (static_cast<uint64_t>(generation) << 32) | idx;
+}
+
+AudioWorkerPool::~AudioWorkerPool()
+{
+    stop();
+}
+
+void AudioWorkerPool::start(size_t threadsCount)
+{
+    stop();
+
+    m_running.store(true, std::memory_order_release);
+
+    for (size_t i = 0; i < threadsCount; ++i) {
+        m_threads.emplace_back([this]() {
+            threadLoop();
+        });
+    }
+}
+
+void AudioWorkerPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running.store(false, std::memory_order_release);
+    }
+
+    m_sleepCv.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+
+    m_threads.clear();
+}
+
+size_t AudioWorkerPool::threadsCount() const
+{
+    return m_threads.size();
+}
+
+void AudioWorkerPool::run(const Task& task, size_t tasksCount)
+{
+    if (m_threads.empty() || tasksCount < 2) {
+        for (size_t idx = 0; idx < tasksCount; ++idx) {
+            task(idx);
+        }
+        return;
+    }
+
+    uint32_t generation = m_generation.load(std::memory_order_relaxed) + 1;
+    size_t slot = generation % 2;
+    m_tasks[slot].store(&task, std::memory_order_release);
+    m_tasksCounts[slot].store(static_cast<uint32_t>(tasksCount), std::memory_order_release);
+    m_doneCount.store(0, std::memory_order_relaxed);
+    m_next.store(makeNext(generation, 0), std::memory_order_release);
+    m_generation.store(generation, std::memory_order_seq_cst);
+
+    if (m_sleepingCount.load(std::memory_order_seq_cst) > 0) {
+        m_sleepCv.notify_all();
+    }
+
+    processTasks(generation);
+
+    while (m_doneCount.load(std::memory_order_acquire) < tasksCount) {
+        std::this_thread::yield();
+    }
+}
+
+void AudioWorkerPool::threadLoop()
+{
+    mu::runtime::setThreadName("audio_worker_pool");
+    AudioSanitizer::setupWorkerPoolThread();
+
+    uint32_t lastGeneration = m_generation.load(std::memory_order_acquire);
+
+    while (waitBatch(lastGeneration)) {
+        lastGeneration = m_generation.load(std::memory_order_acquire);
+        processTasks(lastGeneration);
+    }
+}
+
+bool AudioWorkerPool::waitBatch(uint32_t lastGeneration)
+{
+    auto isPublished = [this, lastGeneration]() {
+        return m_generation.load(std::memory_order_acquire) != lastGeneration;
+    };
+
+    for (int i = 0; i < SPIN_ITERATIONS; ++i) {
+        if (!m_running.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        if (isPublished()) {
+            return true;
+        }
+
+        std::this_thread::yield();
+    }
+
+    while (m_running.load(std::memory_order_acquire)) {
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepingCount.fetch_add(1, std::memory_order_seq_cst);
+        m_sleepCv.wait_for(lock, SLEEP_TIMEOUT, [this, &isPublished]() {
+            return !m_running.load(std::memory_order_acquire) || isPublished();
+        });
+        m_sleepingCount.fetch_sub(1, std::memory_order_seq_cst);
+
+        if (isPublished()) {
+            return m_running.load(std::memory_order_acquire);
+        }
+    }
+
+    return false;
+}
+
+void AudioWorkerPool::processTasks(uint32_t generation)
+{
+    size_t slot = generation % 2;
+    const Task* task = m_tasks[slot].load(std::memory_order_acquire);
+    uint32_t tasksCount = m_tasksCounts[slot].load(std::memory_order_acquire);
+    uint64_t next = m_next.load(std::memory_order_acquire);
+
+    while (true) {
+        uint32_t nextGeneration = static_cast<uint32_t>(next >> 32);
+        uint32_t idx = static_cast<uint32_t>(next);
+
+        //! NOTE A thread, which woke up late, must not take tasks of the next batch
+        if (nextGeneration != generation || idx >= tasksCount) {
+            return;
+        }
+
+        if (!m_next.compare_exchange_weak(next, makeNext(generation, idx + 1), std::memory_order_acq_rel)) {
+            continue;
+        }
+
+        (*task)(idx);
+
+        m_doneCount.fetch_add(1, std::memory_order_release);
+        next = m_next.load(std::memory_order_acquire);
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_AUDIOWORKERPOOL_H
+#define MU_AUDIO_AUDIOWORKERPOOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mu::audio {
+//! NOTE Helper threads of the audio worker.
+//! The worker thread publishes a batch of independent tasks,
+//! takes part in processing itself, and waits until all of them are done.
+//! Threads claim tasks one by one from a shared counter, so a thread that finished
+//! its cheap tasks takes over the remaining ones.
+//!
+//! The worker thread never takes a lock: a batch is published with atomics,
+//! the helper threads spin for a while and only then go to sleep.
+//! The sleeping threads are woken up without the mutex, so a wake up may be missed,
+//! but then the thread just sleeps until its timeout and the worker thread
+//! processes the tasks itself
+class AudioWorkerPool
+{
+public:
+    using Task = std::function<void (size_t idx)>;
+
+    AudioWorkerPool() = default;
+    ~AudioWorkerPool();
+
+    void start(size_t threadsCount);
+    void stop();
+
+    size_t threadsCount() const;
+
+    //! Calls task(idx) for every idx in [0, tasksCount); returns when all calls are finished
+    void run(const Task& task, size_t tasksCount);
+
+private:
+    void threadLoop();
+    bool waitBatch(uint32_t lastGeneration);
+    void processTasks(uint32_t generation);
+
+    std::vector<std::thread> m_threads;
+
+    std::atomic<bool> m_running = false;
+
+    //! NOTE The batch of a generation is kept in the slot [generation % 2],
+    //! so a thread, which woke up late, never reads a half published batch
+    std::atomic<const Task*> m_tasks[2] = { nullptr, nullptr };
+    std::atomic<uint32_t> m_tasksCounts[2] = { 0, 0 };
+    std::atomic<uint32_t> m_generation = 0;
+
+    //! high 32 bits - batch generation, low 32 bits - index of the next task
+    std::atomic<uint64_t> m_next = 0;
+    std::atomic<size_t> m_doneCount = 0;
+
+    std::atomic<size_t> m_sleepingCount = 0;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCv;
+};
+}
+
+#endif // MU_AUDIO_AUDIOWORKERPOOL_H
@@ -43,7 +43,7 @@ public:
         closeDestination();
     }
 
-    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t /*totalSamplesNumber*/)
     {
         if (!format.isValid()) {
             return false;
@@ -55,8 +55,6 @@ public:
             return false;
         }
 
-        prepareOutputBuffer(totalSamplesNumber);
-
         return true;
     }
 
@@ -65,11 +63,15 @@ public:
         return m_format;
     }
 
+    //! NOTE: Encodes one block of interleaved samples,
+    //! returns the number of consumed input samples or 0 on failure
     virtual size_t encode(samples_t samplesPerChannel, const float* input) = 0;
     virtual size_t flush() = 0;
 
 protected:
-    virtual size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const = 0;
+    //! NOTE: Encoding is done block by block, so the output buffer
+    //! only has to hold the result of a single block
+    virtual size_t requiredOutputBufferSize(samples_t samplesPerChannel) const = 0;
 
     virtual bool openDestination(const io::path_t& path)
     {
@@ -82,9 +84,13 @@ protected:
         return true;
     }
 
-    virtual void prepareOutputBuffer(const samples_t totalSamplesNumber)
+    void prepareOutputBuffer(const samples_t samplesPerChannel)
     {
-        m_outputBuffer.resize(requiredOutputBufferSize(totalSamplesNumber));
+        size_t requiredSize = requiredOutputBufferSize(samplesPerChannel);
+
+        if (m_outputBuffer.size() < requiredSize) {
+            m_outputBuffer.resize(requiredSize);
+        }
     }
 
     virtual void closeDestination()
@@ -91,29 +91,48 @@ private:
     SoundTrackFormat m_format;
 };
 
-size_t Mp3Encoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t Mp3Encoder::requiredOutputBufferSize(samples_t samplesPerChannel) const
 {
-    //!Note See thirdparty/lame/API
+    //!Note See thirdparty/lame/API, the worst case estimation is 1.25 * num_samples + 7200
 
-    return totalSamplesNumber;
+    return 5 * samplesPerChannel / 4 + 7200;
 }
 
 size_t Mp3Encoder::encode(samples_t samplesPerChannel, const float* input)
 {
     LameHandler::instance()->updateSpec(m_format);
+    prepareOutputBuffer(samplesPerChannel);
 
     int encodedBytes = lame_encode_buffer_interleaved_ieee_float(LameHandler::instance()->flags, input, samplesPerChannel,
                                                                  m_outputBuffer.data(),
                                                                  static_cast<int>(m_outputBuffer.size()));
 
-    return std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
+    if (encodedBytes < 0) {
+        LOGE() << "Unable to encode block, error: " << encodedBytes;
+        return 0;
+    }
+
+    //! NOTE: LAME buffers the input internally, so an encoded block may legitimately produce no output
+    size_t writtenBytes = std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
+    if (writtenBytes != static_cast<size_t>(encodedBytes)) {
+        return 0;
+    }
+
+    return samplesPerChannel * m_format.audioChannelsNumber;
 }
 
 size_t Mp3Encoder::flush()
 {
+    prepareOutputBuffer(0);
+
     int encodedBytes = lame_encode_flush(LameHandler::instance()->flags,
                                          m_outputBuffer.data(),
                                          static_cast<int>(m_outputBuffer.size()));
 
+    if (encodedBytes < 0) {
+        LOGE() << "Unable to flush encoder, error: " << encodedBytes;
+        return 0;
+    }
+
     return std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
 }
@@ -31,15 +31,22 @@ using namespace mu::audio::encode;
 
 size_t OggEncoder::encode(samples_t samplesPerChannel, const float* input)
 {
-    return ope_encoder_write_float(m_opusEncoder, input, samplesPerChannel + m_format.sampleRate * 2);
+    int result = ope_encoder_write_float(m_opusEncoder, input, static_cast<int>(samplesPerChannel));
+    if (result != OPE_OK) {
+        LOGE() << "Unable to encode block, error: " << ope_strerror(result);
+        return 0;
+    }
+
+    return samplesPerChannel * m_format.audioChannelsNumber;
 }
 
 size_t OggEncoder::flush()
 {
-    return ope_encoder_flush_header(m_opusEncoder);
+    //! NOTE: Drains the samples buffered by the encoder and finalizes the stream
+    return ope_encoder_drain(m_opusEncoder);
 }
 
-size_t OggEncoder::requiredOutputBufferSize(samples_t /*totalSamplesNumber*/) const
+size_t OggEncoder::requiredOutputBufferSize(samples_t /*samplesPerChannel*/) const
 {
     return 0;
 }
@@ -87,46 +87,63 @@ size_t WavEncoder::encode(samples_t samplesPerChannel, const float* input)
         return 0;
     }
 
-    WavHeader header;
-    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
-    header.bitsPerSample = 32;
-    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
-    header.audioChannelsNumber = m_format.audioChannelsNumber;
-    header.sampleRate = m_format.sampleRate;
-    header.samplesPerChannel = samplesPerChannel;
-
-    header.write(m_fileStream);
+    size_t samplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
+    m_fileStream.write(reinterpret_cast<const char*>(input), samplesNumber * sizeof(float));
 
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel; ++sampleIdx) {
-        for (audioch_t audioChNum = 0; audioChNum < m_format.audioChannelsNumber; ++audioChNum) {
-            int idx = sampleIdx * m_format.audioChannelsNumber + audioChNum;
-            m_fileStream.write(reinterpret_cast<const char*>(input + idx), 4);
-        }
-    }
+    m_writtenSamplesPerChannel += samplesPerChannel;
 
-    return samplesPerChannel * m_format.audioChannelsNumber;
+    return samplesNumber;
 }
 
 size_t WavEncoder::flush()
 {
-    NOT_SUPPORTED;
+    if (!m_fileStream.is_open()) {
+        return 0;
+    }
 
-    return 0;
+    //! NOTE: The samples number is unknown until the last block has been encoded,
+    //! so the header written on open is rewritten in place
+    m_fileStream.seekp(0);
+    writeHeader();
+    m_fileStream.seekp(0, std::ios_base::end);
+    m_fileStream.flush();
+
+    return m_writtenSamplesPerChannel * m_format.audioChannelsNumber;
 }
 
-size_t WavEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t WavEncoder::requiredOutputBufferSize(samples_t /*samplesPerChannel*/) const
 {
-    return totalSamplesNumber;
+    return 0;
 }
 
 bool WavEncoder::openDestination(const io::path_t& path)
 {
     m_fileStream.open(path.toStdString(), std::ios_base::binary);
 
-    return m_fileStream.is_open();
+    if (!m_fileStream.is_open()) {
+        return false;
+    }
+
+    m_writtenSamplesPerChannel = 0;
+    writeHeader();
+
+    return true;
 }
 
 void WavEncoder::closeDestination()
 {
     m_fileStream.close();
 }
+
+void WavEncoder::writeHeader()
+{
+    WavHeader header;
+    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
+    header.bitsPerSample = 32;
+    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
+    header.audioChannelsNumber = m_format.audioChannelsNumber;
+    header.sampleRate = m_format.sampleRate;
+    header.samplesPerChannel = static_cast<uint32_t>(m_writtenSamplesPerChannel);
+
+    header.write(m_fileStream);
+}
@@ -40,7 +40,10 @@ protected:
     void closeDestination() override;
 
 private:
+    void writeHeader();
+
     std::ofstream m_fileStream;
+    samples_t m_writtenSamplesPerChannel = 0;
 };
 }
 
@@ -23,11 +23,15 @@
 #define MU_AUDIO_IAUDIOBUFFER_H
 
 #include <memory>
+
+#include "modularity/imoduleexport.h"
 #include "iaudiosource.h"
 
 namespace mu::audio {
-class IAudioBuffer
+class IAudioBuffer : MODULE_EXPORT_INTERFACE
 {
+    INTERFACE_ID(IAudioBuffer)
+
 public:
     virtual ~IAudioBuffer() = default;
 
@@ -36,6 +40,9 @@ public:
 
     virtual void pop(float* dest, size_t sampleCount) = 0;
     virtual void setMinSampleLag(size_t lag) = 0;
+
+    //! NOTE Number of pops, which were not fully filled by the source (buffer underruns)
+    virtual uint64_t xrunCount() const = 0;
 };
 
 using IAudioBufferPtr = std::shared_ptr<IAudioBuffer>;
@@ -22,6 +22,9 @@
 
 #include "soundtrackwriter.h"
 
+#include <thread>
+#include <chrono>
+
 #include "internal/worker/audioengine.h"
 #include "internal/encoders/mp3encoder.h"
 #include "internal/encoders/oggencoder.h"
@@ -33,9 +36,12 @@ using namespace mu::audio;
 using namespace mu::audio::soundtrack;
 
 static constexpr audioch_t SUPPORTED_AUDIO_CHANNELS_COUNT = 2;
-static constexpr samples_t SAMPLES_PER_CHANNEL = 2048;
+static constexpr samples_t SAMPLES_PER_CHANNEL = AudioEngine::OFFLINE_BLOCK_SIZE;
 static constexpr size_t INTERNAL_BUFFER_SIZE = SUPPORTED_AUDIO_CHANNELS_COUNT * SAMPLES_PER_CHANNEL;
 
+//! NOTE: About 0.75 sec of 44.1kHz audio may wait for the encoder
+static constexpr size_t ENCODING_QUEUE_SIZE = 4;
+
 SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration,
                                    IAudioSourcePtr source)
     : m_source(std::move(source))
@@ -44,9 +50,12 @@ SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTra
         return;
     }
 
-    samples_t totalSamplesNumber = (totalDuration / 1000.f) * sizeof(float) * format.sampleRate;
-    m_inputBuffer.resize(totalSamplesNumber);
-    m_intermBuffer.resize(INTERNAL_BUFFER_SIZE);
+    m_totalSamplesPerChannel = static_cast<samples_t>((totalDuration / 1000.f) * format.sampleRate);
+
+    m_blocks.resize(ENCODING_QUEUE_SIZE);
+    for (Block& block : m_blocks) {
+        block.samples.resize(INTERNAL_BUFFER_SIZE);
+    }
 
     m_encoderPtr = createEncoder(format.type);
 
@@ -54,7 +63,10 @@ SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTra
         return;
     }
 
-    m_encoderPtr->init(destination, format, totalSamplesNumber);
+    if (!m_encoderPtr->init(destination, format, m_totalSamplesPerChannel)) {
+        LOGE() << "Unable to initialize the encoder, destination: " << destination;
+        m_encoderPtr = nullptr;
+    }
 }
 
 bool SoundTrackWriter::write()
@@ -65,27 +77,49 @@ bool SoundTrackWriter::write()
         return false;
     }
 
+    if (m_totalSamplesPerChannel == 0) {
+        LOGI() << "No audio to export";
+        return false;
+    }
+
     AudioEngine::instance()->setMode(AudioEngine::Mode::OfflineMode);
 
     m_source->setSampleRate(m_encoderPtr->format().sampleRate);
     m_source->setIsActive(true);
 
-    if (!prepareInputBuffer()) {
-        return false;
-    }
+    auto startTime = std::chrono::steady_clock::now();
 
-    if (m_encoderPtr->encode(m_inputBuffer.size() / sizeof(float), m_inputBuffer.data()) == 0) {
-        return false;
-    }
+    std::thread encoderThread(&SoundTrackWriter::encodeBlocks, this);
 
-    m_encoderPtr->flush();
+    bool ok = renderBlocks();
+
+    finishRendering();
+    encoderThread.join();
+
+    ok = ok && !m_isEncodingFailed;
+
+    if (ok) {
+        m_encoderPtr->flush();
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        double audioDurationSecs = static_cast<double>(m_totalSamplesPerChannel) / m_encoderPtr->format().sampleRate;
+        double realtimeFactor = elapsed.count() > 0 ? audioDurationSecs / elapsed.count() : 0.0;
+
+        LOGI() << "Rendered " << audioDurationSecs << " sec of audio in " << elapsed.count()
+               << " sec, realtime factor: " << realtimeFactor;
+    }
 
     m_source->setSampleRate(AudioEngine::instance()->sampleRate());
     m_source->setIsActive(false);
 
     AudioEngine::instance()->setMode(AudioEngine::Mode::RealTimeMode);
 
-    return true;
+    return ok;
+}
+
+framework::ProgressChannel SoundTrackWriter::progress() const
+{
+    return m_progress;
 }
 
 encode::AbstractAudioEncoderPtr SoundTrackWriter::createEncoder(const SoundTrackType& type) const
@@ -99,27 +133,96 @@ encode::AbstractAudioEncoderPtr SoundTrackWriter::createEncoder(const SoundTrack
     }
 }
 
-bool SoundTrackWriter::prepareInputBuffer()
+bool SoundTrackWriter::renderBlocks()
 {
-    size_t inputBufferOffset = 0;
-    size_t inputBufferMaxOffset = m_inputBuffer.size();
+    samples_t renderedSamplesPerChannel = 0;
+    int64_t lastPercentage = -1;
 
-    while (inputBufferOffset < inputBufferMaxOffset) {
-        m_source->process(m_intermBuffer.data(), SAMPLES_PER_CHANNEL);
+    while (renderedSamplesPerChannel < m_totalSamplesPerChannel) {
+        Block* block = waitForFreeBlock();
+        if (!block) {
+            return false;
+        }
 
-        size_t samplesToCopy = std::min(INTERNAL_BUFFER_SIZE, inputBufferMaxOffset - inputBufferOffset);
+        samples_t samplesPerChannel = std::min(SAMPLES_PER_CHANNEL, m_totalSamplesPerChannel - renderedSamplesPerChannel);
+        m_source->process(block->samples.data(), samplesPerChannel);
+        block->samplesPerChannel = samplesPerChannel;
 
-        std::copy(m_intermBuffer.begin(),
-                  m_intermBuffer.begin() + samplesToCopy,
-                  m_inputBuffer.begin() + inputBufferOffset);
+        pushBlock();
 
-        inputBufferOffset += samplesToCopy;
-    }
+        renderedSamplesPerChannel += samplesPerChannel;
 
-    if (inputBufferOffset == 0) {
-        LOGI() << "No audio to export";
-        return false;
+        int64_t percentage = static_cast<int64_t>(renderedSamplesPerChannel * 100 / m_totalSamplesPerChannel);
+        if (percentage != lastPercentage) {
+            lastPercentage = percentage;
+            m_progress.send(framework::Progress(renderedSamplesPerChannel, m_totalSamplesPerChannel));
+        }
     }
 
     return true;
 }
+
+void SoundTrackWriter::encodeBlocks()
+{
+    while (const Block* block = waitForQueuedBlock()) {
+        if (m_encoderPtr->encode(block->samplesPerChannel, block->samples.data()) == 0) {
+            std::lock_guard lock(m_queueMutex);
+            m_isEncodingFailed = true;
+            m_blockReleased.notify_one();
+            return;
+        }
+
+        popBlock();
+    }
+}
+
+SoundTrackWriter::Block* SoundTrackWriter::waitForFreeBlock()
+{
+    std::unique_lock lock(m_queueMutex);
+    m_blockReleased.wait(lock, [this]() {
+        return m_queuedBlocksCount < m_blocks.size() || m_isEncodingFailed;
+    });
+
+    if (m_isEncodingFailed) {
+        return nullptr;
+    }
+
+    return &m_blocks[m_writeIdx];
+}
+
+void SoundTrackWriter::pushBlock()
+{
+    std::lock_guard lock(m_queueMutex);
+    m_writeIdx = (m_writeIdx + 1) % m_blocks.size();
+    ++m_queuedBlocksCount;
+    m_blockQueued.notify_one();
+}
+
+SoundTrackWriter::Block* SoundTrackWriter::waitForQueuedBlock()
+{
+    std::unique_lock lock(m_queueMutex);
+    m_blockQueued.wait(lock, [this]() {
+        return m_queuedBlocksCount > 0 || m_isRenderingFinished;
+    });
+
+    if (m_queuedBlocksCount == 0) {
+        return nullptr;
+    }
+
+    return &m_blocks[m_readIdx];
+}
+
+void SoundTrackWriter::popBlock()
+{
+    std::lock_guard lock(m_queueMutex);
+    m_readIdx = (m_readIdx + 1) % m_blocks.size();
+    --m_queuedBlocksCount;
+    m_blockReleased.notify_one();
+}
+
+void SoundTrackWriter::finishRendering()
+{
+    std::lock_guard lock(m_queueMutex);
+    m_isRenderingFinished = true;
+    m_blockQueued.notify_one();
+}
@@ -25,12 +25,18 @@
 
 #include <vector>
 #include <cstdio>
+#include <mutex>
+#include <condition_variable>
+
+#include "global/progress.h"
 
 #include "audiotypes.h"
 #include "iaudiosource.h"
 #include "internal/encoders/abstractaudioencoder.h"
 
 namespace mu::audio::soundtrack {
+//! NOTE: Renders the source block by block and hands the blocks over to a separate encoder thread
+//! through a small bounded queue, so the memory consumption doesn't depend on the duration of the piece
 class SoundTrackWriter
 {
 public:
@@ -38,16 +44,41 @@ public:
 
     bool write();
 
+    framework::ProgressChannel progress() const;
+
 private:
+    struct Block {
+        std::vector<float> samples;
+        samples_t samplesPerChannel = 0;
+    };
+
     encode::AbstractAudioEncoderPtr createEncoder(const SoundTrackType& type) const;
-    bool prepareInputBuffer();
+
+    bool renderBlocks();
+    void encodeBlocks();
+
+    Block* waitForFreeBlock();
+    void pushBlock();
+    Block* waitForQueuedBlock();
+    void popBlock();
+    void finishRendering();
 
     IAudioSourcePtr m_source = nullptr;
+    samples_t m_totalSamplesPerChannel = 0;
+
+    std::vector<Block> m_blocks;
+    size_t m_writeIdx = 0;
+    size_t m_readIdx = 0;
+    size_t m_queuedBlocksCount = 0;
+    bool m_isRenderingFinished = false;
+    bool m_isEncodingFailed = false;
 
-    std::vector<float> m_inputBuffer;
-    std::vector<float> m_intermBuffer;
+    std::mutex m_queueMutex;
+    std::condition_variable m_blockQueued;
+    std::condition_variable m_blockReleased;
 
     encode::AbstractAudioEncoderPtr m_encoderPtr = nullptr;
+    framework::ProgressChannel m_progress;
 };
 }
 
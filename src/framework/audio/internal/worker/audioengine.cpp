@@ -22,6 +22,9 @@
 
 #include "audioengine.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "log.h"
 #include "ptrutils.h"
 
@@ -30,6 +33,13 @@
 
 using namespace mu::audio;
 
+static size_t offlineMixerThreadsCount()
+{
+    //! NOTE: The calling thread renders channels as well
+    size_t hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
 AudioEngine* AudioEngine::instance()
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -126,6 +136,21 @@ void AudioEngine::setAudioChannelsCount(const audioch_t count)
     m_mixer->setAudioChannelsCount(count);
 }
 
+void AudioEngine::setMixerThreadsCount(const size_t count)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    IF_ASSERT_FAILED(m_mixer) {
+        return;
+    }
+
+    m_mixerThreadsCount = count;
+
+    if (m_currentMode != Mode::OfflineMode) {
+        m_mixer->setWorkerThreadsCount(count);
+    }
+}
+
 void AudioEngine::setMode(const Mode newMode)
 {
     if (newMode == m_currentMode) {
@@ -135,9 +160,11 @@ void AudioEngine::setMode(const Mode newMode)
     m_currentMode = newMode;
 
     if (m_currentMode == Mode::RealTimeMode) {
+        m_mixer->setWorkerThreadsCount(m_mixerThreadsCount);
         m_buffer->setSource(m_mixer->mixedSource());
     } else {
         m_buffer->setSource(nullptr);
+        m_mixer->setWorkerThreadsCount(std::max(m_mixerThreadsCount, offlineMixerThreadsCount()));
     }
 }
 
@@ -46,6 +46,10 @@ public:
         OfflineMode
     };
 
+    //! NOTE: The offline mode isn't paced by the audio driver, so the source is rendered
+    //! in large blocks and the tracks are rendered concurrently on all the available cores
+    static constexpr samples_t OFFLINE_BLOCK_SIZE = 8192;
+
     Ret init(IAudioBufferPtr bufferPtr);
     void deinit();
 
@@ -54,6 +58,7 @@ public:
     void setSampleRate(unsigned int sampleRate);
     void setReadBufferSize(uint16_t readBufferSize);
     void setAudioChannelsCount(const audioch_t count);
+    void setMixerThreadsCount(const size_t count);
     void setMode(const Mode newMode);
 
     MixerPtr mixer() const;
@@ -65,6 +70,8 @@ private:
 
     sample_rate_t m_sampleRate = 0;
 
+    size_t m_mixerThreadsCount = 0;
+
     MixerPtr m_mixer = nullptr;
     IAudioBufferPtr m_buffer = nullptr;
 
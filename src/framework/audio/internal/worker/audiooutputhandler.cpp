@@ -168,6 +168,19 @@ Promise<AudioSignalChanges> AudioOutputHandler::masterSignalChanges() const
     }, AudioThread::ID);
 }
 
+Promise<AudioDspLoadChanges> AudioOutputHandler::dspLoadChanges() const
+{
+    return Promise<AudioDspLoadChanges>([this](auto resolve, auto reject) {
+        ONLY_AUDIO_WORKER_THREAD;
+
+        IF_ASSERT_FAILED(mixer()) {
+            return reject(static_cast<int>(Err::Undefined), "undefined reference to a mixer");
+        }
+
+        return resolve(mixer()->dspLoadChanges());
+    }, AudioThread::ID);
+}
+
 Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                  const SoundTrackFormat& format)
 {
@@ -187,6 +200,9 @@ Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceI
         s->player()->seek(0);
         msecs_t totalDuration = s->player()->duration();
         SoundTrackWriter writer(destination, format, totalDuration, mixer());
+        writer.progress().onReceive(this, [this, sequenceId](const framework::Progress& progress) {
+            m_saveSoundTrackProgressChanged.send(sequenceId, progress);
+        });
 
         return resolve(writer.write());
 #else
@@ -195,6 +211,13 @@ Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceI
     }, AudioThread::ID);
 }
 
+Channel<TrackSequenceId, mu::framework::Progress> AudioOutputHandler::saveSoundTrackProgressChanged() const
+{
+    ONLY_AUDIO_MAIN_OR_WORKER_THREAD;
+
+    return m_saveSoundTrackProgressChanged;
+}
+
 std::shared_ptr<Mixer> AudioOutputHandler::mixer() const
 {
     return AudioEngine::instance()->mixer();
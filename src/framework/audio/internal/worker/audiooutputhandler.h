@@ -51,9 +51,11 @@ public:
 
     async::Promise<AudioSignalChanges> signalChanges(const TrackSequenceId sequenceId, const TrackId trackId) const override;
     async::Promise<AudioSignalChanges> masterSignalChanges() const override;
+    async::Promise<AudioDspLoadChanges> dspLoadChanges() const override;
 
     async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                         const SoundTrackFormat& format) override;
+    async::Channel<TrackSequenceId, framework::Progress> saveSoundTrackProgressChanged() const override;
 
 private:
     std::shared_ptr<Mixer> mixer() const;
@@ -65,6 +67,7 @@ private:
 
     mutable async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
     mutable async::Channel<TrackSequenceId, TrackId, AudioOutputParams> m_outputParamsChanged;
+    mutable async::Channel<TrackSequenceId, framework::Progress> m_saveSoundTrackProgressChanged;
 };
 }
 
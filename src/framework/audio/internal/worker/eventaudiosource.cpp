@@ -84,7 +84,7 @@ void EventAudioSource::setSampleRate(unsigned int sampleRate)
 
 unsigned int EventAudioSource::audioChannelsCount() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_POOL_THREAD;
 
     if (!m_synth) {
         return 0;
@@ -106,7 +106,7 @@ async::Channel<unsigned int> EventAudioSource::audioChannelsCountChanged() const
 
 samples_t EventAudioSource::process(float* buffer, samples_t samplesPerChannel)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_POOL_THREAD;
 
     if (!m_synth) {
         return 0;
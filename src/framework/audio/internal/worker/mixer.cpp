@@ -24,6 +24,7 @@
 #include "async/async.h"
 #include "log.h"
 
+#include <cmath>
 #include <limits>
 
 #include "internal/audiosanitizer.h"
@@ -35,14 +36,23 @@ using namespace mu;
 using namespace mu::audio;
 using namespace mu::async;
 
+static constexpr float DSP_LOAD_SMOOTHING = 0.1f;
+static constexpr float DSP_LOAD_MINIMAL_VALUABLE_DIFF = 0.01f;
+
 Mixer::Mixer()
 {
     ONLY_AUDIO_WORKER_THREAD;
+
+    m_renderChannelTask = [this](size_t idx) {
+        renderChannel(m_renderChannels[idx], m_renderSamplesPerChannel);
+    };
 }
 
 Mixer::~Mixer()
 {
     ONLY_AUDIO_WORKER_THREAD;
+
+    m_workerPool.stop();
 }
 
 IAudioSourcePtr Mixer::mixedSource()
@@ -68,6 +78,8 @@ RetVal<MixerChannelPtr> Mixer::addChannel(const TrackId trackId, IAudioSourcePtr
     result.val = m_mixerChannels[trackId];
     result.ret = make_ret(Ret::Code::Ok);
 
+    updateRenderChannels();
+
     return result;
 }
 
@@ -79,6 +91,7 @@ Ret Mixer::removeChannel(const TrackId id)
 
     if (search != m_mixerChannels.end() && search->second) {
         m_mixerChannels.erase(id);
+        updateRenderChannels();
         return make_ret(Ret::Code::Ok);
     }
 
@@ -92,6 +105,21 @@ void Mixer::setAudioChannelsCount(const audioch_t count)
     m_audioChannelsCount = count;
 }
 
+void Mixer::setWorkerThreadsCount(const size_t count)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (m_workerPool.threadsCount() == count) {
+        return;
+    }
+
+    if (count == 0) {
+        m_workerPool.stop();
+    } else {
+        m_workerPool.start(count);
+    }
+}
+
 void Mixer::setSampleRate(unsigned int sampleRate)
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -122,18 +150,25 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
 
     std::fill(outBuffer, outBuffer + samplesPerChannel * audioChannelsCount(), 0.f);
 
-    if (m_writeCacheBuff.size() != samplesPerChannel * audioChannelsCount()) {
-        m_writeCacheBuff.resize(samplesPerChannel * audioChannelsCount(), 0.f);
+    //! NOTE Every channel is rendered into its own buffer, so channels are independent
+    //! and can be rendered in parallel. Then they are summed up in the same order as before
+    //! NOTE The helper threads of the pool don't call the getters of the mixer,
+    //! the values are passed to them with the render data
+    m_renderSamplesPerChannel = samplesPerChannel;
+    for (ChannelRenderData& data : m_renderChannels) {
+        data.audioChannelsCount = audioChannelsCount();
     }
 
+    m_workerPool.run(m_renderChannelTask, m_renderChannels.size());
+
     samples_t masterChannelSampleCount = 0;
 
-    for (auto& channel : m_mixerChannels) {
-        samples_t processedSamplesCount = channel.second->process(m_writeCacheBuff.data(), samplesPerChannel);
-        mixOutputFromChannel(outBuffer, m_writeCacheBuff.data(), processedSamplesCount);
-        std::fill(m_writeCacheBuff.begin(), m_writeCacheBuff.end(), 0.f);
+    for (ChannelRenderData& data : m_renderChannels) {
+        data.channel->notifyAboutAudioSignalChanges();
+        updateDspLoad(data, samplesPerChannel);
 
-        masterChannelSampleCount = std::max(processedSamplesCount, masterChannelSampleCount);
+        mixOutputFromChannel(outBuffer, data.buffer.data(), data.processedSamplesCount);
+        masterChannelSampleCount = std::max(data.processedSamplesCount, masterChannelSampleCount);
     }
 
     if (m_masterParams.muted || masterChannelSampleCount == 0) {
@@ -215,7 +250,62 @@ async::Channel<audioch_t, AudioSignalVal> Mixer::masterAudioSignalChanges() cons
     return m_audioSignalNotifier.audioSignalChanges;
 }
 
-void Mixer::mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int samplesCount)
+AudioDspLoadChanges Mixer::dspLoadChanges() const
+{
+    return m_dspLoadChanges;
+}
+
+void Mixer::updateRenderChannels()
+{
+    m_renderChannels.clear();
+    m_renderChannels.reserve(m_mixerChannels.size());
+
+    for (const auto& pair : m_mixerChannels) {
+        ChannelRenderData data;
+        data.channel = pair.second;
+        m_renderChannels.push_back(std::move(data));
+    }
+}
+
+void Mixer::renderChannel(ChannelRenderData& data, samples_t samplesPerChannel)
+{
+    ONLY_AUDIO_WORKER_OR_POOL_THREAD;
+
+    size_t bufferSize = samplesPerChannel * data.audioChannelsCount;
+    if (data.buffer.size() != bufferSize) {
+        data.buffer.resize(bufferSize);
+    }
+
+    std::fill(data.buffer.begin(), data.buffer.end(), 0.f);
+
+    auto started = std::chrono::steady_clock::now();
+    data.processedSamplesCount = data.channel->render(data.buffer.data(), samplesPerChannel);
+    data.renderTime = std::chrono::steady_clock::now() - started;
+}
+
+void Mixer::updateDspLoad(ChannelRenderData& data, samples_t samplesPerChannel)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (m_sampleRate == 0 || samplesPerChannel == 0) {
+        return;
+    }
+
+    // the share of the real time of this block, which was spent on rendering of the channel
+    double blockDurationNs = static_cast<double>(samplesPerChannel) * 1e9 / m_sampleRate;
+    float load = static_cast<float>(data.renderTime.count() / blockDurationNs);
+
+    data.dspLoad += (load - data.dspLoad) * DSP_LOAD_SMOOTHING;
+
+    if (std::abs(data.dspLoad - data.notifiedDspLoad) < DSP_LOAD_MINIMAL_VALUABLE_DIFF) {
+        return;
+    }
+
+    data.notifiedDspLoad = data.dspLoad;
+    m_dspLoadChanges.send(data.channel->trackId(), data.dspLoad);
+}
+
+void Mixer::mixOutputFromChannel(float* outBuffer, const float* inBuffer, samples_t samplesCount)
 {
     IF_ASSERT_FAILED(outBuffer && inBuffer) {
         return;
@@ -225,12 +315,10 @@ void Mixer::mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int
         return;
     }
 
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        for (samples_t s = 0; s < samplesCount; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
-
-            outBuffer[idx] += inBuffer[idx];
-        }
+    // interleaved buffers of the same layout, so a flat loop, which the compiler can vectorize
+    const samples_t totalCount = samplesCount * audioChannelsCount();
+    for (samples_t idx = 0; idx < totalCount; ++idx) {
+        outBuffer[idx] += inBuffer[idx];
     }
 }
 
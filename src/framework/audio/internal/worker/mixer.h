@@ -22,6 +22,7 @@
 #ifndef MU_AUDIO_MIXER_H
 #define MU_AUDIO_MIXER_H
 
+#include <chrono>
 #include <memory>
 #include <map>
 
@@ -33,6 +34,7 @@
 #include "internal/dsp/limiter.h"
 #include "ifxresolver.h"
 #include "iclock.h"
+#include "internal/audioworkerpool.h"
 
 namespace mu::audio {
 class Mixer : public AbstractAudioSource, public std::enable_shared_from_this<Mixer>, public async::Asyncable
@@ -49,6 +51,10 @@ public:
 
     void setAudioChannelsCount(const audioch_t count);
 
+    //! NOTE 0 - all channels are rendered on the worker thread,
+    //! otherwise channels are rendered in parallel by the worker thread and the given number of helper threads
+    void setWorkerThreadsCount(const size_t count);
+
     void addClock(IClockPtr clock);
     void removeClock(IClockPtr clock);
 
@@ -57,6 +63,7 @@ public:
     async::Channel<AudioOutputParams> masterOutputParamsChanged() const;
 
     async::Channel<audioch_t, AudioSignalVal> masterAudioSignalChanges() const;
+    AudioDspLoadChanges dspLoadChanges() const;
 
     // IAudioSource
     void setSampleRate(unsigned int sampleRate) override;
@@ -65,11 +72,29 @@ public:
     void setIsActive(bool arg) override;
 
 private:
-    void mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int samplesCount);
+    struct ChannelRenderData {
+        MixerChannelPtr channel = nullptr;
+        std::vector<float> buffer;
+        audioch_t audioChannelsCount = 0;
+        samples_t processedSamplesCount = 0;
+        std::chrono::nanoseconds renderTime { 0 };
+        float dspLoad = 0.f;
+        float notifiedDspLoad = 0.f;
+    };
+
+    void updateRenderChannels();
+    void renderChannel(ChannelRenderData& data, samples_t samplesPerChannel);
+    void updateDspLoad(ChannelRenderData& data, samples_t samplesPerChannel);
+
+    void mixOutputFromChannel(float* outBuffer, const float* inBuffer, samples_t samplesCount);
     void completeOutput(float* buffer, const samples_t& samplesPerChannel);
     void notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const;
 
-    std::vector<float> m_writeCacheBuff;
+    std::vector<ChannelRenderData> m_renderChannels;
+    samples_t m_renderSamplesPerChannel = 0;
+    AudioWorkerPool::Task m_renderChannelTask;
+    AudioWorkerPool m_workerPool;
+    AudioDspLoadChanges m_dspLoadChanges;
 
     AudioOutputParams m_masterParams;
     async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
@@ -43,6 +43,11 @@ MixerChannel::MixerChannel(const TrackId trackId, IAudioSourcePtr source, const
     setSampleRate(sampleRate);
 }
 
+TrackId MixerChannel::trackId() const
+{
+    return m_trackId;
+}
+
 const AudioOutputParams& MixerChannel::outputParams() const
 {
     return m_params;
@@ -141,7 +146,7 @@ void MixerChannel::setSampleRate(unsigned int sampleRate)
 
 unsigned int MixerChannel::audioChannelsCount() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_POOL_THREAD;
 
     IF_ASSERT_FAILED(m_audioSource) {
         return 0;
@@ -165,45 +170,57 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    samples_t processedSamplesCount = render(buffer, samplesPerChannel);
+    notifyAboutAudioSignalChanges();
+
+    return processedSamplesCount;
+}
+
+samples_t MixerChannel::render(float* buffer, samples_t samplesPerChannel)
+{
+    ONLY_AUDIO_WORKER_OR_POOL_THREAD;
+
     IF_ASSERT_FAILED(m_audioSource) {
         return 0;
     }
 
+    const audioch_t audioChannelsCount = this->audioChannelsCount();
+    if (m_signalRms.size() != audioChannelsCount) {
+        m_signalRms.resize(audioChannelsCount, 0.f);
+    }
+
     samples_t processedSamplesCount = m_audioSource->process(buffer, samplesPerChannel);
 
     if (processedSamplesCount == 0 || m_params.muted) {
-        std::fill(buffer, buffer + samplesPerChannel * audioChannelsCount(), 0.f);
-
-        for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-            notifyAboutAudioSignalChanges(audioChNum, 0.f);
-        }
+        std::fill(buffer, buffer + samplesPerChannel * audioChannelsCount, 0.f);
+        std::fill(m_signalRms.begin(), m_signalRms.end(), 0.f);
 
         return processedSamplesCount;
     }
 
-    for (IFxProcessorPtr fx : m_fxProcessors) {
+    for (IFxProcessorPtr& fx : m_fxProcessors) {
         if (!fx->active()) {
             continue;
         }
         fx->process(buffer, samplesPerChannel);
     }
 
-    completeOutput(buffer, samplesPerChannel);
+    completeOutput(buffer, audioChannelsCount, samplesPerChannel);
 
     return processedSamplesCount;
 }
 
-void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) const
+void MixerChannel::completeOutput(float* buffer, audioch_t audioChannelsCount, unsigned int samplesCount)
 {
     float totalSquaredSum = 0.f;
 
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
+    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
         float singleChannelSquaredSum = 0.f;
 
         gain_t totalGain = dsp::balanceGain(m_params.balance, audioChNum) * dsp::linearFromDecibels(m_params.volume);
 
         for (unsigned int s = 0; s < samplesCount; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
+            int idx = s * audioChannelsCount + audioChNum;
 
             float resultSample = buffer[idx] * totalGain;
             buffer[idx] = resultSample;
@@ -213,20 +230,23 @@ void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) cons
             totalSquaredSum += squaredSample;
         }
 
-        float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesCount);
-
-        notifyAboutAudioSignalChanges(audioChNum, rms);
+        m_signalRms[audioChNum] = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesCount);
     }
 
     if (!m_compressor->isActive()) {
         return;
     }
 
-    float totalRms = dsp::samplesRootMeanSquare(totalSquaredSum, samplesCount * audioChannelsCount());
-    m_compressor->process(totalRms, buffer, audioChannelsCount(), samplesCount);
+    float totalRms = dsp::samplesRootMeanSquare(totalSquaredSum, samplesCount * audioChannelsCount);
+    m_compressor->process(totalRms, buffer, audioChannelsCount, samplesCount);
 }
 
-void MixerChannel::notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const
+void MixerChannel::notifyAboutAudioSignalChanges()
 {
-    m_audioSignalNotifier.updateSignalValues(audioChannelNumber, linearRms, dsp::dbFromSample(linearRms));
+    ONLY_AUDIO_WORKER_THREAD;
+
+    for (audioch_t audioChNum = 0; audioChNum < m_signalRms.size(); ++audioChNum) {
+        float linearRms = m_signalRms[audioChNum];
+        m_audioSignalNotifier.updateSignalValues(audioChNum, linearRms, dsp::dbFromSample(linearRms));
+    }
 }
@@ -39,6 +39,8 @@ class MixerChannel : public ITrackAudioOutput, public async::Asyncable
 public:
     explicit MixerChannel(const TrackId trackId, IAudioSourcePtr source, const unsigned int sampleRate);
 
+    TrackId trackId() const;
+
     const AudioOutputParams& outputParams() const override;
     void applyOutputParams(const AudioOutputParams& requiredParams) override;
     async::Channel<AudioOutputParams> outputParamsChanged() const override;
@@ -53,9 +55,14 @@ public:
     async::Channel<unsigned int> audioChannelsCountChanged() const override;
     samples_t process(float* buffer, samples_t samplesPerChannel) override;
 
+    //! NOTE Same as process, but without sending audio signal changes,
+    //! so it can be called from any thread of the audio worker pool.
+    //! The changes must be sent afterwards with notifyAboutAudioSignalChanges
+    samples_t render(float* buffer, samples_t samplesPerChannel);
+    void notifyAboutAudioSignalChanges();
+
 private:
-    void completeOutput(float* buffer, unsigned int samplesCount) const;
-    void notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const;
+    void completeOutput(float* buffer, audioch_t audioChannelsCount, unsigned int samplesCount);
 
     TrackId m_trackId = -1;
 
@@ -67,6 +74,8 @@ private:
 
     dsp::CompressorPtr m_compressor = nullptr;
 
+    std::vector<float> m_signalRms;
+
     mutable async::Channel<AudioOutputParams> m_paramsChanges;
     mutable AudioSignalsNotifier m_audioSignalNotifier;
 };
@@ -74,6 +74,12 @@ Rectangle {
                 minDisplayedVolumePressure: waveModel.minDisplayedDbfs
                 maxDisplayedVolumePressure: waveModel.maxDisplayedDbfs
             }
+
+            StyledTextLabel {
+                anchors.horizontalCenter: panningKnob.horizontalCenter
+
+                text: "Xruns: " + waveModel.xrunCount
+            }
         }
 
         WaveFormView {
@@ -0,0 +1,129 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "internal/audiosanitizer.h"
+#include "internal/worker/audioengine.h"
+#include "internal/worker/abstractaudiosource.h"
+#include "internal/worker/mixer.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+static constexpr audioch_t AUDIO_CHANNELS_COUNT = 2;
+static constexpr unsigned int SAMPLE_RATE = 48000;
+static constexpr size_t TRACKS_COUNT = 4;
+static constexpr size_t BLOCKS_COUNT = 4;
+
+//! NOTE Stereo source with a deterministic signal, different for every track
+class TestSource : public AbstractAudioSource
+{
+public:
+    TestSource(size_t trackIdx)
+        : m_trackIdx(trackIdx) {}
+
+    unsigned int audioChannelsCount() const override
+    {
+        return AUDIO_CHANNELS_COUNT;
+    }
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        for (samples_t s = 0; s < samplesPerChannel; ++s) {
+            for (audioch_t ch = 0; ch < AUDIO_CHANNELS_COUNT; ++ch) {
+                buffer[s * AUDIO_CHANNELS_COUNT + ch] = 0.001f * ((m_position + s + ch + m_trackIdx * 7) % 50);
+            }
+        }
+
+        m_position += samplesPerChannel;
+        return samplesPerChannel;
+    }
+
+private:
+    size_t m_trackIdx = 0;
+    samples_t m_position = 0;
+};
+
+class Audio_MixerTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        //! NOTE The test thread plays the role of the audio worker thread
+        AudioSanitizer::setupWorkerThread();
+    }
+
+    //! NOTE Renders the tracks in the offline blocks and returns the whole output
+    std::vector<float> renderOffline(size_t workerThreadsCount) const
+    {
+        MixerPtr mixer = std::make_shared<Mixer>();
+        mixer->setAudioChannelsCount(AUDIO_CHANNELS_COUNT);
+        mixer->setSampleRate(SAMPLE_RATE);
+
+        for (size_t i = 0; i < TRACKS_COUNT; ++i) {
+            RetVal<MixerChannelPtr> channel = mixer->addChannel(static_cast<TrackId>(i), std::make_shared<TestSource>(i));
+            EXPECT_TRUE(channel.ret);
+        }
+
+        mixer->setWorkerThreadsCount(workerThreadsCount);
+        mixer->setIsActive(true);
+
+        const samples_t blockSize = AudioEngine::OFFLINE_BLOCK_SIZE;
+        std::vector<float> result(BLOCKS_COUNT * blockSize * AUDIO_CHANNELS_COUNT, 0.f);
+
+        for (size_t i = 0; i < BLOCKS_COUNT; ++i) {
+            samples_t processed = mixer->process(result.data() + i * blockSize * AUDIO_CHANNELS_COUNT, blockSize);
+            EXPECT_EQ(processed, blockSize);
+        }
+
+        return result;
+    }
+};
+
+/**
+ * @brief Audio_MixerTests_OfflineRenderInParallel
+ * @details Several tracks rendered by the worker pool in the offline blocks
+ *          give the same output as the tracks rendered one by one on the worker thread
+ */
+TEST_F(Audio_MixerTests, OfflineRenderInParallel)
+{
+    //! GIVEN The output of the tracks rendered on the worker thread only
+    std::vector<float> expected = renderOffline(0);
+
+    bool hasSignal = false;
+    for (float sample : expected) {
+        if (sample != 0.f) {
+            hasSignal = true;
+            break;
+        }
+    }
+    ASSERT_TRUE(hasSignal);
+
+    //! WHEN The same tracks are rendered by the pool of two and of three helper threads
+    std::vector<float> renderedByTwo = renderOffline(2);
+    std::vector<float> renderedByThree = renderOffline(3);
+
+    //! THEN The output is the same
+    EXPECT_EQ(renderedByTwo, expected);
+    EXPECT_EQ(renderedByThree, expected);
+}
@@ -22,22 +22,457 @@
 #include "xmlstreamreader.h"
 
 #include <cstring>
-
-#include "thirdparty/tinyxml/tinyxml2.h"
+#include <deque>
+#include <string>
+#include <unordered_map>
 
 #include "log.h"
 
 using namespace mu;
 using namespace mu::io;
-using namespace tinyxml2;
+
+enum class Decoding {
+    None,
+    NewLines,
+    Entities
+};
 
 struct XmlStreamReader::Xml {
-    XMLDocument doc;
-    XMLNode* node = nullptr;
-    XMLError err;
+    struct RawAttribute {
+        std::string_view name;
+        std::string_view value;
+        Decoding decoding = Decoding::None;
+    };
+
+    ByteArray data;
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    const char* pos = nullptr;
+    const char* tokenPos = nullptr;
+
+    // current token
+    std::string_view name;
+    std::string_view value;
+    Decoding decoding = Decoding::None;
+    std::vector<RawAttribute> attributes;
+
+    std::vector<std::string_view> elements;
+    bool isEmptyElement = false;
+    bool hasNodes = false;
+
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, std::string_view> internedNames;
+
+    Error err = NoError;
+    std::string errStr;
     QString customErr;
+
+    const char* lineCountedPos = nullptr;
+    const char* lineStart = nullptr;
+    int64_t line = 1;
+
+    void reset(const ByteArray& d);
+
+    TokenType parseNext();
+    TokenType parseStartElement();
+    TokenType parseEndElement();
+    TokenType parseMarkup(const char* header, size_t headerLen, const char* footer, TokenType token, Decoding decoding);
+    TokenType setError(Error e, const char* message, const char* p);
+
+    std::string_view readName(const char*& p) const;
+    void skipSpace(const char*& p) const;
+    std::string_view intern(std::string_view n);
+    void countLines(const char* p);
 };
 
+static inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static inline bool isNameStartChar(unsigned char c)
+{
+    return c >= 128 || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == ':' || c == '_';
+}
+
+static inline bool isNameChar(unsigned char c)
+{
+    return isNameStartChar(c) || (c >= '0' && c <= '9') || c == '.' || c == '-';
+}
+
+static bool isBlank(std::string_view str)
+{
+    for (char c : str) {
+        if (!isSpace(c)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static Decoding textDecoding(std::string_view str, Decoding decoding)
+{
+    if (str.find('\r') != std::string_view::npos) {
+        return decoding;
+    }
+    if (decoding == Decoding::Entities && str.find('&') != std::string_view::npos) {
+        return decoding;
+    }
+    return Decoding::None;
+}
+
+static void appendUtf8(std::string& out, uint32_t c)
+{
+    if (c < 0x80) {
+        out += static_cast<char>(c);
+    } else if (c < 0x800) {
+        out += static_cast<char>(0xC0 | (c >> 6));
+        out += static_cast<char>(0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+        out += static_cast<char>(0xE0 | (c >> 12));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (c & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (c >> 18));
+        out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (c & 0x3F));
+    }
+}
+
+//! NOTE Resolves the predefined and the character entities, the unknown ones are kept as is
+static size_t decodeEntity(std::string_view str, size_t i, std::string& out)
+{
+    static const struct {
+        std::string_view name;
+        char value;
+    } ENTITIES[] = {
+        { "&quot;", '"' },
+        { "&amp;", '&' },
+        { "&apos;", '\'' },
+        { "&lt;", '<' },
+        { "&gt;", '>' }
+    };
+
+    std::string_view rest = str.substr(i);
+    if (rest.size() > 2 && rest[1] == '#') {
+        size_t semicolon = rest.find(';');
+        bool isHex = rest[2] == 'x' || rest[2] == 'X';
+        size_t first = isHex ? 3 : 2;
+        if (semicolon != std::string_view::npos && semicolon > first) {
+            uint32_t c = 0;
+            bool ok = true;
+            for (size_t j = first; j < semicolon && ok; ++j) {
+                char d = rest[j];
+                if (d >= '0' && d <= '9') {
+                    c = c * (isHex ? 16 : 10) + static_cast<uint32_t>(d - '0');
+                } else if (isHex && d >= 'a' && d <= 'f') {
+                    c = c * 16 + static_cast<uint32_t>(d - 'a' + 10);
+                } else if (isHex && d >= 'A' && d <= 'F') {
+                    c = c * 16 + static_cast<uint32_t>(d - 'A' + 10);
+                } else {
+                    ok = false;
+                }
+                ok = ok && c <= 0x10FFFF;
+            }
+            if (ok) {
+                appendUtf8(out, c);
+                return i + semicolon + 1;
+            }
+        }
+    } else {
+        for (const auto& entity : ENTITIES) {
+            if (rest.substr(0, entity.name.size()) == entity.name) {
+                out += entity.value;
+                return i + entity.name.size();
+            }
+        }
+    }
+
+    out += '&';
+    return i + 1;
+}
+
+static QString toQString(std::string_view str, Decoding decoding)
+{
+    if (decoding == Decoding::None) {
+        return QString::fromUtf8(str.data(), static_cast<int>(str.size()));
+    }
+
+    std::string decoded;
+    decoded.reserve(str.size());
+    for (size_t i = 0; i < str.size();) {
+        char c = str[i];
+        if (c == '\r') {
+            decoded += '\n';
+            i += (i + 1 < str.size() && str[i + 1] == '\n') ? 2 : 1;
+        } else if (c == '&' && decoding == Decoding::Entities) {
+            i = decodeEntity(str, i, decoded);
+        } else {
+            decoded += c;
+            ++i;
+        }
+    }
+    return QString::fromStdString(decoded);
+}
+
+void XmlStreamReader::Xml::reset(const ByteArray& d)
+{
+    //! NOTE Shares the data if it is owned, copies it if it is raw
+    data = d;
+    data.data();
+
+    begin = reinterpret_cast<const char*>(data.constData());
+    end = begin + data.size();
+
+    // skip UTF-8 BOM
+    if (data.size() >= 3 && std::memcmp(begin, "\xEF\xBB\xBF", 3) == 0) {
+        begin += 3;
+    }
+
+    pos = begin;
+    tokenPos = begin;
+    name = std::string_view();
+    value = std::string_view();
+    decoding = Decoding::None;
+    attributes.clear();
+    elements.clear();
+    isEmptyElement = false;
+    hasNodes = false;
+    err = NoError;
+    errStr.clear();
+    customErr.clear();
+    lineCountedPos = begin;
+    lineStart = begin;
+    line = 1;
+}
+
+std::string_view XmlStreamReader::Xml::intern(std::string_view n)
+{
+    auto it = internedNames.find(n);
+    if (it != internedNames.end()) {
+        return it->second;
+    }
+
+    std::string_view interned = names.emplace_back(n);
+    internedNames.emplace(interned, interned);
+    return interned;
+}
+
+void XmlStreamReader::Xml::skipSpace(const char*& p) const
+{
+    while (p < end && isSpace(*p)) {
+        ++p;
+    }
+}
+
+std::string_view XmlStreamReader::Xml::readName(const char*& p) const
+{
+    const char* start = p;
+    if (p >= end || !isNameStartChar(static_cast<unsigned char>(*p))) {
+        return std::string_view();
+    }
+    ++p;
+    while (p < end && isNameChar(static_cast<unsigned char>(*p))) {
+        ++p;
+    }
+    return std::string_view(start, p - start);
+}
+
+void XmlStreamReader::Xml::countLines(const char* p)
+{
+    if (p < lineCountedPos) {
+        lineCountedPos = begin;
+        lineStart = begin;
+        line = 1;
+    }
+
+    while (lineCountedPos < p) {
+        const char* nl = static_cast<const char*>(std::memchr(lineCountedPos, '\n', p - lineCountedPos));
+        if (!nl) {
+            break;
+        }
+        ++line;
+        lineStart = nl + 1;
+        lineCountedPos = nl + 1;
+    }
+    lineCountedPos = p;
+}
+
+XmlStreamReader::TokenType XmlStreamReader::Xml::setError(Error e, const char* message, const char* p)
+{
+    err = e;
+    errStr = message;
+    tokenPos = p;
+    return TokenType::Invalid;
+}
+
+XmlStreamReader::TokenType XmlStreamReader::Xml::parseMarkup(const char* header, size_t headerLen, const char* footer,
+                                                             TokenType token, Decoding valueDecoding)
+{
+    std::string_view rest(pos + headerLen, end - pos - headerLen);
+    size_t footerPos = rest.find(footer);
+    if (footerPos == std::string_view::npos) {
+        return setError(PrematureEndOfDocumentError, (std::string("unterminated ") + header).c_str(), pos);
+    }
+
+    value = rest.substr(0, footerPos);
+    decoding = textDecoding(value, valueDecoding);
+    pos = rest.data() + footerPos + std::strlen(footer);
+    return token;
+}
+
+XmlStreamReader::TokenType XmlStreamReader::Xml::parseStartElement()
+{
+    const char* p = pos + 1;
+    std::string_view n = readName(p);
+    if (n.empty()) {
+        return setError(NotWellFormedError, "error parsing element", pos);
+    }
+
+    attributes.clear();
+    isEmptyElement = false;
+
+    for (;;) {
+        skipSpace(p);
+        if (p >= end) {
+            return setError(PrematureEndOfDocumentError, "premature end of element", p);
+        }
+
+        if (*p == '>') {
+            ++p;
+            break;
+        }
+
+        if (*p == '/') {
+            if (p + 1 < end && p[1] == '>') {
+                p += 2;
+                isEmptyElement = true;
+                break;
+            }
+            return setError(NotWellFormedError, "error parsing element", p);
+        }
+
+        RawAttribute a;
+        a.name = readName(p);
+        if (a.name.empty()) {
+            return setError(NotWellFormedError, "error parsing attribute", p);
+        }
+
+        skipSpace(p);
+        if (p >= end || *p != '=') {
+            return setError(NotWellFormedError, "error parsing attribute", p);
+        }
+        ++p;
+        skipSpace(p);
+        if (p >= end || (*p != '"' && *p != '\'')) {
+            return setError(NotWellFormedError, "error parsing attribute", p);
+        }
+
+        char quote = *p++;
+        const char* valueEnd = static_cast<const char*>(std::memchr(p, quote, end - p));
+        if (!valueEnd) {
+            return setError(PrematureEndOfDocumentError, "premature end of attribute", p);
+        }
+
+        a.value = std::string_view(p, valueEnd - p);
+        a.decoding = textDecoding(a.value, Decoding::Entities);
+        p = valueEnd + 1;
+
+        for (const RawAttribute& other : attributes) {
+            if (other.name == a.name) {
+                return setError(NotWellFormedError, "duplicate attribute", p);
+            }
+        }
+        attributes.push_back(a);
+    }
+
+    pos = p;
+    name = intern(n);
+    elements.push_back(name);
+    return TokenType::StartElement;
+}
+
+XmlStreamReader::TokenType XmlStreamReader::Xml::parseEndElement()
+{
+    const char* p = pos + 2;
+    std::string_view n = readName(p);
+    skipSpace(p);
+    if (p >= end) {
+        return setError(PrematureEndOfDocumentError, "premature end of element", p);
+    }
+    if (n.empty() || *p != '>') {
+        return setError(NotWellFormedError, "error parsing element", pos);
+    }
+    if (elements.empty() || elements.back() != n) {
+        return setError(NotWellFormedError, "mismatched element", pos);
+    }
+
+    pos = p + 1;
+    name = elements.back();
+    elements.pop_back();
+    attributes.clear();
+    return TokenType::EndElement;
+}
+
+XmlStreamReader::TokenType XmlStreamReader::Xml::parseNext()
+{
+    attributes.clear();
+
+    while (pos < end) {
+        tokenPos = pos;
+
+        if (*pos != '<') {
+            const char* textEnd = static_cast<const char*>(std::memchr(pos, '<', end - pos));
+            if (!textEnd) {
+                textEnd = end;
+            }
+
+            std::string_view text(pos, textEnd - pos);
+            pos = textEnd;
+
+            //! NOTE The whitespace between the tags is not reported
+            if (isBlank(text)) {
+                continue;
+            }
+
+            if (elements.empty()) {
+                return setError(NotWellFormedError, "error parsing text", tokenPos);
+            }
+
+            value = text;
+            decoding = textDecoding(text, Decoding::Entities);
+            return TokenType::Characters;
+        }
+
+        std::string_view rest(pos, end - pos);
+        if (rest.compare(0, 2, "<?") == 0) {
+            return parseMarkup("<?", 2, "?>", TokenType::StartDocument, Decoding::None);
+        } else if (rest.compare(0, 4, "<!--") == 0) {
+            return parseMarkup("<!--", 4, "-->", TokenType::Comment, Decoding::NewLines);
+        } else if (rest.compare(0, 9, "<![CDATA[") == 0) {
+            return parseMarkup("<![CDATA[", 9, "]]>", TokenType::Characters, Decoding::NewLines);
+        } else if (rest.compare(0, 2, "<!") == 0) {
+            return parseMarkup("<!", 2, ">", TokenType::DTD, Decoding::None);
+        } else if (rest.compare(0, 2, "</") == 0) {
+            return parseEndElement();
+        }
+        return parseStartElement();
+    }
+
+    tokenPos = pos;
+
+    if (!elements.empty()) {
+        return setError(PrematureEndOfDocumentError, "premature end of document", pos);
+    }
+
+    if (!hasNodes) {
+        return setError(NotWellFormedError, "empty document", pos);
+    }
+
+    return TokenType::EndDocument;
+}
+
 XmlStreamReader::XmlStreamReader()
 {
     m_xml = new Xml();
@@ -70,14 +505,8 @@ XmlStreamReader::~XmlStreamReader()
 
 void XmlStreamReader::setData(const ByteArray& data)
 {
-    m_xml->doc.Clear();
-    m_xml->err = m_xml->doc.Parse(reinterpret_cast<const char*>(data.constData()), data.size());
-    m_token = m_xml->err == XML_SUCCESS ? TokenType::NoToken : TokenType::Invalid;
-    m_xml->customErr.clear();
-
-    if (m_xml->err != XML_SUCCESS) {
-        LOGE() << errorString();
-    }
+    m_xml->reset(data);
+    m_token = TokenType::NoToken;
 }
 
 bool XmlStreamReader::readNextStartElement()
@@ -97,73 +526,33 @@ bool XmlStreamReader::atEnd() const
     return m_token == TokenType::EndDocument || m_token == TokenType::Invalid;
 }
 
-static XmlStreamReader::TokenType resolveToken(XMLNode* n, bool isStartElement)
-{
-    if (n->ToElement()) {
-        return isStartElement ? XmlStreamReader::TokenType::StartElement : XmlStreamReader::TokenType::EndElement;
-    } else if (n->ToText()) {
-        return XmlStreamReader::TokenType::Characters;
-    } else if (n->ToComment()) {
-        return XmlStreamReader::TokenType::Comment;
-    } else if (n->ToDeclaration()) {
-        return XmlStreamReader::TokenType::StartDocument;
-    } else if (n->ToDocument()) {
-        return XmlStreamReader::TokenType::EndDocument;
-    } else if (n->ToUnknown()) {
-        return XmlStreamReader::TokenType::DTD;
-    }
-    return XmlStreamReader::TokenType::Unknown;
-}
-
-static std::pair<XMLNode*, XmlStreamReader::TokenType> resolveNode(XMLNode* currentNode, XmlStreamReader::TokenType currentToken)
-{
-    if (currentToken == XmlStreamReader::TokenType::StartElement) {
-        XMLNode* child = currentNode->FirstChild();
-        if (child) {
-            return { child, resolveToken(child, true) };
-        }
-
-        XMLNode* sibling = currentNode->NextSibling();
-        if (!sibling || sibling->ToElement() || sibling->ToText()) {
-            return { currentNode, XmlStreamReader::TokenType::EndElement };
-        }
-    }
-
-    XMLNode* sibling = currentNode->NextSibling();
-    if (sibling) {
-        return { sibling, resolveToken(sibling, true) };
-    }
-
-    XMLNode* parent = currentNode->Parent();
-    if (parent) {
-        return { parent, resolveToken(parent, false) };
-    }
-
-    return { nullptr, XmlStreamReader::TokenType::EndDocument };
-}
-
 XmlStreamReader::TokenType XmlStreamReader::readNext()
 {
     if (m_token == TokenType::Invalid) {
         return m_token;
     }
 
-    if (m_xml->err != XML_SUCCESS || m_token == EndDocument) {
-        m_xml->node = nullptr;
+    if (m_xml->err != NoError || m_token == EndDocument) {
         m_token = TokenType::Invalid;
         return m_token;
     }
 
-    if (!m_xml->node) {
-        m_xml->node = m_xml->doc.FirstChild();
-        m_token = m_xml->node->ToDeclaration() ? TokenType::StartDocument : resolveToken(m_xml->node, true);
+    if (m_xml->isEmptyElement) {
+        m_xml->isEmptyElement = false;
+        m_xml->elements.pop_back();
+        m_xml->attributes.clear();
+        m_token = TokenType::EndElement;
         return m_token;
     }
 
-    std::pair<XMLNode*, XmlStreamReader::TokenType> p = resolveNode(m_xml->node, m_token);
+    m_token = m_xml->parseNext();
+
+    if (m_token == TokenType::Invalid) {
+        LOGE() << errorString();
+        return m_token;
+    }
 
-    m_xml->node = p.first;
-    m_token = p.second;
+    m_xml->hasNodes = true;
 
     if (m_token == XmlStreamReader::TokenType::DTD) {
         tryParseEntity(m_xml);
@@ -174,11 +563,10 @@ XmlStreamReader::TokenType XmlStreamReader::readNext()
 
 void XmlStreamReader::tryParseEntity(Xml* xml)
 {
-    static const char* ENTITY = { "ENTITY" };
+    static const std::string_view ENTITY = { "ENTITY" };
 
-    const char* str = xml->node->Value();
-    if (std::strncmp(str, ENTITY, 6) == 0) {
-        QString val(str);
+    if (xml->value.substr(0, ENTITY.size()) == ENTITY) {
+        QString val = toQString(xml->value, Decoding::None);
         QStringList list = val.split(' ');
         if (list.length() == 3) {
             QString name = list.at(1);
@@ -192,7 +580,7 @@ void XmlStreamReader::tryParseEntity(Xml* xml)
 
 QString XmlStreamReader::nodeValue(Xml* xml) const
 {
-    QString str = xml->node->Value();
+    QString str = toQString(xml->value, xml->decoding);
     if (!m_entities.empty()) {
         for (const auto& p : m_entities) {
             str.replace(p.first, p.second);
@@ -225,7 +613,7 @@ AsciiString XmlStreamReader::tokenString() const
 
 bool XmlStreamReader::isWhitespace() const
 {
-    return false;
+    return m_token == TokenType::Characters && isBlank(m_xml->value);
 }
 
 void XmlStreamReader::skipCurrentElement()
@@ -242,7 +630,12 @@ void XmlStreamReader::skipCurrentElement()
 
 AsciiString XmlStreamReader::name() const
 {
-    return (m_xml->node && m_xml->node->ToElement()) ? m_xml->node->Value() : AsciiString();
+    if (m_token != TokenType::StartElement && m_token != TokenType::EndElement) {
+        return AsciiString();
+    }
+
+    //! NOTE The interned names are null terminated
+    return AsciiString(m_xml->name.data());
 }
 
 QString XmlStreamReader::attribute(const char* name) const
@@ -251,11 +644,13 @@ QString XmlStreamReader::attribute(const char* name) const
         return QString();
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return QString();
+    std::string_view n(name);
+    for (const Xml::RawAttribute& a : m_xml->attributes) {
+        if (a.name == n) {
+            return toQString(a.value, a.decoding);
+        }
     }
-    return e->Attribute(name);
+    return QString();
 }
 
 bool XmlStreamReader::hasAttribute(const char* name) const
@@ -264,11 +659,13 @@ bool XmlStreamReader::hasAttribute(const char* name) const
         return false;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return false;
+    std::string_view n(name);
+    for (const Xml::RawAttribute& a : m_xml->attributes) {
+        if (a.name == n) {
+            return true;
+        }
     }
-    return e->FindAttribute(name) != nullptr;
+    return false;
 }
 
 std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
@@ -278,15 +675,11 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
         return attrs;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return attrs;
-    }
-
-    for (const XMLAttribute* xa = e->FirstAttribute(); xa; xa = xa->Next()) {
+    attrs.reserve(m_xml->attributes.size());
+    for (const Xml::RawAttribute& xa : m_xml->attributes) {
         Attribute a;
-        a.name = xa->Name();
-        a.value = xa->Value();
+        a.name = toQString(xa.name, Decoding::None);
+        a.value = toQString(xa.value, xa.decoding);
         attrs.push_back(std::move(a));
     }
     return attrs;
@@ -307,6 +700,8 @@ QString XmlStreamReader::readElementText()
                 break;
             case StartElement:
                 break;
+            case Invalid:
+                return result;
             default:
                 break;
             }
@@ -317,7 +712,7 @@ QString XmlStreamReader::readElementText()
 
 QString XmlStreamReader::text() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
         return nodeValue(m_xml);
     }
     return QString();
@@ -325,12 +720,14 @@ QString XmlStreamReader::text() const
 
 int64_t XmlStreamReader::lineNumber() const
 {
-    return m_xml->doc.ErrorLineNum();
+    m_xml->countLines(m_xml->tokenPos);
+    return m_xml->line;
 }
 
 int64_t XmlStreamReader::columnNumber() const
 {
-    return 0;
+    m_xml->countLines(m_xml->tokenPos);
+    return m_xml->tokenPos - m_xml->lineStart + 1;
 }
 
 XmlStreamReader::Error XmlStreamReader::error() const
@@ -339,12 +736,7 @@ XmlStreamReader::Error XmlStreamReader::error() const
         return CustomError;
     }
 
-    XMLError err = m_xml->doc.ErrorID();
-    if (err == XML_SUCCESS) {
-        return NoError;
-    }
-
-    return NotWellFormedError;
+    return m_xml->err;
 }
 
 bool XmlStreamReader::isError() const
@@ -357,7 +749,7 @@ QString XmlStreamReader::errorString() const
     if (!m_xml->customErr.isEmpty()) {
         return m_xml->customErr;
     }
-    return m_xml->doc.ErrorStr();
+    return QString::fromStdString(m_xml->errStr);
 }
 
 void XmlStreamReader::raiseError(const QString& message)
@@ -105,6 +105,8 @@ public:
     void raiseError(const QString& message = QString());
 
 private:
+    //! NOTE The data is parsed on demand, token by token, without building a document tree.
+    //! Names and values are views into the data, the tag names are interned
     struct Xml;
 
     void tryParseEntity(Xml* xml);
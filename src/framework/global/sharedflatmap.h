@@ -0,0 +1,286 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_FRAMEWORK_SHAREDFLATMAP_H
+#define MU_FRAMEWORK_SHAREDFLATMAP_H
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace mu {
+//! NOTE The same as SharedMap, but the pairs are stored in one vector sorted by the key,
+//! so there is no allocation per key and iterating is cache friendly.
+//! Inserting is cheap at the end of the map, which is where the keys mostly go
+//! when the map is filled in the key order (for example, by time)
+template<typename KeyType, typename ValType>
+class SharedFlatMap
+{
+public:
+    using PairType = std::pair<KeyType, ValType>;
+    using Data = std::vector<PairType>;
+    using DataPtr = std::shared_ptr<Data>;
+    typedef typename Data::iterator iterator;
+    typedef typename Data::const_iterator const_iterator;
+    typedef typename Data::reverse_iterator reverse_iterator;
+    typedef typename Data::const_reverse_iterator const_reverse_iterator;
+
+    SharedFlatMap()
+    {
+        m_dataPtr = std::make_shared<Data>();
+    }
+
+    SharedFlatMap(std::initializer_list<PairType> initList)
+    {
+        m_dataPtr = std::make_shared<Data>();
+        for (const PairType& pair : initList) {
+            insert(pair);
+        }
+    }
+
+    SharedFlatMap(const SharedFlatMap&) = default;
+    SharedFlatMap(SharedFlatMap&&) = default;
+    SharedFlatMap& operator=(const SharedFlatMap&) = default;
+    SharedFlatMap& operator=(SharedFlatMap&&) = default;
+
+    const ValType& at(const KeyType& key) const
+    {
+        const_iterator it = find(key);
+        if (it == cend()) {
+            throw std::out_of_range("SharedFlatMap::at");
+        }
+
+        return it->second;
+    }
+
+    ValType& at(const KeyType& key)
+    {
+        ensureDetach();
+
+        iterator it = lowerBound(key);
+        if (it == m_dataPtr->end() || it->first != key) {
+            throw std::out_of_range("SharedFlatMap::at");
+        }
+
+        return it->second;
+    }
+
+    //! NOTE Unlike std::map, the returned reference (as well as the iterators)
+    //! is invalidated by the next insertion of a new key or by a copy being detached
+    ValType& operator[](const KeyType& key)
+    {
+        ensureDetach();
+
+        if (m_dataPtr->empty() || m_dataPtr->back().first < key) {
+            return m_dataPtr->emplace_back(key, ValType()).second;
+        }
+
+        iterator it = lowerBound(key);
+        if (it != m_dataPtr->end() && it->first == key) {
+            return it->second;
+        }
+
+        return m_dataPtr->emplace(it, key, ValType())->second;
+    }
+
+    iterator begin() noexcept
+    {
+        ensureDetach();
+        return m_dataPtr->begin();
+    }
+
+    iterator end() noexcept
+    {
+        ensureDetach();
+        return m_dataPtr->end();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return m_dataPtr->cbegin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return m_dataPtr->cend();
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return m_dataPtr->cbegin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return m_dataPtr->cend();
+    }
+
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return m_dataPtr->crbegin();
+    }
+
+    const_reverse_iterator rend() const noexcept
+    {
+        return m_dataPtr->crend();
+    }
+
+    const_iterator find(const KeyType& key) const noexcept
+    {
+        const_iterator it = lower_bound(key);
+        if (it != cend() && it->first == key) {
+            return it;
+        }
+
+        return cend();
+    }
+
+    const_iterator lower_bound(const KeyType& key) const
+    {
+        return std::lower_bound(m_dataPtr->cbegin(), m_dataPtr->cend(), key, [](const PairType& pair, const KeyType& k) {
+            return pair.first < k;
+        });
+    }
+
+    const_iterator upper_bound(const KeyType& key) const
+    {
+        return std::upper_bound(m_dataPtr->cbegin(), m_dataPtr->cend(), key, [](const KeyType& k, const PairType& pair) {
+            return k < pair.first;
+        });
+    }
+
+    bool contains(const KeyType& key) const noexcept
+    {
+        return find(key) != cend();
+    }
+
+    bool empty() const noexcept
+    {
+        return m_dataPtr->empty();
+    }
+
+    size_t size() const noexcept
+    {
+        return m_dataPtr->size();
+    }
+
+    void reserve(const size_t size)
+    {
+        ensureDetach();
+        m_dataPtr->reserve(size);
+    }
+
+    void insert(const PairType& pair)
+    {
+        if (contains(pair.first)) {
+            return;
+        }
+
+        operator[](pair.first) = pair.second;
+    }
+
+    void insert(PairType&& pair)
+    {
+        if (contains(pair.first)) {
+            return;
+        }
+
+        operator[](pair.first) = std::move(pair.second);
+    }
+
+    void insert_or_assign(const KeyType& key, ValType&& val)
+    {
+        operator[](key) = std::forward<ValType>(val);
+    }
+
+    void insert_or_assign(const KeyType& key, const ValType& val)
+    {
+        operator[](key) = val;
+    }
+
+    void clear() noexcept
+    {
+        if (m_dataPtr.use_count() == 1) {
+            m_dataPtr->clear();
+            return;
+        }
+
+        m_dataPtr = std::make_shared<Data>();
+    }
+
+    void erase(const KeyType& key)
+    {
+        const_iterator it = find(key);
+        if (it != cend()) {
+            erase(it, std::next(it));
+        }
+    }
+
+    //! NOTE The iterators may belong to the data shared with another map,
+    //! so they are converted to the positions before detaching
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        size_t firstIdx = std::distance(m_dataPtr->cbegin(), first);
+        size_t lastIdx = std::distance(m_dataPtr->cbegin(), last);
+
+        ensureDetach();
+
+        return m_dataPtr->erase(m_dataPtr->begin() + firstIdx, m_dataPtr->begin() + lastIdx);
+    }
+
+    bool operator ==(const SharedFlatMap& another) const noexcept
+    {
+        return m_dataPtr == another.m_dataPtr || *m_dataPtr == *another.m_dataPtr;
+    }
+
+    bool operator !=(const SharedFlatMap& another) const noexcept
+    {
+        return !this->operator ==(another);
+    }
+
+protected:
+    void ensureDetach()
+    {
+        if (!m_dataPtr) {
+            return;
+        }
+
+        if (m_dataPtr.use_count() == 1) {
+            return;
+        }
+
+        m_dataPtr = std::make_shared<Data>(*m_dataPtr);
+    }
+
+    iterator lowerBound(const KeyType& key)
+    {
+        return std::lower_bound(m_dataPtr->begin(), m_dataPtr->end(), key, [](const PairType& pair, const KeyType& k) {
+            return pair.first < k;
+        });
+    }
+
+    DataPtr m_dataPtr = nullptr;
+};
+}
+
+#endif // MU_FRAMEWORK_SHAREDFLATMAP_H
@@ -0,0 +1,128 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "sharedflatmap.h"
+
+using namespace mu;
+
+class Global_SharedFlatMapTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Global_SharedFlatMapTests, SharedFlatMap_Sorted)
+{
+    //! GIVEN Empty map
+    SharedFlatMap<int, std::string> map;
+    EXPECT_TRUE(map.empty());
+
+    //! DO Insert the keys in the random order
+    map[30] = "30";
+    map[10] = "10";
+    map.insert({ 20, "20" });
+    map.insert_or_assign(40, "40");
+
+    //! DO Insert the existing key
+    map.insert({ 10, "other" });
+
+    //! CHECK The keys are sorted, the existing value is not replaced
+    EXPECT_EQ(map.size(), 4);
+
+    std::vector<int> keys;
+    for (const auto& pair : map) {
+        keys.push_back(pair.first);
+    }
+
+    EXPECT_EQ(keys, std::vector<int>({ 10, 20, 30, 40 }));
+    EXPECT_EQ(map.at(10), "10");
+    EXPECT_EQ(map.rbegin()->first, 40);
+
+    //! CHECK Lookup
+    EXPECT_TRUE(map.contains(20));
+    EXPECT_FALSE(map.contains(25));
+    EXPECT_TRUE(map.find(25) == map.cend());
+    EXPECT_THROW(map.at(25), std::out_of_range);
+
+    EXPECT_EQ(map.lower_bound(20)->first, 20);
+    EXPECT_EQ(map.lower_bound(25)->first, 30);
+    EXPECT_EQ(map.upper_bound(20)->first, 30);
+    EXPECT_TRUE(map.upper_bound(40) == map.cend());
+}
+
+TEST_F(Global_SharedFlatMapTests, SharedFlatMap_Erase)
+{
+    //! GIVEN Map with some values
+    SharedFlatMap<int, std::string> map = { { 1, "1" }, { 2, "2" }, { 3, "3" }, { 4, "4" }, { 5, "5" } };
+
+    //! DO Erase a single key
+    map.erase(1);
+
+    //! CHECK The key is erased
+    EXPECT_EQ(map.size(), 4);
+    EXPECT_FALSE(map.contains(1));
+
+    //! DO Erase the range [2, 4]
+    const SharedFlatMap<int, std::string>& cmap = map;
+    map.erase(cmap.lower_bound(2), cmap.upper_bound(4));
+
+    //! CHECK Only the last key is left
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map.cbegin()->first, 5);
+
+    //! DO Clear the map
+    map.clear();
+
+    //! CHECK The map is empty
+    EXPECT_TRUE(map.empty());
+}
+
+TEST_F(Global_SharedFlatMapTests, SharedFlatMap_CopyOnWrite)
+{
+    //! GIVEN Map with some values
+    SharedFlatMap<int, std::string> map1 = { { 1, "1" }, { 2, "2" }, { 3, "3" } };
+
+    //! DO Copy the map
+    SharedFlatMap<int, std::string> map2 = map1;
+
+    //! CHECK The data is shared
+    EXPECT_TRUE(map1 == map2);
+    EXPECT_EQ(&(*map1.cbegin()), &(*map2.cbegin()));
+
+    //! DO Erase the range from the copy by the iterators of the shared data
+    map2.erase(map2.cbegin(), map2.lower_bound(3));
+
+    //! CHECK The copy is changed, the origin is not
+    EXPECT_EQ(map2.size(), 1);
+    EXPECT_EQ(map1.size(), 3);
+    EXPECT_TRUE(map1 != map2);
+
+    //! DO Change the value in the origin
+    map1[1] = "one";
+
+    //! CHECK The another copy is not changed
+    SharedFlatMap<int, std::string> map3 = { { 1, "1" }, { 2, "2" }, { 3, "3" } };
+    EXPECT_EQ(map1.at(1), "one");
+    EXPECT_TRUE(map1 != map3);
+}
@@ -0,0 +1,258 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include <QDir>
+#include <QFile>
+
+#include "serialization/xmlstreamreader.h"
+#include "thirdparty/tinyxml/tinyxml2.h"
+
+#include "log.h"
+
+using namespace mu;
+
+class Global_Ser_XmlStreamReaderTests : public ::testing::Test
+{
+public:
+};
+
+//! NOTE The start and the end tags with the attributes and the texts, in the document order
+static QString streamSignature(XmlStreamReader& xml)
+{
+    QString sig;
+    while (!xml.atEnd()) {
+        switch (xml.readNext()) {
+        case XmlStreamReader::StartElement:
+            sig += "<";
+            sig += xml.name().toQLatin1String();
+            for (const XmlStreamReader::Attribute& a : xml.attributes()) {
+                sig += " " + a.name + "=" + a.value;
+            }
+            sig += ">";
+            break;
+        case XmlStreamReader::EndElement:
+            sig += "</";
+            sig += xml.name().toQLatin1String();
+            sig += ">";
+            break;
+        case XmlStreamReader::Characters:
+            sig += "#" + xml.text();
+            break;
+        default:
+            break;
+        }
+    }
+    return sig;
+}
+
+static void domSignature(const tinyxml2::XMLNode* node, QString& sig)
+{
+    for (const tinyxml2::XMLNode* n = node->FirstChild(); n; n = n->NextSibling()) {
+        if (const tinyxml2::XMLElement* e = n->ToElement()) {
+            sig += QString("<") + e->Name();
+            for (const tinyxml2::XMLAttribute* a = e->FirstAttribute(); a; a = a->Next()) {
+                sig += QString(" ") + a->Name() + "=" + a->Value();
+            }
+            sig += ">";
+            domSignature(e, sig);
+            sig += QString("</") + e->Name() + ">";
+        } else if (const tinyxml2::XMLText* t = n->ToText()) {
+            sig += QString("#") + t->Value();
+        }
+    }
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, XmlStreamReader_Tokens)
+{
+    //! GIVEN Some xml
+    ByteArray data("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n"
+                   "<museScore version=\"4.00\">\r\n"
+                   "  <Score>\r\n"
+                   "    <metaTag name=\"title\">A &amp; B &#x263A;</metaTag>\r\n"
+                   "    <Staff id='1'/>\r\n"
+                   "    <!-- comment -->\r\n"
+                   "    <text>a <b>bold</b> c</text>\r\n"
+                   "    <data><![CDATA[<raw>&amp;]]></data>\r\n"
+                   "  </Score>\r\n"
+                   "</museScore>\r\n");
+
+    //! DO Read it
+    XmlStreamReader xml(data);
+
+    //! CHECK
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartDocument);
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "museScore");
+    EXPECT_EQ(xml.attribute("version"), QString("4.00"));
+    EXPECT_EQ(xml.lineNumber(), 2);
+
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "Score");
+
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "metaTag");
+    EXPECT_TRUE(xml.hasAttribute("name"));
+    EXPECT_FALSE(xml.hasAttribute("value"));
+    EXPECT_EQ(xml.readElementText(), QString::fromUtf8("A & B ☺"));
+    EXPECT_EQ(xml.name(), "metaTag");
+
+    // the empty element followed by a comment
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "Staff");
+    EXPECT_EQ(xml.attribute("id"), QString("1"));
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(xml.name(), "Staff");
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::Comment);
+    EXPECT_EQ(xml.text(), QString(" comment "));
+
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "text");
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::Characters);
+    EXPECT_EQ(xml.text(), QString("a "));
+    xml.skipCurrentElement();
+    EXPECT_EQ(xml.name(), "text");
+
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "data");
+    EXPECT_EQ(xml.readElementText(), QString("<raw>&amp;"));
+
+    EXPECT_FALSE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "Score");
+    EXPECT_FALSE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "museScore");
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndDocument);
+    EXPECT_TRUE(xml.atEnd());
+    EXPECT_FALSE(xml.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, XmlStreamReader_Entities)
+{
+    //! GIVEN Xml with the declared entity
+    ByteArray data("<!ENTITY nbsp \"&#160;\">\n<a>x&nbsp;y</a>");
+
+    //! DO Read it
+    XmlStreamReader xml(data);
+
+    //! CHECK
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::DTD);
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readElementText(), QString("x&#160;y"));
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, XmlStreamReader_Errors)
+{
+    {
+        //! GIVEN Mismatched element
+        XmlStreamReader xml(ByteArray("<a>\n<b>\n</a>"));
+
+        //! DO Read it
+        EXPECT_TRUE(xml.readNextStartElement());
+        EXPECT_TRUE(xml.readNextStartElement());
+        EXPECT_FALSE(xml.readNextStartElement());
+
+        //! CHECK
+        EXPECT_TRUE(xml.atEnd());
+        EXPECT_EQ(xml.error(), XmlStreamReader::NotWellFormedError);
+        EXPECT_EQ(xml.lineNumber(), 3);
+    }
+
+    {
+        //! GIVEN Not closed element
+        XmlStreamReader xml(ByteArray("<a><b/>"));
+
+        //! DO Read it
+        QString sig = streamSignature(xml);
+
+        //! CHECK
+        EXPECT_EQ(sig, QString("<a><b></b>"));
+        EXPECT_EQ(xml.error(), XmlStreamReader::PrematureEndOfDocumentError);
+    }
+
+    {
+        //! GIVEN Empty document
+        XmlStreamReader xml(ByteArray("  \n"));
+
+        //! DO Read it
+        EXPECT_FALSE(xml.readNextStartElement());
+
+        //! CHECK
+        EXPECT_TRUE(xml.isError());
+    }
+
+    {
+        //! GIVEN Custom error
+        XmlStreamReader xml(ByteArray("<a/>"));
+
+        //! DO Raise it
+        xml.raiseError("custom");
+
+        //! CHECK
+        EXPECT_EQ(xml.error(), XmlStreamReader::CustomError);
+        EXPECT_EQ(xml.errorString(), QString("custom"));
+    }
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, XmlStreamReader_LoadScores)
+{
+    using clock = std::chrono::steady_clock;
+
+    //! GIVEN The scores of the visual tests
+    QDir dir(QString(global_tests_DATA_ROOT) + "/scores");
+    QStringList files = dir.entryList({ "*.mscx" }, QDir::Files);
+    ASSERT_FALSE(files.isEmpty());
+
+    int64_t streamTime = 0;
+    int64_t domTime = 0;
+    size_t bytes = 0;
+
+    for (const QString& fileName : files) {
+        QFile file(dir.filePath(fileName));
+        ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+        QByteArray content = file.readAll();
+        bytes += content.size();
+
+        //! DO Read the score with the reader
+        clock::time_point started = clock::now();
+        XmlStreamReader xml(content);
+        QString sig = streamSignature(xml);
+        streamTime += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - started).count();
+
+        //! DO Read the score to the tinyxml2 document as the reference
+        started = clock::now();
+        tinyxml2::XMLDocument doc;
+        doc.Parse(content.constData(), content.size());
+        QString ref;
+        domSignature(&doc, ref);
+        domTime += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - started).count();
+
+        //! CHECK
+        EXPECT_FALSE(xml.isError()) << fileName.toStdString() << ": " << xml.errorString().toStdString();
+        EXPECT_EQ(sig, ref) << fileName.toStdString();
+    }
+
+    LOGI() << "read " << files.size() << " scores (" << bytes << " bytes): stream reader " << streamTime << " us, "
+           << "tinyxml2 document " << domTime << " us";
+}
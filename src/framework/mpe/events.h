@@ -29,6 +29,7 @@
 
 #include "async/channel.h"
 #include "realfn.h"
+#include "sharedflatmap.h"
 
 #include "mpetypes.h"
 #include "soundid.h"
@@ -38,9 +39,15 @@ struct NoteEvent;
 struct RestEvent;
 using PlaybackEvent = std::variant<NoteEvent, RestEvent>;
 using PlaybackEventList = std::vector<PlaybackEvent>;
-using PlaybackEventsMap = std::map<msecs_t, PlaybackEventList>;
+using PlaybackEventsMap = SharedFlatMap<msecs_t, PlaybackEventList>;
 using PlaybackEventsChanges = async::Channel<PlaybackEventsMap>;
 
+struct CurvesInternPool
+{
+    PitchCurve::InternPool pitchCurves;
+    ExpressionCurve::InternPool expressionCurves;
+};
+
 struct ArrangementContext
 {
     timestamp_t nominalTimestamp = 0;
@@ -130,6 +137,14 @@ struct NoteEvent
         return m_expressionCtx;
     }
 
+    //! NOTE Makes the curves share the data with the equal curves of the pool,
+    //! called once the events are rendered, not thread safe
+    void internCurves(CurvesInternPool& pool)
+    {
+        m_pitchCtx.pitchCurve.intern(pool.pitchCurves);
+        m_expressionCtx.expressionCurve.intern(pool.expressionCurves);
+    }
+
     bool operator==(const NoteEvent& other) const
     {
         return m_arrangementCtx == other.m_arrangementCtx
@@ -104,6 +104,34 @@ struct ValuesCurve : public SharedMap<duration_percentage_t, T>
     {
         return this->empty() ? 0 : this->rbegin()->first - amplitudeValuePoint().first;
     }
+
+    using InternPool = std::unordered_multimap<size_t, typename SharedMap<duration_percentage_t, T>::DataPtr>;
+
+    //! NOTE Most of the curves of a score are equal to each other,
+    //! so the equal curves share the same data instead of keeping a copy per event.
+    //! The pool belongs to the caller (ex. the playback model) and isn't thread safe
+    void intern(InternPool& pool)
+    {
+        static constexpr size_t MAX_INTERNED_CURVES = 4096;
+
+        size_t hash = 0;
+        for (auto it = this->cbegin(); it != this->cend(); ++it) {
+            hash = hash * 31 + std::hash<duration_percentage_t>()(it->first);
+            hash = hash * 31 + std::hash<T>()(it->second);
+        }
+
+        auto range = pool.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (*it->second == *this->m_dataPtr) {
+                this->m_dataPtr = it->second;
+                return;
+            }
+        }
+
+        if (pool.size() < MAX_INTERNED_CURVES) {
+            pool.emplace(hash, this->m_dataPtr);
+        }
+    }
 };
 
 // Pitch
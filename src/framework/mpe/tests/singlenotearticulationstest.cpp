@@ -20,6 +20,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <set>
+
 #include <gtest/gtest.h>
 
 #include "mpe/events.h"
@@ -422,3 +424,64 @@ TEST_F(SingleNoteArticulationsTest, Scoop)
     //        In other words, we'll start to playback a note with pitch offset and then finally land on the note being played
     EXPECT_EQ(event.arrangementCtx().actualTimestamp, m_nominalTimestamp + m_nominalDuration * percentageToFactor(timestampOffset));
 }
+
+/**
+ * @brief SingleNoteArticulationsTest_EqualCurvesAreShared
+ * @details In this case we're gonna build a lot of note events with the same articulation applied on the top of them,
+ *          but with the articulation maps built separately for every note (as it happens when a score is being rendered)
+ *          We expect that the equal curves of all these events, interned in one pool, share the same data instead of keeping a copy per event
+ */
+TEST_F(SingleNoteArticulationsTest, EqualCurvesAreShared)
+{
+    // [GIVEN] Staccato pattern
+    ArticulationPatternSegment staccatoPattern;
+    staccatoPattern.arrangementPattern = createArrangementPattern(5 * TEN_PERCENT /*duration_factor*/, 0 /*timestamp_offset*/);
+    staccatoPattern.pitchPattern = createSimplePitchPattern(0 /*increment_pitch_diff*/);
+    staccatoPattern.expressionPattern = createSimpleExpressionPattern(dynamicLevelFromType(DynamicType::mf));
+
+    constexpr size_t eventsCount = 10000;
+
+    CurvesInternPool pool;
+
+    std::set<const void*> pitchCurves;
+    std::set<const void*> expressionCurves;
+
+    for (size_t i = 0; i < eventsCount; ++i) {
+        ArticulationPattern scope;
+        scope.emplace(0, staccatoPattern);
+
+        ArticulationMeta staccatoMeta;
+        staccatoMeta.type = ArticulationType::Staccato;
+        staccatoMeta.pattern = scope;
+        staccatoMeta.timestamp = m_nominalTimestamp + i * m_nominalDuration;
+        staccatoMeta.overallDuration = m_nominalDuration;
+
+        ArticulationMap appliedArticulations;
+        appliedArticulations.emplace(ArticulationType::Staccato, ArticulationAppliedData(std::move(staccatoMeta), 0, HUNDRED_PERCENT));
+        appliedArticulations.preCalculateAverageData();
+
+        // [WHEN] Note event with given parameters being built, the dynamic alternates between two levels
+        dynamic_level_t nominalDynamic = i % 2 ? dynamicLevelFromType(DynamicType::p) : dynamicLevelFromType(DynamicType::f);
+
+        NoteEvent event(m_nominalTimestamp + i * m_nominalDuration,
+                        m_nominalDuration,
+                        m_voiceIdx,
+                        pitchLevel(m_pitchClass, m_octave),
+                        nominalDynamic,
+                        std::move(appliedArticulations));
+
+        ASSERT_FALSE(event.pitchCtx().pitchCurve.empty());
+        ASSERT_FALSE(event.expressionCtx().expressionCurve.empty());
+
+        // [WHEN] The curves of the rendered event are interned
+        event.internCurves(pool);
+
+        //! NOTE The curves with the same data have their first points at the same address
+        pitchCurves.insert(&(*event.pitchCtx().pitchCurve.cbegin()));
+        expressionCurves.insert(&(*event.expressionCtx().expressionCurve.cbegin()));
+    }
+
+    // [THEN] All the events share one pitch curve and one expression curve per dynamic level
+    EXPECT_EQ(pitchCurves.size(), 1);
+    EXPECT_EQ(expressionCurves.size(), 2);
+}
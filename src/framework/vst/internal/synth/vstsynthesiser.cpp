@@ -58,7 +58,8 @@ Ret VstSynthesiser::init()
         m_paramsChanges.send(m_params);
     });
 
-    m_vstAudioClient->setBlockSize(m_samplesPerChannel);
+    m_blockSize = m_samplesPerChannel;
+    m_vstAudioClient->setBlockSize(m_blockSize);
 
     return make_ret(Ret::Code::Ok);
 }
@@ -163,6 +164,16 @@ audio::samples_t VstSynthesiser::process(float* buffer, audio::samples_t samples
         return 0;
     }
 
+    //! NOTE: Offline rendering may request larger blocks than the driver does,
+    //! the driver block size is restored as soon as the blocks are small again
+    if (samplesPerChannel > m_blockSize) {
+        m_blockSize = samplesPerChannel;
+        m_vstAudioClient->setBlockSize(m_blockSize);
+    } else if (m_blockSize > m_samplesPerChannel && samplesPerChannel <= m_samplesPerChannel) {
+        m_blockSize = m_samplesPerChannel;
+        m_vstAudioClient->setBlockSize(m_blockSize);
+    }
+
     if (isActive()) {
         handleMainStreamEvents(nextMsecs);
     } else {
@@ -78,6 +78,7 @@ private:
 
     async::Channel<unsigned int> m_streamsCountChanged;
     audio::samples_t m_samplesPerChannel = 0;
+    audio::samples_t m_blockSize = 0;
 
     std::list<mpe::PlaybackEvent> m_playingEvents;
 };
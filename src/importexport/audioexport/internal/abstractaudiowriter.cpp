@@ -70,6 +70,12 @@ mu::Ret AbstractAudioWriter::writeList(const INotationPtrList&, io::Device&, con
     return Ret(Ret::Code::NotSupported);
 }
 
+mu::Ret AbstractAudioWriter::writePages(INotationPtr, const std::vector<io::Device*>&, const Options&)
+{
+    NOT_SUPPORTED;
+    return Ret(Ret::Code::NotSupported);
+}
+
 void AbstractAudioWriter::abort()
 {
     NOT_IMPLEMENTED;
@@ -90,6 +96,13 @@ void AbstractAudioWriter::doWriteAndWait(io::Device& destinationDevice, const au
     QFileInfo info(*file);
     QString path = info.absoluteFilePath();
 
+    m_isCompleted = false;
+
+    async::Channel<audio::TrackSequenceId, framework::Progress> saveProgress = playback()->audioOutput()->saveSoundTrackProgressChanged();
+    saveProgress.onReceive(this, [this](audio::TrackSequenceId, const framework::Progress& progress) {
+        m_progress.send(progress);
+    });
+
     playback()->sequenceIdList()
     .onResolve(this, [this, path, &format](const audio::TrackSequenceIdList& sequenceIdList) {
         for (const audio::TrackSequenceId sequenceId : sequenceIdList) {
@@ -112,6 +125,8 @@ void AbstractAudioWriter::doWriteAndWait(io::Device& destinationDevice, const au
         QApplication::instance()->processEvents();
         QThread::yieldCurrentThread();
     }
+
+    saveProgress.resetOnReceive(this);
 }
 
 INotationWriter::UnitType AbstractAudioWriter::unitTypeFromOptions(const Options& options) const
@@ -63,6 +63,12 @@ mu::Ret BrailleWriter::writeList(const notation::INotationPtrList&, io::Device&,
     return Ret(Ret::Code::NotSupported);
 }
 
+mu::Ret BrailleWriter::writePages(notation::INotationPtr, const std::vector<io::Device*>&, const Options&)
+{
+    NOT_SUPPORTED;
+    return Ret(Ret::Code::NotSupported);
+}
+
 void BrailleWriter::abort()
 {
     NOT_IMPLEMENTED;
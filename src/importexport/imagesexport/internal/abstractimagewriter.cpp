@@ -68,6 +68,27 @@ mu::Ret AbstractImageWriter::writeList(const INotationPtrList&, io::Device&, con
     return Ret(Ret::Code::NotSupported);
 }
 
+mu::Ret AbstractImageWriter::writePages(INotationPtr notation, const std::vector<io::Device*>& devices, const Options& options)
+{
+    if (!supportsUnitType(UnitType::PER_PAGE)) {
+        NOT_SUPPORTED;
+        return Ret(Ret::Code::NotSupported);
+    }
+
+    Options pageOptions = options;
+
+    for (size_t i = 0; i < devices.size(); ++i) {
+        pageOptions[OptionKey::PAGE_NUMBER] = Val(static_cast<int>(i));
+
+        Ret ret = write(notation, *devices[i], pageOptions);
+        if (!ret) {
+            return ret;
+        }
+    }
+
+    return make_ok();
+}
+
 void AbstractImageWriter::abort()
 {
     NOT_IMPLEMENTED;
@@ -36,6 +36,7 @@ public:
 
     Ret write(notation::INotationPtr notation, io::Device& destinationDevice, const Options& options = Options()) override;
     Ret writeList(const notation::INotationPtrList& notations, io::Device& destinationDevice, const Options& options = Options()) override;
+    Ret writePages(notation::INotationPtr notation, const std::vector<io::Device*>& devices, const Options& options = Options()) override;
 
     void abort() override;
     framework::ProgressChannel progress() const override;
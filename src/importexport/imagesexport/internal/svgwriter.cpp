@@ -22,6 +22,11 @@
 
 #include "svgwriter.h"
 
+#include <atomic>
+#include <thread>
+
+#include <QElapsedTimer>
+
 #include "svggenerator.h"
 
 #include "libmscore/masterscore.h"
@@ -30,6 +35,7 @@
 #include "libmscore/staff.h"
 #include "libmscore/measure.h"
 #include "libmscore/stafflines.h"
+#include "libmscore/text.h"
 #include "libmscore/repeatlist.h"
 #include "engraving/paint/paint.h"
 
@@ -56,51 +62,176 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
         return make_ret(Ret::Code::UnknownError);
     }
 
-    score->setPrinting(true); // don’t print page break symbols etc.
+    const size_t PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
+    if (PAGE_NUMBER >= score->pages().size()) {
+        return false;
+    }
 
-    Ms::MScore::pdfPrinting = true;
-    Ms::MScore::svgPrinting = true;
+    double pixelRatioBackup = beginPrinting(score);
 
-    const std::vector<Ms::Page*>& pages = score->pages();
-    double pixelRationBackup = Ms::MScore::pixelRatio;
+    applyBeatsColors(score, parseBeatsColors(options.value(OptionKey::BEATS_COLORS, Val()).toQVariant()));
 
-    const size_t PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
-    if (PAGE_NUMBER >= pages.size()) {
+    std::vector<Ms::StaffLines*> clones;
+    StaffLinesList staffLines = collectStaffLines(score, score->pages().at(PAGE_NUMBER), clones);
+    TextList headerFooterTexts = score->pages().at(PAGE_NUMBER)->cloneHeaderFooterTexts();
+
+    Ret ret = writePage(score, PAGE_NUMBER, staffLines, headerFooterTexts, destinationDevice, options);
+
+    qDeleteAll(clones);
+    qDeleteAll(headerFooterTexts);
+    endPrinting(score, pixelRatioBackup);
+
+    return ret;
+}
+
+mu::Ret SvgWriter::writePages(INotationPtr notation, const std::vector<Device*>& devices, const Options& options)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    Ms::Score* score = notation->elements()->msScore();
+    IF_ASSERT_FAILED(score) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    const std::vector<Ms::Page*>& pages = score->pages();
+    const size_t pagesCount = devices.size();
+    if (pagesCount > pages.size()) {
         return false;
     }
 
-    Ms::Page* page = pages.at(PAGE_NUMBER);
+    double pixelRatioBackup = beginPrinting(score);
 
-    SvgGenerator printer;
-    QString title(score->name());
-    printer.setTitle(pages.size() > 1 ? QString("%1 (%2)").arg(title).arg(PAGE_NUMBER + 1) : title);
-    printer.setOutputDevice(&destinationDevice);
+    //! NOTE The score is changed only here, in the main thread.
+    //! After that, the pages are painted in parallel, the painting doesn't change the score.
+    //! Drawing a page lays out the header/footer texts shared by all the pages,
+    //! so each page paints its own laid out copies of them instead
+    applyBeatsColors(score, parseBeatsColors(options.value(OptionKey::BEATS_COLORS, Val()).toQVariant()));
 
-    const int TRIM_MARGIN_SIZE = configuration()->trimMarginPixelSize();
+    std::vector<Ms::StaffLines*> clones;
+    std::vector<StaffLinesList> staffLines(pagesCount);
+    std::vector<TextList> headerFooterTexts(pagesCount);
+    for (size_t i = 0; i < pagesCount; ++i) {
+        staffLines[i] = collectStaffLines(score, pages.at(i), clones);
+        headerFooterTexts[i] = pages.at(i)->cloneHeaderFooterTexts();
+    }
 
-    RectF pageRect = page->abbox();
-    if (TRIM_MARGIN_SIZE >= 0) {
-        pageRect = page->tbbox().adjusted(-TRIM_MARGIN_SIZE, -TRIM_MARGIN_SIZE, TRIM_MARGIN_SIZE, TRIM_MARGIN_SIZE);
+    std::vector<Ret> results(pagesCount);
+    std::vector<int64_t> timings(pagesCount, 0);
+    std::atomic<size_t> nextPage { 0 };
+
+    auto writeNextPages = [&]() {
+        for (size_t i = nextPage++; i < pagesCount; i = nextPage++) {
+            QElapsedTimer timer;
+            timer.start();
+
+            results[i] = writePage(score, i, staffLines[i], headerFooterTexts[i], *devices[i], options);
+            timings[i] = timer.elapsed();
+        }
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+
+    size_t threadsCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), pagesCount);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 1; i < threadsCount; ++i) {
+        threads.emplace_back(writeNextPages);
     }
 
-    qreal width = pageRect.width();
-    qreal height = pageRect.height();
-    printer.setSize(QSize(width, height));
-    printer.setViewBox(QRectF(0, 0, width, height));
+    writeNextPages();
 
-    mu::draw::Painter painter(&printer, "svgwriter");
-    painter.setAntialiasing(true);
-    if (TRIM_MARGIN_SIZE >= 0) {
-        painter.translate(-pageRect.topLeft());
+    for (std::thread& thread : threads) {
+        thread.join();
     }
 
-    Ms::MScore::pixelRatio = Ms::DPI / printer.logicalDpiX();
+    qDeleteAll(clones);
+    for (const TextList& texts : headerFooterTexts) {
+        qDeleteAll(texts);
+    }
+    endPrinting(score, pixelRatioBackup);
 
-    if (!options[OptionKey::TRANSPARENT_BACKGROUND].toBool()) {
-        painter.fillRect(pageRect, mu::draw::Color::white);
+    for (size_t i = 0; i < pagesCount; ++i) {
+        LOGI() << "page " << i + 1 << " written in " << timings[i] << " ms";
     }
 
-    // 1st pass: StaffLines
+    LOGI() << pagesCount << " pages written in " << timer.elapsed() << " ms, threads: " << threadsCount;
+
+    for (const Ret& ret : results) {
+        if (!ret) {
+            return ret;
+        }
+    }
+
+    return make_ok();
+}
+
+double SvgWriter::beginPrinting(Ms::Score* score) const
+{
+    score->setPrinting(true); // don’t print page break symbols etc.
+
+    Ms::MScore::pdfPrinting = true;
+    Ms::MScore::svgPrinting = true;
+
+    double pixelRatioBackup = Ms::MScore::pixelRatio;
+    Ms::MScore::pixelRatio = Ms::DPI / SvgGenerator().logicalDpiX();
+
+    return pixelRatioBackup;
+}
+
+void SvgWriter::endPrinting(Ms::Score* score, double pixelRatioBackup) const
+{
+    Ms::MScore::pixelRatio = pixelRatioBackup;
+    score->setPrinting(false);
+    Ms::MScore::pdfPrinting = false;
+    Ms::MScore::svgPrinting = false;
+}
+
+void SvgWriter::applyBeatsColors(Ms::Score* score, const BeatsColors& beatsColors) const
+{
+    if (beatsColors.empty()) {
+        return;
+    }
+
+    int beatIndex = 0;
+    for (const Ms::RepeatSegment* repeatSegment : score->repeatList()) {
+        for (const Ms::Measure* measure : repeatSegment->measureList()) {
+            for (Ms::Segment* segment = measure->first(); segment; segment = segment->next()) {
+                if (!segment->isChordRestType()) {
+                    continue;
+                }
+
+                if (beatsColors.contains(beatIndex)) {
+                    for (EngravingItem* element : segment->elist()) {
+                        if (!element) {
+                            continue;
+                        }
+
+                        if (element->isChord()) {
+                            for (Note* note : toChord(element)->notes()) {
+                                note->setColor(beatsColors[beatIndex]);
+                            }
+                        } else if (element->isChordRest()) {
+                            element->setColor(beatsColors[beatIndex]);
+                        }
+                    }
+                }
+
+                beatIndex++;
+            }
+        }
+    }
+}
+
+SvgWriter::StaffLinesList SvgWriter::collectStaffLines(const Ms::Score* score, const Ms::Page* page,
+                                                      std::vector<Ms::StaffLines*>& clones) const
+{
+    StaffLinesList result;
+
     for (const Ms::System* system : page->systems()) {
         size_t stavesCount = system->staves().size();
 
@@ -141,9 +272,7 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
             if (byMeasure) {     // Draw visible staff lines by measure
                 for (Ms::MeasureBase* measure = firstMeasure; measure; measure = system->nextMeasure(measure)) {
                     if (measure->isMeasure() && Ms::toMeasure(measure)->visible(staffIndex)) {
-                        Ms::StaffLines* sl = Ms::toMeasure(measure)->staffLines(static_cast<int>(staffIndex));
-                        printer.setElement(sl);
-                        engraving::Paint::paintElement(painter, sl);
+                        result.push_back(Ms::toMeasure(measure)->staffLines(static_cast<int>(staffIndex)));
                     }
                 }
             } else {   // Draw staff lines once per system
@@ -158,45 +287,55 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
                     lines[l].setP2(mu::PointF(lastX, lines[l].p2().y()));
                 }
 
-                printer.setElement(firstSL);
-                engraving::Paint::paintElement(painter, firstSL);
+                clones.push_back(firstSL);
+                result.push_back(firstSL);
             }
         }
     }
 
-    BeatsColors beatsColors = parseBeatsColors(options.value(OptionKey::BEATS_COLORS, Val()).toQVariant());
+    return result;
+}
 
-    // 2st pass: Set color for elements on beats
-    int beatIndex = 0;
-    for (const Ms::RepeatSegment* repeatSegment : score->repeatList()) {
-        for (const Ms::Measure* measure : repeatSegment->measureList()) {
-            for (Ms::Segment* segment = measure->first(); segment; segment = segment->next()) {
-                if (!segment->isChordRestType()) {
-                    continue;
-                }
+mu::Ret SvgWriter::writePage(Ms::Score* score, size_t pageNumber, const StaffLinesList& staffLines, const TextList& headerFooterTexts,
+                             Device& destinationDevice, const Options& options) const
+{
+    const std::vector<Ms::Page*>& pages = score->pages();
+    Ms::Page* page = pages.at(pageNumber);
 
-                if (beatsColors.contains(beatIndex)) {
-                    for (EngravingItem* element : segment->elist()) {
-                        if (!element) {
-                            continue;
-                        }
+    SvgGenerator printer;
+    QString title(score->name());
+    printer.setTitle(pages.size() > 1 ? QString("%1 (%2)").arg(title).arg(pageNumber + 1) : title);
+    printer.setOutputDevice(&destinationDevice);
 
-                        if (element->isChord()) {
-                            for (Note* note : toChord(element)->notes()) {
-                                note->setColor(beatsColors[beatIndex]);
-                            }
-                        } else if (element->isChordRest()) {
-                            element->setColor(beatsColors[beatIndex]);
-                        }
-                    }
-                }
+    const int TRIM_MARGIN_SIZE = configuration()->trimMarginPixelSize();
 
-                beatIndex++;
-            }
-        }
+    RectF pageRect = page->abbox();
+    if (TRIM_MARGIN_SIZE >= 0) {
+        pageRect = page->tbbox().adjusted(-TRIM_MARGIN_SIZE, -TRIM_MARGIN_SIZE, TRIM_MARGIN_SIZE, TRIM_MARGIN_SIZE);
+    }
+
+    qreal width = pageRect.width();
+    qreal height = pageRect.height();
+    printer.setSize(QSize(width, height));
+    printer.setViewBox(QRectF(0, 0, width, height));
+
+    mu::draw::Painter painter(&printer, "svgwriter");
+    painter.setAntialiasing(true);
+    if (TRIM_MARGIN_SIZE >= 0) {
+        painter.translate(-pageRect.topLeft());
+    }
+
+    if (!options[OptionKey::TRANSPARENT_BACKGROUND].toBool()) {
+        painter.fillRect(pageRect, mu::draw::Color::white);
     }
 
-    // 3nd pass: the rest of the elements
+    // 1st pass: StaffLines
+    for (const Ms::StaffLines* sl : staffLines) {
+        printer.setElement(sl);
+        engraving::Paint::paintElement(painter, sl);
+    }
+
+    // 2nd pass: the rest of the elements
     std::vector<Ms::EngravingItem*> elements = page->elements();
     std::sort(elements.begin(), elements.end(), Ms::elementLessThan);
 
@@ -211,6 +350,13 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
         case Ms::ElementType::STAFF_LINES: // Handled in the 1st pass above
             continue; // Exclude from 2nd pass
             break;
+        case Ms::ElementType::PAGE: // The page draws only the header/footer, their copies are painted instead
+            printer.setElement(element);
+            for (const Ms::Text* text : headerFooterTexts) {
+                engraving::Paint::paintElement(painter, text);
+            }
+            continue;
+            break;
         default:
             break;
         }
@@ -224,12 +370,6 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
 
     painter.endDraw(); // Writes MuseScore SVG file to disk, finally
 
-    // Clean up and return
-    Ms::MScore::pixelRatio = pixelRationBackup;
-    score->setPrinting(false);
-    Ms::MScore::pdfPrinting = false;
-    Ms::MScore::svgPrinting = false;
-
     return true;
 }
 
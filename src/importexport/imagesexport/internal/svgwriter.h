@@ -28,6 +28,13 @@
 #include "modularity/ioc.h"
 #include "iimagesexportconfiguration.h"
 
+namespace Ms {
+class Page;
+class Score;
+class StaffLines;
+class Text;
+}
+
 namespace mu::iex::imagesexport {
 class SvgWriter : public AbstractImageWriter
 {
@@ -36,11 +43,23 @@ class SvgWriter : public AbstractImageWriter
 public:
     std::vector<project::INotationWriter::UnitType> supportedUnitTypes() const override;
     Ret write(notation::INotationPtr notation, io::Device& destinationDevice, const Options& options = Options()) override;
+    Ret writePages(notation::INotationPtr notation, const std::vector<io::Device*>& devices, const Options& options = Options()) override;
 
 private:
     using BeatsColors = QHash<int /* beatIndex */, QColor>;
+    using StaffLinesList = std::vector<const Ms::StaffLines*>;
+    using TextList = std::vector<Ms::Text*>;
 
     BeatsColors parseBeatsColors(const QVariant& obj) const;
+
+    double beginPrinting(Ms::Score* score) const;
+    void endPrinting(Ms::Score* score, double pixelRatioBackup) const;
+
+    void applyBeatsColors(Ms::Score* score, const BeatsColors& beatsColors) const;
+    StaffLinesList collectStaffLines(const Ms::Score* score, const Ms::Page* page, std::vector<Ms::StaffLines*>& clones) const;
+
+    Ret writePage(Ms::Score* score, size_t pageNumber, const StaffLinesList& staffLines, const TextList& headerFooterTexts,
+                  io::Device& destinationDevice, const Options& options) const;
 };
 }
 
@@ -70,6 +70,12 @@ mu::Ret NotationMidiWriter::writeList(const notation::INotationPtrList&, io::Dev
     return Ret(Ret::Code::NotSupported);
 }
 
+mu::Ret NotationMidiWriter::writePages(notation::INotationPtr, const std::vector<io::Device*>&, const Options&)
+{
+    NOT_SUPPORTED;
+    return Ret(Ret::Code::NotSupported);
+}
+
 void NotationMidiWriter::abort()
 {
     NOT_IMPLEMENTED;
@@ -61,6 +61,12 @@ mu::Ret MusicXmlWriter::writeList(const notation::INotationPtrList&, io::Device&
     return Ret(Ret::Code::NotSupported);
 }
 
+mu::Ret MusicXmlWriter::writePages(notation::INotationPtr, const std::vector<io::Device*>&, const Options&)
+{
+    NOT_SUPPORTED;
+    return Ret(Ret::Code::NotSupported);
+}
+
 void MusicXmlWriter::abort()
 {
     NOT_IMPLEMENTED;
@@ -263,7 +263,8 @@ bool VideoEncoder::encodeImage(const QImage& img)
         av_init_packet(&m_ffmpeg->pkt);
         ret = avcodec_receive_packet(m_ffmpeg->codecCtx, &m_ffmpeg->pkt);
         if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
-            return 0;
+            // the encoder needs more frames to produce a packet
+            return true;
         } else if (ret < 0) {
             LOGE() << "error during encoding";
             return false;
@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "videoframepipeline.h"
+
+#include <QPainter>
+
+#include "log.h"
+
+using namespace mu::iex::videoexport;
+
+VideoFramePipeline::VideoFramePipeline(size_t workersCount, size_t capacity, const draw::Color& cursorColor)
+    : m_workersCount(std::max(workersCount, size_t(1))), m_capacity(std::max(capacity, size_t(1))),
+    m_cursorColor(cursorColor.toQColor())
+{
+}
+
+VideoFramePipeline::~VideoFramePipeline()
+{
+    //! NOTE If not finished, then the rest of the frames are dropped
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_encoder.joinable()) {
+            m_failed = true;
+        }
+    }
+    m_cv.notify_all();
+
+    finish();
+}
+
+void VideoFramePipeline::start(const EncodeFunc& encode)
+{
+    IF_ASSERT_FAILED(!m_encoder.joinable()) {
+        return;
+    }
+
+    for (size_t i = 0; i < m_workersCount; ++i) {
+        m_workers.emplace_back(&VideoFramePipeline::workerLoop, this);
+    }
+
+    m_encoder = std::thread(&VideoFramePipeline::encoderLoop, this, encode);
+}
+
+bool VideoFramePipeline::push(FrameTask&& task)
+{
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_failed || m_tasks.size() < m_capacity; });
+
+    if (m_failed) {
+        return false;
+    }
+
+    task.index = m_pushedCount++;
+    m_tasks.push_back(std::move(task));
+    m_cv.notify_all();
+
+    return true;
+}
+
+bool VideoFramePipeline::finish()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_noMoreTasks = true;
+    }
+    m_cv.notify_all();
+
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+
+    if (m_encoder.joinable()) {
+        m_encoder.join();
+    }
+
+    std::lock_guard lock(m_mutex);
+    return !m_failed;
+}
+
+int VideoFramePipeline::encodedFramesCount() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_encodedCount;
+}
+
+void VideoFramePipeline::workerLoop()
+{
+    while (true) {
+        FrameTask task;
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_failed || m_noMoreTasks || !m_tasks.empty(); });
+
+            if (m_failed || m_tasks.empty()) {
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            m_cv.notify_all();
+
+            //! NOTE The frames are taken in order, so the frame expected by the encoder
+            //! is always either encoded or held by some worker, which won't wait here
+            m_cv.wait(lock, [this, &task]() {
+                return m_failed || task.index < m_encodedCount + static_cast<int>(m_capacity);
+            });
+
+            if (m_failed) {
+                return;
+            }
+        }
+
+        QImage frame = renderFrame(task);
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_frames.emplace(task.index, std::move(frame));
+        }
+        m_cv.notify_all();
+    }
+}
+
+void VideoFramePipeline::encoderLoop(EncodeFunc encode)
+{
+    while (true) {
+        QImage frame;
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait(lock, [this]() {
+                return m_failed
+                       || m_frames.count(m_encodedCount) > 0
+                       || (m_noMoreTasks && m_encodedCount == m_pushedCount);
+            });
+
+            if (m_failed || m_encodedCount == m_pushedCount) {
+                return;
+            }
+
+            auto it = m_frames.find(m_encodedCount);
+            frame = std::move(it->second);
+            m_frames.erase(it);
+        }
+
+        bool ok = encode(frame);
+
+        {
+            std::lock_guard lock(m_mutex);
+            if (ok) {
+                m_encodedCount++;
+            } else {
+                LOGE() << "failed encode frame: " << m_encodedCount;
+                m_failed = true;
+            }
+        }
+        m_cv.notify_all();
+    }
+}
+
+QImage VideoFramePipeline::renderFrame(const FrameTask& task) const
+{
+    QImage frame = task.page->copy();
+
+    QPainter painter(&frame);
+    painter.fillRect(task.cursorRect.toQRectF(), m_cursorColor);
+    painter.end();
+
+    return frame;
+}
@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_IMPORTEXPORT_VIDEOFRAMEPIPELINE_H
+#define MU_IMPORTEXPORT_VIDEOFRAMEPIPELINE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QImage>
+
+#include "infrastructure/draw/color.h"
+#include "infrastructure/draw/geometry.h"
+
+namespace mu::iex::videoexport {
+//! NOTE Renders the frames of the video on the worker threads and passes them to the encoder thread.
+//! The pages are painted by the caller (in the main thread), once per page,
+//! the workers only copy the page raster and draw the cursor on it.
+//! Both the queue of the tasks and the queue of the rendered frames are bounded,
+//! so the memory doesn't grow if the encoder is slower than the rendering
+class VideoFramePipeline
+{
+public:
+    struct FrameTask {
+        int index = 0;
+        std::shared_ptr<const QImage> page;
+        RectF cursorRect;
+    };
+
+    using EncodeFunc = std::function<bool (const QImage& frame)>;
+
+    VideoFramePipeline(size_t workersCount, size_t capacity, const draw::Color& cursorColor);
+    ~VideoFramePipeline();
+
+    void start(const EncodeFunc& encode);
+
+    //! Waits while the queue is full, returns false if the encoding failed
+    bool push(FrameTask&& task);
+
+    //! Waits until all the pushed frames are encoded, returns false if the encoding failed
+    bool finish();
+
+    int encodedFramesCount() const;
+
+private:
+    void workerLoop();
+    void encoderLoop(EncodeFunc encode);
+
+    QImage renderFrame(const FrameTask& task) const;
+
+    size_t m_workersCount = 0;
+    size_t m_capacity = 0;
+    QColor m_cursorColor;
+
+    std::vector<std::thread> m_workers;
+    std::thread m_encoder;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<FrameTask> m_tasks;
+    std::map<int, QImage> m_frames;
+    int m_pushedCount = 0;
+    int m_encodedCount = 0;
+    bool m_noMoreTasks = false;
+    bool m_failed = false;
+};
+}
+
+#endif // MU_IMPORTEXPORT_VIDEOFRAMEPIPELINE_H
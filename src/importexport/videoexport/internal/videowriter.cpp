@@ -21,7 +21,12 @@
  */
 #include "videowriter.h"
 
+#include <thread>
+
+#include <QElapsedTimer>
+
 #include "videoencoder.h"
+#include "videoframepipeline.h"
 
 #include "engraving/libmscore/page.h"
 #include "engraving/libmscore/system.h"
@@ -153,19 +158,29 @@ mu::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, con
     score->setLayoutAll();
     score->update();
 
-    // Setup painting
-    QImage frame(config.width, config.height, QImage::Format_RGB32);
-    frame.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
-    frame.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
+    auto painting = masterNotation->notation()->painting();
 
-    QPainter qp(&frame);
-    qp.setRenderHint(QPainter::Antialiasing, true);
-    qp.setRenderHint(QPainter::TextAntialiasing, true);
-    RectF frameRect = RectF::fromQRectF(QRectF(frame.rect()));
+    auto renderPage = [&config, &painting, CANVAS_DPI](const Page* page) {
+        auto image = std::make_shared<QImage>(config.width, config.height, QImage::Format_RGB32);
+        image->setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
+        image->setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
 
-    draw::Painter painter(&qp, "video_writer");
+        QPainter qp(image.get());
+        qp.setRenderHint(QPainter::Antialiasing, true);
+        qp.setRenderHint(QPainter::TextAntialiasing, true);
 
-    auto painting = masterNotation->notation()->painting();
+        draw::Painter painter(&qp, "video_writer");
+        painter.fillRect(RectF::fromQRectF(QRectF(image->rect())), draw::Color::white);
+
+        INotationPainting::Options opt;
+        opt.fromPage = page->no();
+        opt.toPage = opt.fromPage;
+        opt.deviceDpi = CANVAS_DPI;
+
+        painting->paintPrint(&painter, opt);
+
+        return std::shared_ptr<const QImage>(image);
+    };
 
     // Setup duration
     INotationPlaybackPtr playback = masterNotation->playback();
@@ -189,6 +204,20 @@ mu::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, con
     PlaybackCursor cursor;
     cursor.setNotation(masterNotation->notation());
 
+    //! NOTE The score is accessed only in this thread: here the pages are painted (once per page)
+    //! and the cursor positions are calculated, the frames are rendered and encoded by the pipeline
+    size_t workersCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    VideoFramePipeline pipeline(workersCount, workersCount * 2, CURSOR_COLOR);
+    pipeline.start([&encoder](const QImage& frame) {
+        return encoder.encodeImage(frame);
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const Page* currentPage = nullptr;
+    std::shared_ptr<const QImage> currentPageImage;
+
     for (int f = 0; f < frameCount; f++) {
         float currentTimeSec = (qreal)f / config.fps;
         currentTimeSec -= config.leadingSec;
@@ -206,27 +235,39 @@ mu::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, con
             break;
         }
 
-        INotationPainting::Options opt;
-        opt.fromPage = page->no();
-        opt.toPage = opt.fromPage;
-        opt.deviceDpi = CANVAS_DPI;
-
-        painter.fillRect(frameRect, draw::Color::white);
-
-        painting->paintPrint(&painter, opt);
+        if (page != currentPage) {
+            currentPage = page;
+            currentPageImage = renderPage(page);
+        }
 
         cursor.move(tick);
 
-        RectF cursorRect = cursor.rect();
-        PointF pagePos = page->pos();
-        RectF cursorAbsRect = cursorRect.translated(-pagePos);
+        //! NOTE The cursor is in the score units, the page image is rendered at CANVAS_DPI
+        RectF cursorRect = cursor.rect().translated(-page->pos());
+        qreal canvasScale = CANVAS_DPI / Ms::DPI;
 
-        painter.fillRect(cursorAbsRect, CURSOR_COLOR);
+        VideoFramePipeline::FrameTask task;
+        task.page = currentPageImage;
+        task.cursorRect = RectF(cursorRect.topLeft() * canvasScale, cursorRect.size() * canvasScale);
 
-        encoder.encodeImage(frame);
+        if (!pipeline.push(std::move(task))) {
+            break;
+        }
     }
 
+    bool ok = pipeline.finish();
+
+    double elapsedSec = timer.elapsed() / 1000.0;
+    int encodedFrames = pipeline.encodedFramesCount();
+    LOGI() << "encoded frames: " << encodedFrames << ", time: " << elapsedSec << " sec"
+           << ", fps: " << (elapsedSec > 0 ? encodedFrames / elapsedSec : 0) << ", workers: " << workersCount;
+
     encoder.close();
 
+    if (!ok) {
+        LOGE() << "failed encode video";
+        return make_ret(Ret::Code::UnknownError);
+    }
+
     return make_ok();
 }
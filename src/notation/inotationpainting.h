@@ -57,6 +57,12 @@ public:
     virtual SizeF pageSizeInch() const = 0;
 
     virtual void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) = 0;
+
+    //! NOTE Paints only the score content of one page, in the page coordinates,
+    //! without the interaction decorations (ex. for caching the view in tiles)
+    virtual void paintViewPage(draw::Painter* painter, int pageIndex, const RectF& frameRect, bool isPrinting) = 0;
+    virtual void paintViewInteraction(draw::Painter* painter, bool isPrinting) = 0;
+
     virtual void paintPdf(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPrint(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPng(draw::Painter* painter, const Options& opt) = 0;
@@ -94,6 +94,12 @@ mu::Ret MscNotationWriter::writeList(const INotationPtrList&, io::Device&, const
     return Ret(Ret::Code::NotSupported);
 }
 
+mu::Ret MscNotationWriter::writePages(INotationPtr, const std::vector<io::Device*>&, const Options&)
+{
+    NOT_SUPPORTED;
+    return Ret(Ret::Code::NotSupported);
+}
+
 void MscNotationWriter::abort()
 {
     NOT_IMPLEMENTED;
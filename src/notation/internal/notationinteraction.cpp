@@ -1981,12 +1981,14 @@ void NotationInteraction::setDropTarget(const EngravingItem* item, bool notify)
     if (m_dropData.dropTarget != item) {
         if (m_dropData.dropTarget) {
             m_dropData.dropTarget->setDropTarget(false);
+            score()->addRefresh(m_dropData.dropTarget->canvasBoundingRect());
             m_dropData.dropTarget = nullptr;
         }
 
         m_dropData.dropTarget = item;
         if (m_dropData.dropTarget) {
             m_dropData.dropTarget->setDropTarget(true);
+            score()->addRefresh(m_dropData.dropTarget->canvasBoundingRect());
         }
     }
 
@@ -224,10 +224,6 @@ void NotationPainting::doPaint(draw::Painter* painter, const Options& opt)
                 }
             }
         }
-
-        if (!opt.isPrinting) {
-            static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
-        }
     }
 }
 
@@ -287,6 +283,45 @@ void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool
     opt.deviceDpi = uiConfiguration()->logicalDpi();
     opt.isPrinting = isPrinting;
     doPaint(painter, opt);
+
+    paintViewInteraction(painter, isPrinting);
+}
+
+void NotationPainting::paintViewPage(Painter* painter, int pageIndex, const RectF& frameRect, bool isPrinting)
+{
+    if (!score() || pageIndex < 0 || pageIndex >= static_cast<int>(score()->npages())) {
+        return;
+    }
+
+    const Ms::Page* page = score()->pages().at(pageIndex);
+
+    Options opt;
+    opt.isSetViewport = false;
+    opt.isMultiPage = false;
+    opt.fromPage = pageIndex;
+    opt.toPage = pageIndex;
+    opt.frameRect = frameRect.translated(page->pos());
+    opt.deviceDpi = uiConfiguration()->logicalDpi();
+    opt.isPrinting = isPrinting;
+    doPaint(painter, opt);
+}
+
+void NotationPainting::paintViewInteraction(Painter* painter, bool isPrinting)
+{
+    if (!score()) {
+        return;
+    }
+
+    //! NOTE The pages may be painted from a cache,
+    //! so setup the score draw system here as well
+    const int DEVICE_DPI = uiConfiguration()->logicalDpi() > 0 ? uiConfiguration()->logicalDpi() : Ms::DPI;
+    Ms::MScore::pixelRatio = Ms::DPI / DEVICE_DPI;
+    score()->setPrinting(isPrinting);
+    Ms::MScore::pdfPrinting = isPrinting;
+
+    if (!isPrinting) {
+        static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
+    }
 }
 
 void NotationPainting::paintPdf(draw::Painter* painter, const Options& opt)
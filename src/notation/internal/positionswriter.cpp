@@ -124,6 +124,12 @@ mu::Ret PositionsWriter::writeList(const INotationPtrList&, io::Device&, const O
     return Ret(Ret::Code::NotSupported);
 }
 
+mu::Ret PositionsWriter::writePages(INotationPtr, const std::vector<io::Device*>&, const Options&)
+{
+    NOT_SUPPORTED;
+    return Ret(Ret::Code::NotSupported);
+}
+
 void PositionsWriter::abort()
 {
     NOT_IMPLEMENTED;
@@ -54,6 +54,7 @@ public:
 
     Ret write(notation::INotationPtr notation, io::Device& device, const Options& options = Options()) override;
     Ret writeList(const INotationPtrList& notations, io::Device& device, const Options& options = Options()) override;
+    Ret writePages(INotationPtr notation, const std::vector<io::Device*>& devices, const Options& options = Options()) override;
 
     void abort() override;
     framework::ProgressChannel progress() const override;
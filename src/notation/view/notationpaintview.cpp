@@ -67,6 +67,7 @@ NotationPaintView::NotationPaintView(QQuickItem* parent)
 
     //! NOTE For diagnostic tools
     dispatcher()->reg(this, "diagnostic-notationview-redraw", [this]() {
+        m_tileCache.invalidate();
         update();
     });
 
@@ -74,6 +75,15 @@ NotationPaintView::NotationPaintView(QQuickItem* parent)
     connect(&m_enableAutoScrollTimer, &QTimer::timeout, this, [this]() {
         m_autoScrollEnabled = true;
     });
+
+    //! NOTE While zooming, the tiles of the same zoom bucket are just scaled,
+    //! they are rendered at the exact scale when the zoom settles
+    m_exactTilesTimer.setSingleShot(true);
+    m_exactTilesTimer.setInterval(150);
+    connect(&m_exactTilesTimer, &QTimer::timeout, this, [this]() {
+        m_paintExactTiles = true;
+        update();
+    });
 }
 
 NotationPaintView::~NotationPaintView()
@@ -209,6 +219,7 @@ void NotationPaintView::onCurrentNotationChanged()
     }
 
     m_notation = globalContext()->currentNotation();
+    m_tileCache.setNotation(m_notation);
     m_continuousPanel->setNotation(m_notation);
     m_playbackCursor->setNotation(m_notation);
     m_loopInMarker->setNotation(m_notation);
@@ -451,7 +462,14 @@ void NotationPaintView::paint(QPainter* qp)
     painter->setWorldTransform(m_matrix * guiScalingCompensation);
 
     bool isPrinting = publishMode() || m_inputController->readonly();
-    notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+    bool hasScaledTiles = m_tileCache.paint(qp, toLogical(rect), isPrinting, !m_paintExactTiles);
+    m_paintExactTiles = false;
+
+    if (hasScaledTiles) {
+        m_exactTilesTimer.start();
+    }
+
+    notation()->painting()->paintViewInteraction(painter, isPrinting);
 
     m_playbackCursor->paint(painter);
     m_noteInputCursor->paint(painter);
@@ -487,14 +505,17 @@ void NotationPaintView::onNotationSetup()
     });
 
     configuration()->foregroundChanged().onNotify(this, [this]() {
+        m_tileCache.invalidate();
         update();
     });
 
     uiConfiguration()->currentThemeChanged().onNotify(this, [this]() {
+        m_tileCache.invalidate();
         update();
     });
 
     engravingConfiguration()->debuggingOptionsChanged().onNotify(this, [this]() {
+        m_tileCache.invalidate();
         update();
     });
 }
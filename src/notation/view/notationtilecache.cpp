@@ -0,0 +1,267 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "notationtilecache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+#include <QPainter>
+
+#include "engraving/infrastructure/draw/painter.h"
+#include "libmscore/page.h"
+#include "libmscore/score.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::notation;
+
+//! NOTE Size of the tile in the device pixels
+static constexpr int TILE_SIZE = 256;
+
+//! NOTE The tiles are reused (scaled) inside one bucket, so the smooth zoom doesn't render the score on every frame
+static constexpr int ZOOM_BUCKETS_PER_OCTAVE = 16;
+
+//! NOTE 256 tiles of 256x256 ARGB pixels take 64 MB
+static constexpr size_t MAX_TILES_COUNT = 256;
+
+//! NOTE Room around the page for the page border
+static constexpr qreal PAGE_MARGIN = 10.0;
+
+template<typename T>
+static void hashCombine(size_t& seed, const T& value)
+{
+    seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+size_t NotationTileCache::TileKeyHash::operator()(const TileKey& key) const
+{
+    size_t seed = 0;
+    hashCombine(seed, key.pageIndex);
+    hashCombine(seed, key.zoomBucket);
+    hashCombine(seed, key.column);
+    hashCombine(seed, key.row);
+    return seed;
+}
+
+void NotationTileCache::setNotation(INotationPtr notation)
+{
+    m_notation = notation;
+    invalidate();
+}
+
+void NotationTileCache::invalidate()
+{
+    //! NOTE The outdated tiles are rendered again on demand or evicted
+    ++m_generation;
+}
+
+bool NotationTileCache::paint(QPainter* painter, const RectF& frameRect, bool isPrinting, bool allowScaledTiles)
+{
+    TRACEFUNC;
+
+    if (!m_notation || !painter) {
+        return false;
+    }
+
+    updateTiles(m_notation->elements()->msScore(), isPrinting);
+
+    ++m_frame;
+
+    const qreal devicePixelRatio = painter->device() ? painter->device()->devicePixelRatioF() : 1.0;
+    const qreal scale = painter->worldTransform().m11() * devicePixelRatio;
+    if (scale <= 0.0) {
+        return false;
+    }
+
+    const int zoomBucket = static_cast<int>(std::lround(std::log2(scale) * ZOOM_BUCKETS_PER_OCTAVE));
+    const qreal bucketScale = std::exp2(static_cast<qreal>(zoomBucket) / ZOOM_BUCKETS_PER_OCTAVE);
+    const qreal cellSize = TILE_SIZE / bucketScale;
+
+    bool hasScaledTiles = false;
+
+    painter->save();
+
+    const PageList pages = m_notation->elements()->pages();
+    for (int pageIndex = 0; pageIndex < static_cast<int>(pages.size()); ++pageIndex) {
+        const Page* page = pages.at(pageIndex);
+
+        RectF pageRect = page->bbox().adjusted(-PAGE_MARGIN, -PAGE_MARGIN, PAGE_MARGIN, PAGE_MARGIN);
+        RectF visibleRect = frameRect.translated(-page->pos()).intersected(pageRect);
+        if (visibleRect.isEmpty()) {
+            continue;
+        }
+
+        int firstColumn = static_cast<int>((visibleRect.left() - pageRect.left()) / cellSize);
+        int lastColumn = static_cast<int>((visibleRect.right() - pageRect.left()) / cellSize);
+        int firstRow = static_cast<int>((visibleRect.top() - pageRect.top()) / cellSize);
+        int lastRow = static_cast<int>((visibleRect.bottom() - pageRect.top()) / cellSize);
+
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column) {
+                RectF cellRect(pageRect.left() + column * cellSize, pageRect.top() + row * cellSize, cellSize, cellSize);
+
+                Tile& tile = m_tiles[TileKey { pageIndex, zoomBucket, column, row }];
+
+                bool isActual = !tile.image.isNull() && tile.generation == m_generation;
+                bool isExactScale = qFuzzyCompare(tile.scale, scale);
+
+                if (!isActual || (!isExactScale && !allowScaledTiles)) {
+                    tile.rect = cellRect;
+                    tile.generation = m_generation;
+                    renderTile(tile, pageIndex, scale, isPrinting);
+                    isExactScale = true;
+                }
+
+                tile.lastUsedFrame = m_frame;
+                hasScaledTiles |= !isExactScale;
+
+                SizeF tileSize(tile.image.width() / tile.scale, tile.image.height() / tile.scale);
+                RectF targetRect(page->pos() + tile.rect.topLeft(), tileSize);
+
+                painter->setRenderHint(QPainter::SmoothPixmapTransform, !isExactScale);
+                painter->drawImage(targetRect.toQRectF(), tile.image);
+            }
+        }
+    }
+
+    painter->restore();
+
+    evictTiles();
+
+    return hasScaledTiles;
+}
+
+size_t NotationTileCache::scoreSignature(const Ms::Score* score) const
+{
+    //! NOTE The view options change the look of the elements without a layout
+    size_t seed = 0;
+    hashCombine(seed, reinterpret_cast<uintptr_t>(score));
+    hashCombine(seed, score->showInvisible());
+    hashCombine(seed, score->showUnprintable());
+    hashCombine(seed, score->showFrames());
+    hashCombine(seed, score->showPageborders());
+    hashCombine(seed, score->markIrregularMeasures());
+
+    return seed;
+}
+
+void NotationTileCache::updateTiles(const Ms::Score* score, bool isPrinting)
+{
+    if (!score) {
+        invalidate();
+        return;
+    }
+
+    size_t scoreSignature = this->scoreSignature(score);
+    const Ms::UpdateHistory& history = score->updateHistory();
+
+    std::vector<RectF> refreshRects;
+    if (m_isPrinting != isPrinting || m_scoreSignature != scoreSignature || !history.refreshSince(m_lastUpdate, refreshRects)) {
+        m_isPrinting = isPrinting;
+        m_scoreSignature = scoreSignature;
+        invalidate();
+    } else if (!refreshRects.empty()) {
+        //! NOTE Some room around the refreshed areas, as the views of the score add
+        removeTiles(refreshRects, score->spatium());
+    }
+
+    m_lastUpdate = history.lastUpdate();
+}
+
+void NotationTileCache::removeTiles(const std::vector<RectF>& rects, qreal margin)
+{
+    const PageList pages = m_notation->elements()->pages();
+
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        const TileKey& key = it->first;
+        if (key.pageIndex >= static_cast<int>(pages.size())) {
+            it = m_tiles.erase(it);
+            continue;
+        }
+
+        RectF tileRect = it->second.rect.translated(pages.at(key.pageIndex)->pos())
+                         .adjusted(-margin, -margin, margin, margin);
+
+        bool isRefreshed = std::any_of(rects.cbegin(), rects.cend(), [&tileRect](const RectF& rect) {
+            return rect.intersects(tileRect);
+        });
+
+        if (isRefreshed) {
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void NotationTileCache::renderTile(Tile& tile, int pageIndex, qreal scale, bool isPrinting) const
+{
+    TRACEFUNC;
+
+    int size = static_cast<int>(std::ceil(tile.rect.width() * scale));
+
+    tile.scale = scale;
+    tile.image = QImage(size, size, QImage::Format_ARGB32_Premultiplied);
+    tile.image.fill(Qt::transparent);
+
+    draw::Painter painter(&tile.image, "notationtile");
+
+    Transform transform;
+    transform.scale(scale, scale);
+    transform.translate(-tile.rect.x(), -tile.rect.y());
+    painter.setWorldTransform(transform);
+
+    RectF frameRect(tile.rect.topLeft(), SizeF(size / scale, size / scale));
+    m_notation->painting()->paintViewPage(&painter, pageIndex, frameRect, isPrinting);
+
+    painter.endDraw();
+}
+
+void NotationTileCache::evictTiles()
+{
+    if (m_tiles.size() <= MAX_TILES_COUNT) {
+        return;
+    }
+
+    std::vector<uint64_t> frames;
+    frames.reserve(m_tiles.size());
+    for (const auto& pair : m_tiles) {
+        frames.push_back(pair.second.lastUsedFrame);
+    }
+
+    //! NOTE The least recently used tiles go first, the visible ones are never evicted
+    size_t excess = m_tiles.size() - MAX_TILES_COUNT;
+    std::nth_element(frames.begin(), frames.begin() + excess - 1, frames.end());
+    uint64_t threshold = std::min(frames.at(excess - 1), m_frame - 1);
+
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        if (it->second.lastUsedFrame <= threshold || it->second.generation != m_generation) {
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
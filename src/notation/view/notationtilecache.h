@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_NOTATION_NOTATIONTILECACHE_H
+#define MU_NOTATION_NOTATIONTILECACHE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <QImage>
+
+#include "notation/inotation.h"
+
+#include "engraving/infrastructure/draw/geometry.h"
+
+class QPainter;
+
+namespace mu::notation {
+//! NOTE Raster cache of the score content of the notation view.
+//! The pages are split into tiles of the device pixels size, which are keyed by
+//! the page and the zoom bucket. The score reports the areas it refreshes (see Ms::UpdateHistory),
+//! so only the tiles intersecting them are rendered again, and panning just blits the tiles.
+//! Any layout of the score drops all the tiles
+class NotationTileCache
+{
+public:
+    NotationTileCache() = default;
+
+    void setNotation(INotationPtr notation);
+
+    //! NOTE Drops all the tiles, ex. when the appearance of the whole score changes
+    void invalidate();
+
+    //! NOTE Paints the pages in the frameRect (in the logical coordinates) with the current
+    //! world transform of the painter. Returns true if some of the tiles were painted from
+    //! a different scale of the same zoom bucket, so the view may ask for an exact repaint later
+    bool paint(QPainter* painter, const RectF& frameRect, bool isPrinting, bool allowScaledTiles);
+
+private:
+    struct TileKey {
+        int pageIndex = 0;
+        int zoomBucket = 0;
+        int column = 0;
+        int row = 0;
+
+        bool operator==(const TileKey& other) const
+        {
+            return pageIndex == other.pageIndex && zoomBucket == other.zoomBucket
+                   && column == other.column && row == other.row;
+        }
+    };
+
+    struct TileKeyHash {
+        size_t operator()(const TileKey& key) const;
+    };
+
+    struct Tile {
+        QImage image;
+        qreal scale = 0.0;
+        RectF rect;
+        uint64_t generation = 0;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    size_t scoreSignature(const Ms::Score* score) const;
+    void updateTiles(const Ms::Score* score, bool isPrinting);
+    void removeTiles(const std::vector<RectF>& rects, qreal margin);
+    void renderTile(Tile& tile, int pageIndex, qreal scale, bool isPrinting) const;
+    void evictTiles();
+
+    INotationPtr m_notation;
+
+    std::unordered_map<TileKey, Tile, TileKeyHash> m_tiles;
+
+    uint64_t m_generation = 0;
+    uint64_t m_frame = 0;
+    bool m_isPrinting = false;
+    size_t m_scoreSignature = 0;
+    uint64_t m_lastUpdate = 0;
+};
+}
+
+#endif // MU_NOTATION_NOTATIONTILECACHE_H
@@ -22,10 +22,12 @@
 #ifndef MU_PROJECT_INOTATIONPROJECT_H
 #define MU_PROJECT_INOTATIONPROJECT_H
 
+#include <functional>
 #include <memory>
 
 #include "io/path.h"
 #include "ret.h"
+#include "retval.h"
 
 #include "projecttypes.h"
 #include "notation/imasternotation.h"
@@ -33,6 +35,9 @@
 #include "iprojectviewsettings.h"
 
 namespace mu::project {
+//! NOTE Writes a snapshot of the project to the disk, can be run on any thread
+using WriteSnapshotTask = std::function<Ret()>;
+
 class INotationProject
 {
 public:
@@ -60,6 +65,10 @@ public:
     virtual Ret save(const io::path_t& path = io::path_t(), SaveMode saveMode = SaveMode::Save) = 0;
     virtual Ret writeToDevice(io::Device* device) = 0;
 
+    //! NOTE Serializes the project into memory on the calling thread,
+    //! the returned task compresses and writes it to the path
+    virtual RetVal<WriteSnapshotTask> makeAutoSaveSnapshot(const io::path_t& path) = 0;
+
     virtual ProjectMeta metaInfo() const = 0;
     virtual void setMetaInfo(const ProjectMeta& meta, bool undoable = false) = 0;
 
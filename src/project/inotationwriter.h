@@ -58,6 +58,9 @@ public:
 
     virtual Ret write(notation::INotationPtr notation, io::Device& device, const Options& options = Options()) = 0;
     virtual Ret writeList(const notation::INotationPtrList& notations, io::Device& device, const Options& options = Options()) = 0;
+
+    //! NOTE Writes the pages of the notation, the page i to devices[i]
+    virtual Ret writePages(notation::INotationPtr notation, const std::vector<io::Device*>& devices, const Options& options = Options()) = 0;
     virtual void abort() = 0;
     virtual framework::ProgressChannel progress() const = 0;
 };
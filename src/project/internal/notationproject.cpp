@@ -64,6 +64,102 @@ static const QString PLATFORM_TAG("platform");
 static const QString MOVEMENT_TITLE_TAG("movementTitle");
 static const QString MOVEMENT_NUMBER_TAG("movementNumber");
 
+static std::string autoSaveSuffix(const io::path_t& path)
+{
+    std::string suffix = io::suffix(path);
+    if (suffix == IProjectAutoSaver::AUTOSAVE_SUFFIX) {
+        suffix = io::suffix(io::completeBasename(path));
+    }
+
+    if (suffix.empty()) {
+        // Then it must be a MSCX folder
+        suffix = engraving::MSCX;
+    }
+
+    return suffix;
+}
+
+static MscWriter::Params saveParams(const io::path_t& path, MscIoMode ioMode)
+{
+    MscWriter::Params params;
+    params.filePath = engraving::containerPath(path).toQString() + "_saving";
+    params.mainFileName = engraving::mainFileName(path).toQString();
+    params.mode = ioMode;
+
+    return params;
+}
+
+static Ret checkSaveLocation(const io::path_t& path, MscIoMode ioMode)
+{
+    QString targetContainerPath = engraving::containerPath(path).toQString();
+    QString savePath = targetContainerPath + "_saving";
+
+    QFileInfo fi(savePath);
+    if (fi.exists() && !QFileInfo(savePath).isWritable()) {
+        LOGE() << "failed save, not writable path: " << savePath;
+        return make_ret(notation::Err::UnknownError);
+    }
+
+    if (ioMode == MscIoMode::Dir) {
+        // Dir needs to be created, otherwise we can't move to it
+        if (!QDir(targetContainerPath).mkpath(".")) {
+            LOGE() << "Couldn't create container directory";
+            return make_ret(notation::Err::UnknownError);
+        }
+    }
+
+    return make_ok();
+}
+
+static Ret replaceSavedFile(IFileSystem* fileSystem, const io::path_t& path, MscIoMode ioMode)
+{
+    QString targetContainerPath = engraving::containerPath(path).toQString();
+    io::path_t targetMainFilePath = engraving::mainFilePath(path);
+    QString savePath = targetContainerPath + "_saving";
+
+    {
+        if (ioMode == MscIoMode::Dir) {
+            RetVal<io::paths_t> filesToBeMoved
+                = fileSystem->scanFiles(savePath, { "*" }, io::IFileSystem::ScanMode::FilesAndFoldersInCurrentDir);
+            if (!filesToBeMoved.ret) {
+                return filesToBeMoved.ret;
+            }
+
+            Ret ret = make_ok();
+
+            for (const io::path_t& fileToBeMoved : filesToBeMoved.val) {
+                io::path_t destinationFile
+                    = io::path_t(targetContainerPath).appendingComponent(io::filename(fileToBeMoved));
+                LOGD() << fileToBeMoved << " to " << destinationFile;
+                ret = fileSystem->move(fileToBeMoved, destinationFile, true);
+                if (!ret) {
+                    return ret;
+                }
+            }
+
+            // Try to remove the temp save folder (not problematic if fails)
+            ret = fileSystem->removeFolderIfEmpty(savePath);
+            if (!ret) {
+                LOGW() << ret.toString();
+            }
+        } else {
+            Ret ret = fileSystem->move(savePath, targetContainerPath, true);
+            if (!ret) {
+                return ret;
+            }
+        }
+    }
+
+    // make file readable by all
+    {
+        QFile::setPermissions(targetMainFilePath.toQString(),
+                              QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser | QFile::ReadGroup | QFile::ReadOther);
+    }
+
+    LOGI() << "success save file: " << targetContainerPath;
+    return make_ret(Ret::Code::Ok);
+}
+
 static bool isStandardTag(const QString& tag)
 {
     static const QSet<QString> standardTags {
@@ -429,20 +525,52 @@ mu::Ret NotationProject::save(const io::path_t& path, SaveMode saveMode)
         return ret;
     }
     case SaveMode::AutoSave:
-        std::string suffix = io::suffix(path);
-        if (suffix == IProjectAutoSaver::AUTOSAVE_SUFFIX) {
-            suffix = io::suffix(io::completeBasename(path));
+        return saveScore(path, autoSaveSuffix(path));
+    }
+
+    return make_ret(notation::Err::UnknownError);
+}
+
+RetVal<WriteSnapshotTask> NotationProject::makeAutoSaveSnapshot(const io::path_t& path)
+{
+    TRACEFUNC;
+
+    std::string suffix = autoSaveSuffix(path);
+    if (!isMuseScoreFile(suffix)) {
+        Ret ret = exportProject(path, suffix);
+        return RetVal<WriteSnapshotTask>::make_ok([ret]() { return ret; });
+    }
+
+    MscIoMode ioMode = mscIoModeBySuffix(suffix);
+
+    MscWriter::Params params = saveParams(path, ioMode);
+    params.deferred = true;
+    IF_ASSERT_FAILED(params.mode != MscIoMode::Unknown) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    auto msczWriter = std::make_shared<MscWriter>(params);
+    Ret ret = writeProject(*msczWriter, false);
+    if (!ret) {
+        LOGE() << "failed write project snapshot";
+        return ret;
+    }
+
+    WriteSnapshotTask task = [fileSystem = fileSystem(), path, ioMode, msczWriter]() {
+        Ret ret = checkSaveLocation(path, ioMode);
+        if (!ret) {
+            return ret;
         }
 
-        if (suffix.empty()) {
-            // Then it must be a MSCX folder
-            suffix = engraving::MSCX;
+        if (!msczWriter->writeDeferredFiles()) {
+            LOGE() << "failed write project snapshot: " << path;
+            return make_ret(notation::Err::UnknownError);
         }
 
-        return saveScore(path, suffix);
-    }
+        return replaceSavedFile(fileSystem.get(), path, ioMode);
+    };
 
-    return make_ret(notation::Err::UnknownError);
+    return RetVal<WriteSnapshotTask>::make_ok(task);
 }
 
 mu::Ret NotationProject::writeToDevice(io::Device* device)
@@ -483,40 +611,21 @@ mu::Ret NotationProject::saveScore(const io::path_t& path, const std::string& fi
 
 mu::Ret NotationProject::doSave(const io::path_t& path, bool generateBackup, engraving::MscIoMode ioMode)
 {
-    QString targetContainerPath = engraving::containerPath(path).toQString();
-    io::path_t targetMainFilePath = engraving::mainFilePath(path);
-    io::path_t targetMainFileName = engraving::mainFileName(path);
-    QString savePath = targetContainerPath + "_saving";
-
     // Step 1: check writable
-    {
-        QFileInfo fi(savePath);
-        if (fi.exists() && !QFileInfo(savePath).isWritable()) {
-            LOGE() << "failed save, not writable path: " << savePath;
-            return make_ret(notation::Err::UnknownError);
-        }
-
-        if (ioMode == engraving::MscIoMode::Dir) {
-            // Dir needs to be created, otherwise we can't move to it
-            if (!QDir(targetContainerPath).mkpath(".")) {
-                LOGE() << "Couldn't create container directory";
-                return make_ret(notation::Err::UnknownError);
-            }
-        }
+    Ret ret = checkSaveLocation(path, ioMode);
+    if (!ret) {
+        return ret;
     }
 
     // Step 2: write project
     {
-        MscWriter::Params params;
-        params.filePath = savePath;
-        params.mainFileName = targetMainFileName.toQString();
-        params.mode = ioMode;
+        MscWriter::Params params = saveParams(path, ioMode);
         IF_ASSERT_FAILED(params.mode != MscIoMode::Unknown) {
             return make_ret(Ret::Code::InternalError);
         }
 
         MscWriter msczWriter(params);
-        Ret ret = writeProject(msczWriter, false);
+        ret = writeProject(msczWriter, false);
         if (!ret) {
             LOGE() << "failed write project to buffer";
             return ret;
@@ -533,47 +642,7 @@ mu::Ret NotationProject::doSave(const io::path_t& path, bool generateBackup, eng
     }
 
     // Step 4: replace to saved file
-    {
-        if (ioMode == MscIoMode::Dir) {
-            RetVal<io::paths_t> filesToBeMoved
-                = fileSystem()->scanFiles(savePath, { "*" }, io::IFileSystem::ScanMode::FilesAndFoldersInCurrentDir);
-            if (!filesToBeMoved.ret) {
-                return filesToBeMoved.ret;
-            }
-
-            Ret ret = make_ok();
-
-            for (const io::path_t& fileToBeMoved : filesToBeMoved.val) {
-                io::path_t destinationFile
-                    = io::path_t(targetContainerPath).appendingComponent(io::filename(fileToBeMoved));
-                LOGD() << fileToBeMoved << " to " << destinationFile;
-                ret = fileSystem()->move(fileToBeMoved, destinationFile, true);
-                if (!ret) {
-                    return ret;
-                }
-            }
-
-            // Try to remove the temp save folder (not problematic if fails)
-            ret = fileSystem()->removeFolderIfEmpty(savePath);
-            if (!ret) {
-                LOGW() << ret.toString();
-            }
-        } else {
-            Ret ret = fileSystem()->move(savePath, targetContainerPath, true);
-            if (!ret) {
-                return ret;
-            }
-        }
-    }
-
-    // make file readable by all
-    {
-        QFile::setPermissions(targetMainFilePath.toQString(),
-                              QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser | QFile::ReadGroup | QFile::ReadOther);
-    }
-
-    LOGI() << "success save file: " << targetContainerPath;
-    return make_ret(Ret::Code::Ok);
+    return replaceSavedFile(fileSystem().get(), path, ioMode);
 }
 
 mu::Ret NotationProject::makeCurrentFileAsBackup()
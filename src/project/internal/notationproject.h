@@ -78,6 +78,7 @@ public:
 
     Ret save(const io::path_t& path = io::path_t(), SaveMode saveMode = SaveMode::Save) override;
     Ret writeToDevice(io::Device* device) override;
+    RetVal<WriteSnapshotTask> makeAutoSaveSnapshot(const io::path_t& path) override;
 
     ProjectMeta metaInfo() const override;
     void setMetaInfo(const ProjectMeta& meta, bool undoable = false) override;
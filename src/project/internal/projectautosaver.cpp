@@ -21,9 +21,15 @@
  */
 #include "projectautosaver.h"
 
+#include <QElapsedTimer>
+
+#include "async/async.h"
+#include "runtime.h"
+
 #include "log.h"
 
 using namespace mu::project;
+using namespace mu::async;
 
 void ProjectAutoSaver::init()
 {
@@ -75,6 +81,16 @@ void ProjectAutoSaver::init()
     });
 }
 
+void ProjectAutoSaver::deinit()
+{
+    m_timer.stop();
+
+    //! NOTE Let the last snapshot be written, otherwise the autosave file may be left broken
+    if (m_saveThread.joinable()) {
+        m_saveThread.join();
+    }
+}
+
 bool ProjectAutoSaver::projectHasUnsavedChanges(const io::path_t& projectPath) const
 {
     io::path_t autoSavePath = projectAutoSavePath(projectPath);
@@ -129,6 +145,7 @@ void ProjectAutoSaver::update()
     if (!m_lastProjectPathNeedingAutosave.empty()
         && m_lastProjectPathNeedingAutosave != newProjectPath) {
         removeProjectUnsavedChanges(m_lastProjectPathNeedingAutosave);
+        ++m_unsavedChangesGeneration;
     }
 
     m_lastProjectPathNeedingAutosave = newProjectPath;
@@ -136,6 +153,11 @@ void ProjectAutoSaver::update()
 
 void ProjectAutoSaver::onTrySave()
 {
+    if (m_isSaving) {
+        LOGD() << "[autosave] the previous snapshot is still being written";
+        return;
+    }
+
     INotationProjectPtr project = globalContext()->currentProject();
     if (!project) {
         LOGD() << "[autosave] no project";
@@ -150,12 +172,64 @@ void ProjectAutoSaver::onTrySave()
     io::path_t projectPath = this->projectPath(project);
     io::path_t savePath = project->isNewlyCreated() ? projectPath : projectAutoSavePath(projectPath);
 
-    Ret ret = project->save(savePath, SaveMode::AutoSave);
+    //! NOTE Only the snapshot is taken on this thread, it's compressed and written on a background thread
+    QElapsedTimer snapshotTimer;
+    snapshotTimer.start();
+
+    RetVal<WriteSnapshotTask> snapshot = project->makeAutoSaveSnapshot(savePath);
+    if (!snapshot.ret) {
+        LOGE() << "[autosave] failed to take project snapshot, err: " << snapshot.ret.toString();
+        return;
+    }
+
+    LOGI() << "[autosave] snapshot taken in " << snapshotTimer.elapsed() << " ms";
+
+    if (m_saveThread.joinable()) {
+        m_saveThread.join();
+    }
+
+    m_isSaving = true;
+
+    size_t unsavedChangesGeneration = m_unsavedChangesGeneration;
+
+    m_saveThread = std::thread([this, projectPath, unsavedChangesGeneration, task = snapshot.val]() {
+        runtime::setThreadName("autosave");
+
+        QElapsedTimer writeTimer;
+        writeTimer.start();
+
+        Ret ret = task();
+
+        LOGI() << "[autosave] snapshot written in " << writeTimer.elapsed() << " ms";
+
+        Async::call(this, [this, projectPath, unsavedChangesGeneration, ret]() {
+            onSaveFinished(projectPath, unsavedChangesGeneration, ret);
+        }, runtime::mainThreadId());
+    });
+}
+
+void ProjectAutoSaver::onSaveFinished(const io::path_t& projectPath, size_t unsavedChangesGeneration, const Ret& ret)
+{
+    m_isSaving = false;
+
     if (!ret) {
         LOGE() << "[autosave] failed to save project, err: " << ret.toString();
         return;
     }
 
+    //! NOTE The project may have been saved, closed or moved while the snapshot was being written
+    //! (and possibly edited again after that), then the snapshot is older than the saved project.
+    //! It's removed and a new one is taken, if the project still has unsaved changes
+    if (unsavedChangesGeneration != m_unsavedChangesGeneration) {
+        LOGD() << "[autosave] the snapshot is stale, remove it";
+        removeProjectUnsavedChanges(projectPath);
+
+        if (m_timer.isActive()) {
+            onTrySave();
+        }
+        return;
+    }
+
     LOGD() << "[autosave] successfully saved project";
 }
 
@@ -22,6 +22,9 @@
 #ifndef MU_PROJECT_PROJECTAUTOSAVER_H
 #define MU_PROJECT_PROJECTAUTOSAVER_H
 
+#include <atomic>
+#include <thread>
+
 #include <QTimer>
 
 #include "async/asyncable.h"
@@ -44,6 +47,7 @@ public:
     ProjectAutoSaver() = default;
 
     void init();
+    void deinit();
 
     bool projectHasUnsavedChanges(const io::path_t& projectPath) const override;
     void removeProjectUnsavedChanges(const io::path_t& projectPath) override;
@@ -59,11 +63,19 @@ private:
     void update();
 
     void onTrySave();
+    void onSaveFinished(const io::path_t& projectPath, size_t unsavedChangesGeneration, const Ret& ret);
 
     io::path_t projectPath(INotationProjectPtr project) const;
 
     QTimer m_timer;
     io::path_t m_lastProjectPathNeedingAutosave;
+
+    //! NOTE Incremented every time the unsaved changes are dropped (the project is saved, closed or moved),
+    //! so a snapshot taken before that is known to be stale
+    size_t m_unsavedChangesGeneration = 0;
+
+    std::thread m_saveThread;
+    std::atomic<bool> m_isSaving = false;
 };
 }
 
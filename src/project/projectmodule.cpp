@@ -163,3 +163,8 @@ void ProjectModule::onInit(const framework::IApplication::RunMode& mode)
     s_recentProjectsProvider->init();
     s_projectAutoSaver->init();
 }
+
+void ProjectModule::onDeinit()
+{
+    s_projectAutoSaver->deinit();
+}